@@ -0,0 +1,218 @@
+/**
+ * @file BasicRobot.h
+ * @brief Declaration of the BasicRobot and RobotAdapter class templates and
+ * the ingestRecords() loop.
+ *
+ * BasicRobot holds its subsystems by value and hands records to them without
+ * virtual dispatch, so an ingest loop templated on the robot type compiles to
+ * direct, inlinable calls. RobotAdapter wraps any such robot in the
+ * RobotInterface for code that needs polymorphism, such as MissionControl.
+ */
+
+#ifndef BASICROBOT_H
+#define BASICROBOT_H
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <utility>
+#include "Core/RobotInterface.h"
+#include "Records/RecordParser.h"
+#include "Records/RecordProcessingStrategies.h"
+
+/**
+ * @class BasicRobot
+ * @brief Robot whose subsystem types are policies fixed at compile time.
+ *
+ * Each policy must provide the methods of the standard subsystem it
+ * replaces, as Robot's Navigation, Temperature and SampleAnalysis do; a
+ * simulator or an instrumented subsystem derived from a standard one plugs
+ * in with no runtime cost, since every call is resolved statically.
+ *
+ * @tparam NavigationT The navigation subsystem type.
+ * @tparam TemperatureT The temperature subsystem type.
+ * @tparam SampleAnalysisT The sample analysis subsystem type.
+ */
+template <typename NavigationT = Navigation, typename TemperatureT = Temperature,
+          typename SampleAnalysisT = SampleAnalysis>
+class BasicRobot {
+ private:
+  NavigationT navigation;
+  TemperatureT temperature;
+  SampleAnalysisT sampleAnalysis;
+
+ public:
+  /**
+   * @brief Constructs a robot with value-initialized subsystems, so that
+   * subsystems without a constructor start zeroed.
+   */
+  BasicRobot() : navigation(), temperature(), sampleAnalysis() {}
+
+  /**
+   * @brief Constructs a robot from its subsystems.
+   * @param navigation The navigation subsystem.
+   * @param temperature The temperature subsystem.
+   * @param sampleAnalysis The sample analysis subsystem.
+   */
+  BasicRobot(NavigationT navigation, TemperatureT temperature, SampleAnalysisT sampleAnalysis)
+      : navigation(std::move(navigation)),
+        temperature(std::move(temperature)),
+        sampleAnalysis(std::move(sampleAnalysis)) {}
+
+  /**
+   * @brief Processes a record.
+   * @param record The record to process.
+   */
+  void processRecord(const Records& record) {
+    record.apply(navigation, temperature, sampleAnalysis);
+  }
+
+  /**
+   * @brief Gets the current SOL data.
+   * @param solNumber The SOL number.
+   * @return The SOL data.
+   */
+  SOLData getCurrentSOLData(const int solNumber) const {
+    SOLData solData(solNumber);
+    solData.storeTemperatureAggregate(temperature.getTemperatureAggregate());
+    solData.storeNavigationData(navigation.getNavigationData());
+    solData.storeSampleData(sampleAnalysis.getSampleClassification());
+    solData.storeSampleReading(sampleAnalysis.getSampleReading());
+    return solData;
+  }
+
+  /**
+   * @brief Resets all subsystems for the next SOL.
+   */
+  void reset() {
+    navigation.reset();
+    temperature.reset();
+    sampleAnalysis.reset();
+  }
+
+  /**
+   * @brief Captures the in-flight state of every subsystem.
+   * @return The robot state.
+   */
+  RobotState saveState() const {
+    RobotState state;
+    state.navigation = navigation.getState();
+    state.temperature = temperature.getTemperatureAggregate();
+    state.sampleReading = sampleAnalysis.getSampleReading();
+    state.elementId = sampleAnalysis.getSampleClassification().getElementId();
+    return state;
+  }
+
+  /**
+   * @brief Restores state captured by saveState().
+   * @param state The robot state.
+   */
+  void restoreState(const RobotState& state) {
+    navigation.restoreState(state.navigation);
+    temperature.restoreTemperatureAggregate(state.temperature);
+    sampleAnalysis.restoreSample(state.sampleReading, state.elementId);
+  }
+
+  /** @brief Gets the navigation subsystem. */
+  const NavigationT& getNavigation() const { return navigation; }
+
+  /** @brief Gets the temperature subsystem. */
+  const TemperatureT& getTemperature() const { return temperature; }
+
+  /** @brief Gets the sample analysis subsystem. */
+  const SampleAnalysisT& getSampleAnalysis() const { return sampleAnalysis; }
+};
+
+/**
+ * @class RobotAdapter
+ * @brief Exposes a statically dispatched robot through RobotInterface.
+ *
+ * Each interface call costs one virtual dispatch; everything below it is
+ * resolved at compile time.
+ *
+ * @tparam RobotT A BasicRobot, or any type with the same methods.
+ */
+template <typename RobotT>
+class RobotAdapter : public RobotInterface {
+ private:
+  RobotT robot;
+
+ public:
+  /**
+   * @brief Constructs the adapter around a value-initialized robot.
+   */
+  RobotAdapter() : robot() {}
+
+  /**
+   * @brief Constructs the adapter around a robot.
+   * @param robot The robot.
+   */
+  explicit RobotAdapter(RobotT robot) : robot(std::move(robot)) {}
+
+  /**
+   * @brief Processes a record.
+   * @param record The record to process.
+   */
+  void processRecord(const RecordPtr& record) override { robot.processRecord(*record); }
+
+  /**
+   * @brief Gets the current SOL data.
+   * @param solNumber The SOL number.
+   * @return The SOL data.
+   */
+  SOLData getCurrentSOLData(const int solNumber) const override {
+    return robot.getCurrentSOLData(solNumber);
+  }
+
+  /**
+   * @brief Resets all subsystems for the next SOL.
+   */
+  void reset() override { robot.reset(); }
+
+  /**
+   * @brief Captures the in-flight state of every subsystem.
+   * @return The robot state.
+   */
+  RobotState saveState() const override { return robot.saveState(); }
+
+  /**
+   * @brief Restores state captured by saveState().
+   * @param state The robot state.
+   */
+  void restoreState(const RobotState& state) override { robot.restoreState(state); }
+
+  /** @brief Gets the wrapped robot. */
+  const RobotT& getRobot() const { return robot; }
+};
+
+/**
+ * @brief Feeds every record of an input to a robot, finalizing a SOL after
+ * each temperature record as the mission input format defines.
+ *
+ * The loop is instantiated per robot type, so with a BasicRobot no call in it
+ * is virtual. It keeps no checkpoints; use MissionControl for resumable
+ * ingest.
+ * @param input The mission input, one record per line.
+ * @param robot The robot.
+ * @param firstSol The number of the first finalized SOL.
+ * @param visitor Function invoked with each finalized SOL, in order.
+ * @return The number of SOLs finalized.
+ * @throw std::invalid_argument if a record is malformed.
+ */
+template <typename RobotT, typename SOLVisitor>
+std::size_t ingestRecords(std::istream& input, RobotT& robot, const int firstSol,
+                          SOLVisitor&& visitor) {
+  std::string record;
+  int solNumber = firstSol;
+  while (std::getline(input, record)) {
+    robot.processRecord(*RecordParser::parseRecord(record));
+    if (record[0] == 't') {
+      visitor(robot.getCurrentSOLData(solNumber));
+      ++solNumber;
+      robot.reset();
+    }
+  }
+  return static_cast<std::size_t>(solNumber - firstSol);
+}
+
+#endif  // BASICROBOT_H
@@ -0,0 +1,123 @@
+/**
+ * @file IngestCheckpoint.h
+ * @brief Declaration of the IngestCheckpoint struct and CheckpointWriter class.
+ *
+ * An IngestCheckpoint records how far an ingest has progressed, so an
+ * interrupted replay can resume from there instead of from the first record.
+ * CheckpointWriter replaces the checkpoint file atomically on a background
+ * thread.
+ */
+#ifndef INGESTCHECKPOINT_H
+#define INGESTCHECKPOINT_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Core/RobotInterface.h"
+#include "Data/SOLArchive.h"
+
+/**
+ * @brief On-disk format version of checkpoint files.
+ */
+const std::uint32_t INGEST_CHECKPOINT_VERSION = 1;
+
+/**
+ * @brief Default number of finalized SOLs between checkpoints. Matching the
+ * archive group size means each checkpoint rides on a commit that would
+ * happen anyway.
+ */
+const std::size_t DEFAULT_CHECKPOINT_INTERVAL = DEFAULT_ARCHIVE_GROUP_SIZE;
+
+/**
+ * @struct IngestCheckpoint
+ * @brief Everything needed to resume an ingest.
+ */
+struct IngestCheckpoint {
+  std::uint64_t inputOffset = 0; /**< Byte offset of the next unread record. */
+  int currentSOL = 0;            /**< SOLManager current SOL. */
+  int totalSOLs = 0;             /**< SOLManager total SOLs. */
+  RobotState robotState;         /**< In-flight SOL being assembled. */
+  std::uint64_t storedSOLs = 0;  /**< DataStorage high-water mark: rows durable in the archive. */
+};
+
+/**
+ * @class CheckpointWriter
+ * @brief Writes checkpoints atomically without blocking the ingest thread.
+ *
+ * submit() only copies the checkpoint into a one-slot mailbox; a worker
+ * thread writes it to a temporary file, syncs it and renames it over the
+ * previous checkpoint, so a crash leaves either the old or the new file. When
+ * checkpoints arrive faster than they can be written, the newest replaces the
+ * one still waiting.
+ */
+class CheckpointWriter {
+ private:
+  std::string path;
+  std::mutex mutex;
+  std::condition_variable wake;
+  IngestCheckpoint waiting;
+  bool hasWaiting;
+  bool writing;
+  bool stopping;
+  std::size_t writtenCount;
+  std::string lastError;
+  std::thread worker;
+
+  /** @brief Worker loop writing the newest waiting checkpoint. */
+  void run();
+
+ public:
+  /**
+   * @brief Starts the worker thread.
+   * @param path The checkpoint file to replace on every write.
+   */
+  explicit CheckpointWriter(const std::string& path);
+
+  CheckpointWriter(const CheckpointWriter&) = delete;
+  CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+  /**
+   * @brief Writes any waiting checkpoint and stops the worker.
+   */
+  ~CheckpointWriter();
+
+  /**
+   * @brief Queues a checkpoint to be written; never waits for I/O.
+   * @param checkpoint The checkpoint.
+   */
+  void submit(const IngestCheckpoint& checkpoint);
+
+  /**
+   * @brief Waits until every submitted checkpoint has been written.
+   * @throw std::runtime_error if the last write failed.
+   */
+  void flush();
+
+  /**
+   * @brief Gets the number of checkpoints written so far.
+   * @return The write count.
+   */
+  std::size_t getWrittenCount();
+
+  /**
+   * @brief Writes a checkpoint atomically on the calling thread.
+   * @param path The checkpoint file.
+   * @param checkpoint The checkpoint.
+   * @throw std::runtime_error if writing, syncing or renaming fails.
+   */
+  static void write(const std::string& path, const IngestCheckpoint& checkpoint);
+
+  /**
+   * @brief Reads a checkpoint.
+   * @param path The checkpoint file.
+   * @param checkpoint Receives the checkpoint.
+   * @return False if there is no checkpoint file.
+   * @throw std::runtime_error if the file is corrupt or from another version.
+   */
+  static bool read(const std::string& path, IngestCheckpoint& checkpoint);
+};
+
+#endif  // INGESTCHECKPOINT_H
@@ -14,6 +14,10 @@
 #include "SOLData.h"
 #include "DataStorage.h"
 #include "RecordParser.h"
+#include "Core/IngestCheckpoint.h"
+#include "Data/SOLArchive.h"
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 
 /**
@@ -29,6 +33,10 @@ private:
     std::unique_ptr<SOLManager> solManager;
     std::unique_ptr<DataStorage> dataStorage;
     std::unique_ptr<RecordParser> recordParser;
+    std::shared_ptr<SOLArchiveWriter> archiveWriter;
+    std::unique_ptr<CheckpointWriter> checkpointWriter;
+    std::size_t checkpointInterval;
+    int checkpointedSOLs; /**< SOLManager total at the last checkpoint. */
 
 public:
     /**
@@ -56,15 +64,93 @@ public:
 
     /**
      * @brief Finalizes the current SOL's data collection.
+     * The SOL is delivered to every observer registered with the SOL manager;
+     * this instance stores it once initialize() has registered it.
      */
     void finalizeCurrentSOL() const;
 
     /**
-     * @brief Retrieves all stored observations.
+     * @brief Waits until observers notified on their own threads have
+     * received every finalized SOL, as before reading their results.
+     * @throw Whatever such an observer threw, if one failed.
+     */
+    void flushObservers() const;
+
+    /**
+     * @brief Retrieves a copy of all stored observations.
+     *
+     * This deep-copies the whole mission; prefer viewObservations().
      * @return A vector of all SOL data collected.
      */
     std::vector<SOLData> getObservations() const;
 
+    /**
+     * @brief Gets a read-only view of all stored observations.
+     * @return A view valid until the next SOL is finalized.
+     */
+    SOLDataView viewObservations() const;
+
+    /**
+     * @brief Visits every stored observation without copying.
+     * @param visitor Function invoked with each SOL data entry.
+     */
+    void forEachObservation(const std::function<void(const SOLData&)>& visitor) const;
+
+    /**
+     * @brief Gets the stored observations, for running SOLQuery filters.
+     * @return The storage, valid for the lifetime of this instance.
+     */
+    const DataStorage& getDataStorage() const;
+
+    /**
+     * @brief Turns on periodic checkpoints.
+     *
+     * Stored SOLs are recovered from the archive on resume, so the archive
+     * writer must also be registered as a SOL observer, synchronous or not;
+     * each checkpoint first waits for asynchronous observers to catch up.
+     * @param archiveWriter The archive that finalized SOLs are appended to.
+     * @param checkpointWriter Writes the checkpoints in the background.
+     * @param interval Finalized SOLs between checkpoints; at least 1.
+     * @throw std::invalid_argument if interval is 0.
+     */
+    void enableCheckpoints(std::shared_ptr<SOLArchiveWriter> archiveWriter,
+                           std::unique_ptr<CheckpointWriter> checkpointWriter,
+                           std::size_t interval = DEFAULT_CHECKPOINT_INTERVAL);
+
+    /**
+     * @brief Reports ingest progress, checkpointing once interval SOLs have
+     * been finalized since the last checkpoint.
+     * @param inputOffset Byte offset of the next unread record.
+     */
+    void advanceInput(std::uint64_t inputOffset);
+
+    /**
+     * @brief Commits the archive and queues a checkpoint of the current state.
+     * @param inputOffset Byte offset of the next unread record.
+     * @throw std::logic_error if checkpoints are not enabled.
+     */
+    void checkpoint(std::uint64_t inputOffset);
+
+    /**
+     * @brief Waits until every queued checkpoint is durable.
+     * @throw std::runtime_error if the last checkpoint write failed.
+     */
+    void flushCheckpoints() const;
+
+    /**
+     * @brief Restores the state recorded by a checkpoint.
+     *
+     * Rolls the archive back to the checkpoint's high-water mark, serves the
+     * stored SOLs from it and restores the SOL counters and in-flight robot
+     * state. Other SOL observers are not checkpointed and must be replayed
+     * from the stored observations by the caller.
+     * @param checkpoint The checkpoint to resume from.
+     * @return The byte offset to resume reading input at.
+     * @throw std::logic_error if checkpoints are not enabled.
+     * @throw std::runtime_error if the archive does not match the checkpoint.
+     */
+    std::uint64_t resume(const IngestCheckpoint& checkpoint);
+
     /**
      * @brief Callback method invoked when a SOL is finalized.
      * @param solData The finalized SOL data.
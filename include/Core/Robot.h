@@ -10,30 +10,20 @@
 #ifndef ROBOT_H
 #define ROBOT_H
 
-#include "RobotInterface.h"
+#include "Core/BasicRobot.h"
 #include "Utility/MakeUnique.h"
 
-class Navigation; // Forward declarations
-class Temperature;
-class SampleAnalysis;
-
 /**
  * @class Robot
  * @brief Implementation of the RobotInterface.
  *
  * The Robot class implements the RobotInterface, providing a simplified
  * interface to the underlying subsystems. It uses the Facade design pattern to
- * hide the complexity of the subsystems behind a single interface.
+ * hide the complexity of the subsystems behind a single interface. It is the
+ * standard BasicRobot behind a RobotAdapter; drive a BasicRobot directly to
+ * avoid virtual calls.
  */
-class Robot : public RobotInterface {
-private:
-  /** @brief The navigation subsystem. */
-  std::unique_ptr<Navigation> navigation;
-  /** @brief The temperature subsystem. */
-  std::unique_ptr<Temperature> temperature;
-  /** @brief The sample analysis subsystem. */
-  std::unique_ptr<SampleAnalysis> sampleAnalysis;
-
+class Robot : public RobotAdapter<BasicRobot<>> {
  public:
   /**
    * @brief Constructor for the Robot class.
@@ -45,20 +35,6 @@ private:
         std::unique_ptr<Temperature> temp,
         std::unique_ptr<SampleAnalysis> sample);
 
-  /**
-   * @brief Processes a record.
-   * @param record The record to process.
-   */
-  void processRecord(const RecordPtr& record) override;
-
-  /**
-   * @brief Gets the current SOL data.
-   * @param solNumber The SOL number.
-   * @return The SOL data.
-   */
-  SOLData getCurrentSOLData(int solNumber) const override;
-  void reset() override;
-
   void moveToLocation(double x, double y);
   void collectSample();
   void transmitData();
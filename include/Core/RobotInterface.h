@@ -16,6 +16,20 @@
 #include "Records.h"
 #include "SOLData.h"
 
+/**
+ * @struct RobotState
+ * @brief In-flight subsystem state of the SOL being assembled.
+ *
+ * Captured by checkpoints so a resumed ingest continues mid-SOL exactly where
+ * the interrupted one stopped.
+ */
+struct RobotState {
+  NavigationState navigation;
+  TemperatureAggregate temperature;
+  SampleReading sampleReading;
+  int elementId = UNCLASSIFIED_ELEMENT_ID; /**< Classification of the sample. */
+};
+
 /**
  * @class RobotInterface
  * @brief Abstract interface for robot operations.
@@ -44,6 +58,18 @@ public:
      */
     virtual void reset() = 0;
 
+    /**
+     * @brief Captures the in-flight state of every subsystem.
+     * @return The robot state.
+     */
+    virtual RobotState saveState() const = 0;
+
+    /**
+     * @brief Restores state captured by saveState().
+     * @param state The robot state.
+     */
+    virtual void restoreState(const RobotState& state) = 0;
+
     /**
      * @brief Destructor for the RobotInterface.
      */
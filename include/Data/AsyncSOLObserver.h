@@ -0,0 +1,144 @@
+/**
+ * @file AsyncSOLObserver.h
+ * @brief Declaration of the AsyncSOLObserver class.
+ *
+ * The AsyncSOLObserver class delivers finalized SOLs to another observer on
+ * a thread of its own, so that a slow observer such as an archive writer or
+ * a dashboard does not run on the ingest thread.
+ */
+#ifndef ASYNCSOLOBSERVER_H
+#define ASYNCSOLOBSERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include "Data/SOLData.h"
+#include "Data/SOLManager.h"
+#include "Utility/BoundedQueue.h"
+
+/**
+ * @brief Default number of SOLs an AsyncSOLObserver queues.
+ */
+const std::size_t DEFAULT_SOL_QUEUE_CAPACITY = 1024;
+
+/**
+ * @enum BackpressurePolicy
+ * @brief What an AsyncSOLObserver does with a SOL when its queue is full.
+ */
+enum class BackpressurePolicy {
+  Block,      /**< Wait for the consumer; no SOL is lost. */
+  DropOldest, /**< Discard the oldest queued SOL; the consumer sees the latest ones. */
+  Coalesce    /**< Keep only the newest overflowing SOL until the queue has room. */
+};
+
+/**
+ * @class AsyncSOLObserver
+ * @brief Forwards finalized SOLs to an observer through a BoundedQueue and a
+ * consumer thread.
+ *
+ * onSOLFinalized() copies the SOL into the queue and returns; the consumer
+ * thread delivers SOLs to the target in finalization order, minus those the
+ * policy discards. Under Coalesce, the SOLs that overflow while the queue is
+ * full collapse into the newest one, which is queued by the next
+ * onSOLFinalized() or flush() that finds room.
+ *
+ * One thread at a time may call onSOLFinalized() and flush(). The target is
+ * only called from the consumer thread, so it must not be used from other
+ * threads until flush() returns. If the target throws, later SOLs are
+ * discarded and flush() rethrows the exception.
+ */
+class AsyncSOLObserver : public SOLObserver {
+ private:
+  SOLObserverPtr target;
+  BackpressurePolicy policy;
+  BoundedQueue<SOLData> queue;
+
+  // The consumer sleeps when the queue is empty and the producer when it
+  // must wait; each side announces it is about to sleep before rechecking,
+  // and the other side only takes the mutex to wake it.
+  std::mutex mutex;
+  std::condition_variable consumerWake;
+  std::condition_variable producerWake;
+  std::atomic<bool> consumerWaiting;
+  std::atomic<bool> producerWaiting;
+  std::atomic<bool> stopping;
+
+  std::atomic<std::size_t> delivered;
+  std::atomic<std::size_t> dropped;
+  std::atomic<std::size_t> coalesced;
+  std::size_t pushed;      /**< Producer only. */
+  SOLData overflow;        /**< Producer only; the coalesced SOL. */
+  bool hasOverflow;        /**< Producer only. */
+  std::atomic<bool> failed;
+  std::exception_ptr failure; /**< Guarded by mutex. */
+
+  std::thread consumer;
+
+  /** @brief Delivers queued SOLs until stopped and drained. */
+  void consume();
+
+  /** @brief Pushes a SOL, waiting for room; producer only. */
+  void pushWaiting(const SOLData& solData);
+
+  /** @brief Wakes the consumer if it sleeps; call after a push. */
+  void wakeConsumer();
+
+  /** @brief Wakes the producer if it sleeps; call after a delivery. */
+  void wakeProducer();
+
+ public:
+  /**
+   * @brief Constructs the observer and starts its consumer thread.
+   * @param target The observer to deliver SOLs to.
+   * @param capacity The number of SOLs the queue holds, a power of two.
+   * @param policy What to do with a SOL when the queue is full.
+   * @throw std::invalid_argument if target is null or capacity is not a
+   * power of two of at least 2.
+   */
+  AsyncSOLObserver(SOLObserverPtr target,
+                   std::size_t capacity = DEFAULT_SOL_QUEUE_CAPACITY,
+                   BackpressurePolicy policy = BackpressurePolicy::Block);
+
+  AsyncSOLObserver(const AsyncSOLObserver&) = delete;
+  AsyncSOLObserver& operator=(const AsyncSOLObserver&) = delete;
+
+  /**
+   * @brief Delivers every queued SOL, then stops the consumer thread.
+   */
+  ~AsyncSOLObserver() override;
+
+  /**
+   * @brief Queues a finalized SOL for the target.
+   * @param solData The finalized SOL data.
+   */
+  void onSOLFinalized(const SOLData& solData) override;
+
+  /**
+   * @brief Waits until the target has received every SOL queued so far.
+   * @throw Whatever the target threw, if it failed.
+   */
+  void flush();
+
+  /**
+   * @brief Gets the observer SOLs are delivered to.
+   * @return The target.
+   */
+  const SOLObserverPtr& getTarget() const;
+
+  /**
+   * @brief Gets the number of SOLs discarded under DropOldest.
+   * @return The count.
+   */
+  std::size_t getDroppedCount() const;
+
+  /**
+   * @brief Gets the number of SOLs replaced by a newer one under Coalesce.
+   * @return The count.
+   */
+  std::size_t getCoalescedCount() const;
+};
+
+#endif  // ASYNCSOLOBSERVER_H
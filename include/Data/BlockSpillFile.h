@@ -0,0 +1,82 @@
+/**
+ * @file BlockSpillFile.h
+ * @brief Declaration of the BlockSpillFile class.
+ *
+ * The BlockSpillFile class holds serialized SOL blocks that DataStorage has
+ * moved out of memory to stay within its memory budget.
+ */
+#ifndef BLOCKSPILLFILE_H
+#define BLOCKSPILLFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+/**
+ * @class BlockSpillFile
+ * @brief Anonymous scratch file for spilled blocks.
+ *
+ * The file is unlinked as soon as it is created, so it never outlives the
+ * process, even after a crash. Blocks are written and read back by offset.
+ * Ranges released when a block changes are kept in a free list, merged with
+ * free neighbours, and reused first fit before the file grows, so a block
+ * that is changed and spilled over and over does not grow the file.
+ */
+class BlockSpillFile {
+ private:
+  int descriptor;
+  std::uint64_t length;
+  std::map<std::uint64_t, std::uint64_t> freeRanges; /**< Offset to length. */
+
+  /** @brief Writes bytes at an offset. */
+  void writeAt(std::uint64_t offset, const std::string& bytes);
+
+ public:
+  /**
+   * @brief Creates the file.
+   * @param directory The directory to create it in, on local disk.
+   * @throw std::runtime_error if the file cannot be created.
+   */
+  explicit BlockSpillFile(const std::string& directory);
+
+  BlockSpillFile(const BlockSpillFile&) = delete;
+  BlockSpillFile& operator=(const BlockSpillFile&) = delete;
+
+  /**
+   * @brief Closes, and so deletes, the file.
+   */
+  ~BlockSpillFile();
+
+  /**
+   * @brief Writes bytes to a free range, or to the end of the file.
+   * @param bytes The bytes.
+   * @return The offset they were written at.
+   * @throw std::runtime_error if the write fails.
+   */
+  std::uint64_t write(const std::string& bytes);
+
+  /**
+   * @brief Returns bytes written by write() to the free list.
+   * @param offset The offset write() returned.
+   * @param size The number of bytes written there.
+   */
+  void release(std::uint64_t offset, std::size_t size);
+
+  /**
+   * @brief Reads bytes written by write().
+   * @param offset The offset write() returned.
+   * @param size The number of bytes written there.
+   * @return The bytes.
+   * @throw std::runtime_error if the read fails.
+   */
+  std::string read(std::uint64_t offset, std::size_t size) const;
+
+  /**
+   * @brief Gets the length of the file, free ranges included.
+   * @return The file length.
+   */
+  std::uint64_t size() const;
+};
+
+#endif  // BLOCKSPILLFILE_H
@@ -0,0 +1,114 @@
+/**
+ * @file CompressedSOLBlock.h
+ * @brief Declaration of the CompressedSOLBlock class.
+ *
+ * The CompressedSOLBlock class holds a sealed run of SOL rows in compressed
+ * form, using an encoding chosen per column to fit how that field varies from
+ * one SOL to the next.
+ */
+#ifndef COMPRESSEDSOLBLOCK_H
+#define COMPRESSEDSOLBLOCK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Data/SOLColumnStore.h"
+
+/**
+ * @brief Rows per sealed block. A decoded block of this size (about 90 KB)
+ * stays in L2 cache while a scan runs over it.
+ */
+const std::size_t SOL_BLOCK_SIZE = 1024;
+
+/**
+ * @class CompressedSOLBlock
+ * @brief Immutable, losslessly compressed rows of a SOLColumnStore.
+ *
+ * Column encodings:
+ * - SOL numbers: the first number, then the deltas. A constant delta, as in
+ *   a gap-free mission, is stored once; otherwise as zigzag varints.
+ * - Temperatures, distances and sample wavelengths and intensities: Gorilla
+ *   XOR encoding. Each value is XORed with the previous one, and only the
+ *   meaningful bits of the result are stored. Slowly varying doubles share
+ *   sign, exponent and leading mantissa bits, so they cost a fraction of 64
+ *   bits. A zero distance, a SOL without movement, costs 1 bit.
+ * - Directions: 2 bits each.
+ * - Element IDs: a dictionary of distinct IDs plus bit-packed indexes of the
+ *   smallest width that fits.
+ * - Temperature aggregates: 1 bit when the SOL had exactly one reading (the
+ *   aggregate is then implied by the temperature), full values otherwise.
+ * - Sample readings: 1 bit for "no sample"; collected readings go through
+ *   the XOR streams.
+ *
+ * Every round trip is bit-exact.
+ */
+class CompressedSOLBlock {
+ private:
+  std::size_t rows;
+  int firstSol;
+  int solDelta;            /**< Delta between all SOLs, if constant. */
+  bool constantSolDelta;
+  std::vector<std::uint8_t> solDeltas; /**< Zigzag varints otherwise. */
+  std::vector<std::uint64_t> temperatureBits;
+  std::vector<std::uint64_t> distanceBits;
+  std::vector<std::uint64_t> directionBits;
+  std::vector<std::int16_t> elementDictionary;
+  unsigned elementWidth;
+  std::vector<std::uint64_t> elementBits;
+  std::vector<std::uint64_t> aggregateBits;
+  std::vector<std::uint64_t> sampleBits;
+
+  CompressedSOLBlock();
+
+ public:
+  /**
+   * @brief Compresses rows of a column store.
+   * @param source The rows to compress.
+   * @param first Position of the first row.
+   * @param count Number of rows; first + count must not exceed source.size().
+   * @return The sealed block.
+   */
+  static CompressedSOLBlock encode(const SOLColumnStore& source, std::size_t first,
+                                   std::size_t count);
+
+  /**
+   * @brief Decompresses every row, appending them to a column store.
+   * @param target The store to append to.
+   */
+  void decode(SOLColumnStore& target) const;
+
+  /**
+   * @brief Serializes the block, for spilling it to disk.
+   * @return The block's bytes, in host byte order.
+   */
+  std::string serialize() const;
+
+  /**
+   * @brief Rebuilds a block written by serialize().
+   * @param bytes The serialized block.
+   * @return The block.
+   * @throw std::runtime_error if the bytes are truncated.
+   */
+  static CompressedSOLBlock deserialize(const std::string& bytes);
+
+  /**
+   * @brief Gets the number of rows.
+   * @return The number of rows.
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Gets the SOL number of the first row without decoding.
+   * @return The first SOL number.
+   */
+  int getFirstSol() const;
+
+  /**
+   * @brief Gets the bytes held by the block.
+   * @return The footprint in bytes.
+   */
+  std::size_t getFootprint() const;
+};
+
+#endif  // COMPRESSEDSOLBLOCK_H
@@ -9,39 +9,310 @@
 #ifndef DATASTORAGE_H
 #define DATASTORAGE_H
 
+#include "Data/BlockSpillFile.h"
+#include "Data/CompressedSOLBlock.h"
+#include "Data/SOLArchive.h"
+#include "Data/SOLColumnStore.h"
 #include "Data/SOLData.h"
+#include "Data/SOLDataView.h"
+#include "Data/SOLIndex.h"
+#include "Data/SOLInvertedIndex.h"
+#include "Data/SOLZoneMap.h"
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
 #include <vector>
 
+/**
+ * @enum DuplicateSOLPolicy
+ * @brief What DataStorage does when a SOL number is stored twice.
+ */
+enum class DuplicateSOLPolicy {
+  Reject,  /**< Keep the first entry and report the duplicate. */
+  Replace, /**< Overwrite the stored entry in place. */
+  Throw    /**< Throw std::invalid_argument. */
+};
+
+/**
+ * @enum SOLStorageLayout
+ * @brief How DataStorage keeps its entries in memory.
+ */
+enum class SOLStorageLayout {
+  Columnar,        /**< One uncompressed SOLColumnStore. */
+  CompressedBlocks /**< Sealed CompressedSOLBlocks plus an uncompressed tail. */
+};
+
+/**
+ * @brief Smallest memory budget DataStorage::setMemoryBudget() accepts, in
+ * bytes; enough for the tail, a decoded block and a few resident blocks.
+ */
+const std::size_t MIN_MEMORY_BUDGET = 1 << 20;
+
 /**
  * @class DataStorage
  * @brief Manages the storage and retrieval of SOL (Sol or Solar day) data.
  *
  * This class provides functionality to store SOL data and retrieve it either
- * as a complete set or for a specific SOL number.
+ * as a complete set or for a specific SOL number. Entries live in a
+ * SOLColumnStore, one contiguous column per field; view(), getColumns() and
+ * forEachSOLData() give access without copying the mission, and SOLData rows
+ * are rebuilt on demand. getAllSOLData() copies every row and is kept for
+ * callers that need ownership.
+ *
+ * Entries are kept in SOL-number order and indexed by a SOLIndex, so lookups
+ * are O(1) for contiguous missions and range queries are O(log n + k).
+ * Storing SOLs in increasing order appends; an out-of-order SOL is inserted
+ * in place. loadArchive() serves a SOLArchive's mapped columns directly until
+ * the next store copies them into memory.
+ *
+ * A SOLInvertedIndex lists the SOLs of each element and direction.
+ *
+ * Under SOLStorageLayout::CompressedBlocks, every SOL_BLOCK_SIZE rows are
+ * sealed into a CompressedSOLBlock, cutting memory per SOL several times over.
+ * forEachBlock() and the row APIs decode one block at a time. A SOL stored
+ * into a sealed range re-encodes only that block. view(), getColumns() and
+ * getSOLRange() need contiguous columns, so under this layout they decode the
+ * whole mission into a cache; prefer forEachBlock() for scans.
+ *
+ * setMemoryBudget() bounds the memory held by rows under the compressed
+ * layout. Past the budget the least recently used sealed blocks spill to a
+ * scratch file and are read back on access, so the recent SOLs in the tail
+ * and the latest blocks stay resident however long the mission runs. Scans
+ * read spilled blocks without caching them, so they do not evict hot blocks.
  */
 class DataStorage {
  private:
-  std::vector<SOLData> masterSOLData;
+  SOLColumnStore columns; /**< Every row, or the unsealed tail when compressed. */
+  SOLIndex index;
+  SOLInvertedIndex postings;
+  DuplicateSOLPolicy duplicatePolicy;
+  SOLStorageLayout layout;
+  /**
+   * @struct SealedBlock
+   * @brief A sealed block and where its bytes currently are.
+   */
+  struct SealedBlock {
+    std::shared_ptr<const CompressedSOLBlock> resident; /**< Null while spilled. */
+    std::size_t footprint;         /**< Bytes the block takes when resident. */
+    std::uint64_t spillOffset;     /**< Where its bytes are in the spill file. */
+    std::size_t spillLength;       /**< Zero until spilled, or after a change. */
+    std::list<std::size_t>::iterator recent; /**< Entry in recentBlocks. */
+  };
+
+  mutable std::vector<SealedBlock> sealedBlocks;
+  std::vector<std::size_t> blockStarts; /**< Position of each block's first row. */
+  std::vector<SOLZoneMap> sealedZones;  /**< Zone map of each sealed block. */
+  std::size_t sealedRows;
+  mutable std::size_t decodedBlockIndex; /**< Block held in decodedBlock. */
+  mutable SOLColumnStore decodedBlock;
+  mutable bool materializedValid;
+  mutable SOLColumnStore materialized; /**< Every row, for contiguous views. */
+  mutable bool columnZonesValid;
+  mutable std::vector<SOLZoneMap> columnZones; /**< Per SOL_BLOCK_SIZE rows of columns. */
+  std::size_t memoryBudget; /**< Zero when unbounded. */
+  std::unique_ptr<BlockSpillFile> spillFile;
+  mutable std::list<std::size_t> recentBlocks; /**< Resident blocks, most recent first. */
+  mutable std::size_t residentBlockBytes;
+
+  /** @brief Gets the sealed block holding a position below sealedRows. */
+  std::size_t blockOf(std::size_t position) const;
+
+  /** @brief Gets a sealed block, reading it back into memory if spilled. */
+  std::shared_ptr<const CompressedSOLBlock> loadBlock(std::size_t blockIndex) const;
+
+  /** @brief Gets a sealed block for a scan, without caching it if spilled. */
+  std::shared_ptr<const CompressedSOLBlock> peekBlock(std::size_t blockIndex) const;
+
+  /** @brief Stores a newly encoded block, replacing any spilled copy. */
+  void setBlock(std::size_t blockIndex, CompressedSOLBlock&& block);
+
+  /** @brief Spills least recently used blocks until within the budget. */
+  void enforceBudget() const;
+
+  /** @brief Finds the position a SOL is stored at, or would be inserted at. */
+  std::size_t insertionPoint(int solNumber) const;
+
+  /** @brief Finds the position of a stored SOL, or SOLIndex::NOT_FOUND. */
+  std::size_t find(int solNumber) const;
+
+  /** @brief Throws unless structures over every row may be kept in memory. */
+  void requireUnbounded() const;
+
+  /** @brief Decodes a sealed block into decodedBlock, unless already there. */
+  const SOLColumnStore& decodeBlock(std::size_t blockIndex) const;
+
+  /** @brief Rebuilds the row at a position. */
+  SOLData rowAt(std::size_t position) const;
+
+  /** @brief Inserts or replaces a row inside a sealed block and re-encodes it. */
+  void modifySealed(std::size_t position, const SOLData& solData, bool replace);
+
+  /** @brief Seals the tail once it holds a full block. */
+  void sealFullTail();
+
+  /** @brief Gets every row contiguously, decoding sealed blocks if needed. */
+  const SOLColumnStore& contiguous() const;
+
+  /** @brief Drops cached decodes and zone maps after a modification. */
+  void invalidateDecodes();
+
  public:
+  /**
+   * @brief Constructs an empty storage.
+   * @param duplicatePolicy How a SOL number stored twice is handled.
+   * @param layout How entries are kept in memory.
+   */
+  explicit DataStorage(DuplicateSOLPolicy duplicatePolicy = DuplicateSOLPolicy::Reject,
+                       SOLStorageLayout layout = SOLStorageLayout::Columnar);
+
   /**
    * @brief Stores a new SOL data entry.
    * @param solData The SOL data to be stored.
+   * @return False if the SOL was already stored and the entry was rejected.
+   * @throw std::invalid_argument on a duplicate under DuplicateSOLPolicy::Throw.
+   */
+  bool storeSOLData(const SOLData& solData);
+
+  /**
+   * @brief Bounds the memory held by stored rows, spilling sealed blocks.
+   *
+   * Once set, the tail, the resident blocks and the decode cache together
+   * stay within the budget; per-block bookkeeping of about a hundred bytes
+   * is not counted. Lookups binary-search the blocks' SOL ranges instead of
+   * keeping a SOLIndex, and view(), getColumns(), getSOLRange() and
+   * getInvertedIndex() throw, since they would grow with the whole mission.
+   * @param bytes The budget, at least MIN_MEMORY_BUDGET.
+   * @param spillDirectory Local directory for the scratch file.
+   * @throw std::invalid_argument if the layout is not
+   * SOLStorageLayout::CompressedBlocks or the budget is too small.
+   * @throw std::runtime_error if the scratch file cannot be created.
    */
-  void storeSOLData(const SOLData& solData);
+  void setMemoryBudget(std::size_t bytes, const std::string& spillDirectory);
 
   /**
-   * @brief Retrieves all stored SOL data.
+   * @brief Replaces the stored entries with the committed rows of an archive.
+   *
+   * An archive written in increasing SOL order, as finalization produces, is
+   * queried straight from its mapping and only the index is rebuilt. Any
+   * other archive is copied in row by row under the duplicate policy. Under
+   * the compressed layout the archive is read once and sealed into blocks.
+   * @param archive The opened archive.
+   * @throw std::invalid_argument on a duplicate under DuplicateSOLPolicy::Throw.
+   */
+  void loadArchive(const std::shared_ptr<const SOLArchive>& archive);
+
+  /**
+   * @brief Retrieves a copy of all stored SOL data.
+   *
+   * This deep-copies the whole mission; prefer view() unless ownership is
+   * needed.
    * @return A vector containing all stored SOL data entries.
    */
   std::vector<SOLData> getAllSOLData() const;
 
   /**
-   * @brief Retrieves SOL data for a specific SOL number.
+   * @brief Gets a read-only view of all stored SOL data.
+   * @return A view in SOL order of the entries stored so far.
+   * @throw std::logic_error under a memory budget.
+   */
+  SOLDataView view() const;
+
+  /**
+   * @brief Gets the column store for vectorized scans.
+   * @return The column store, in SOL order.
+   * @throw std::logic_error under a memory budget.
+   */
+  const SOLColumnStore& getColumns() const;
+
+  /**
+   * @brief Gets a read-only view of the SOLs numbered firstSol to lastSol.
+   * @param firstSol The first SOL number of the range.
+   * @param lastSol The last SOL number of the range, inclusive.
+   * @return A view of the stored SOLs in the range, possibly empty.
+   * @throw std::logic_error under a memory budget.
+   */
+  SOLDataView getSOLRange(int firstSol, int lastSol) const;
+
+  /**
+   * @brief Gets the SOLs of each element and direction.
+   * @return The inverted index, kept up to date as SOLs are stored.
+   * @throw std::logic_error under a memory budget.
+   */
+  const SOLInvertedIndex& getInvertedIndex() const;
+
+  /**
+   * @brief Finds the stored data of a SOL without throwing.
+   * @param solNumber The SOL number to look up.
+   * @param solData Receives the rebuilt row if the SOL is stored.
+   * @return False if the SOL is not stored.
+   */
+  bool findSOLData(int solNumber, SOLData& solData) const;
+
+  /**
+   * @brief Retrieves a copy of the SOL data for a specific SOL number.
    * @param solNumber The SOL number to retrieve data for.
    * @return The SOL data for the specified SOL number.
    * @throw std::out_of_range if the SOL number is not found.
    */
   SOLData getSOLData(int solNumber) const;
+
+  /**
+   * @brief Visits every stored SOL in SOL order, rebuilding one row at a time.
+   * @param visitor Function invoked with each stored SOL data entry.
+   */
+  void forEachSOLData(const std::function<void(const SOLData&)>& visitor) const;
+
+  /**
+   * @brief Visits every stored row in SOL order as runs of columns.
+   *
+   * Under the compressed layout each sealed block is decoded into a reused,
+   * cache-sized store before the visitor runs, so column kernels such as
+   * ReductionKernels work on decoded data in cache. The columnar layout
+   * visits all rows as one run without copying.
+   * @param visitor Function invoked with each run of rows; the run is only
+   * valid during the call.
+   */
+  void forEachBlock(const std::function<void(const SOLColumnStore&)>& visitor) const;
+
+  /**
+   * @brief Visits the stored rows in SOL order as zones of up to
+   * SOL_BLOCK_SIZE rows, skipping zones a filter rules out.
+   *
+   * Sealed blocks carry their zone maps, so a skipped block is never
+   * decoded. Zone maps over uncompressed rows are computed on the first call
+   * after a modification.
+   * @param mayMatch Returns false for a zone whose rows can all be skipped.
+   * @param visitor Function invoked with the rows of each remaining zone; the
+   * view is only valid during the call.
+   */
+  void forEachZone(const std::function<bool(const SOLZoneMap&)>& mayMatch,
+                   const std::function<void(const SOLDataView&)>& visitor) const;
+
+  /**
+   * @brief Gets the bytes used by stored rows, excluding the index and caches.
+   * @return The footprint in bytes.
+   */
+  std::size_t getFootprint() const;
+
+  /**
+   * @brief Gets the bytes of stored rows and decode caches held in memory.
+   * @return The resident bytes, which a memory budget bounds.
+   */
+  std::size_t getResidentBytes() const;
+
+  /**
+   * @brief Gets the length of the spill file.
+   * @return The spilled bytes, free ranges included, or 0 without a budget.
+   */
+  std::uint64_t getSpilledBytes() const;
+
+  /**
+   * @brief Gets the number of stored SOL data entries.
+   * @return The number of stored entries.
+   */
+  std::size_t size() const;
 };
 
 /**
@@ -50,6 +321,6 @@ class DataStorage {
  * @param solData The SOL data to create the master temperature data from.
  * @return A vector of pairs containing SOL number and temperature.
  */
-std::vector<double> createMasterTemperatureData(const std::vector<SOLData>& solData);
+std::vector<double> createMasterTemperatureData(const SOLDataView& solData);
 
 #endif  // DATASTORAGE_H
\ No newline at end of file
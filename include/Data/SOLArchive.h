@@ -0,0 +1,208 @@
+/**
+ * @file SOLArchive.h
+ * @brief Declaration of the SOLArchive and SOLArchiveWriter classes.
+ *
+ * A SOL archive is a directory holding one append-only file per SOLColumnStore
+ * column plus a MANIFEST of checksummed commit records. SOLArchiveWriter
+ * appends finalized SOLs in groups; SOLArchive maps a committed archive
+ * read-only so DataStorage can query it without re-parsing the mission.
+ */
+#ifndef SOLARCHIVE_H
+#define SOLARCHIVE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Data/SOLColumnStore.h"
+#include "Data/SOLManager.h"
+
+/**
+ * @brief On-disk format version written to, and required in, the MANIFEST.
+ */
+const std::uint32_t SOL_ARCHIVE_VERSION = 1;
+
+/**
+ * @brief Default number of SOLs made durable together by one commit.
+ */
+const std::size_t DEFAULT_ARCHIVE_GROUP_SIZE = 256;
+
+/**
+ * @class SOLArchive
+ * @brief Read-only, memory-mapped view of the committed rows of an archive.
+ *
+ * Opening reads only the small MANIFEST and maps each column file, so the
+ * cost does not grow with mission length unless checksums are verified.
+ * Rows written after the last valid commit record, e.g. by a writer that
+ * crashed mid-commit, are ignored. The column spans stay valid for the
+ * archive's lifetime.
+ */
+class SOLArchive {
+ private:
+  /** @brief One mapped column file. */
+  struct Mapping {
+    void* address;
+    std::size_t length;
+  };
+
+  std::size_t rows;
+  std::vector<Mapping> mappings;
+  std::vector<const void*> columnData;
+
+  SOLArchive();
+
+  /** @brief Gets the mapped data of a column as T. */
+  template <typename T>
+  ColumnSpan<T> column(std::size_t columnIndex) const;
+
+ public:
+  SOLArchive(const SOLArchive&) = delete;
+  SOLArchive& operator=(const SOLArchive&) = delete;
+
+  /**
+   * @brief Unmaps the column files.
+   */
+  ~SOLArchive();
+
+  /**
+   * @brief Opens and maps an archive.
+   * @param directory The archive directory.
+   * @param verifyChecksums Whether to checksum every committed column chunk;
+   * this reads the whole archive once.
+   * @return The opened archive.
+   * @throw std::runtime_error if the archive is missing, was written by an
+   * incompatible build, is truncated or fails verification.
+   */
+  static std::shared_ptr<const SOLArchive> open(const std::string& directory,
+                                                bool verifyChecksums = true);
+
+  /**
+   * @brief Checks whether a directory holds an archive.
+   * @param directory The directory to check.
+   * @return True if it has a MANIFEST.
+   */
+  static bool exists(const std::string& directory);
+
+  /**
+   * @brief Gets the number of committed rows.
+   * @return The number of rows.
+   */
+  std::size_t size() const;
+
+  /** @brief Gets the SOL number column, in commit order. */
+  ColumnSpan<int> getSolNumbers() const;
+
+  /** @brief Gets the temperature column, in Kelvin. */
+  ColumnSpan<double> getTemperatures() const;
+
+  /** @brief Gets the distance column, in meters. */
+  ColumnSpan<double> getDistances() const;
+
+  /** @brief Gets the direction column; codes are Direction values. */
+  ColumnSpan<std::uint8_t> getDirections() const;
+
+  /** @brief Gets the element ID column; see SampleClassification. */
+  ColumnSpan<std::int16_t> getElementIds() const;
+
+  /** @brief Gets the temperature aggregate column. */
+  ColumnSpan<TemperatureAggregate> getTemperatureAggregates() const;
+
+  /** @brief Gets the raw sample reading column. */
+  ColumnSpan<SampleReading> getSampleReadings() const;
+};
+
+/**
+ * @class SOLArchiveWriter
+ * @brief Appends finalized SOLs to an archive with group commit.
+ *
+ * SOLs are buffered until groupSize are pending, then every column chunk is
+ * appended and synced before a commit record naming the new row count and
+ * the chunks' checksums is appended to the MANIFEST and synced. A crash can
+ * therefore lose at most the uncommitted group, never corrupt committed rows.
+ * Reopening an existing archive discards any torn tail and appends after the
+ * last commit. Never roll back below the row count of a SOLArchive that is
+ * still mapped.
+ */
+class SOLArchiveWriter : public SOLObserver {
+ private:
+  std::string directory;
+  std::size_t groupSize;
+  int manifestDescriptor;
+  std::size_t manifestBytes; /**< MANIFEST length up to the last commit. */
+  std::vector<int> columnDescriptors;
+  std::size_t committedRows;
+  SOLColumnStore pending;
+
+  /** @brief Closes every open file descriptor. */
+  void closeFiles();
+
+ public:
+  /**
+   * @brief Opens an archive for appending, creating it if needed.
+   * @param directory The archive directory.
+   * @param groupSize Number of SOLs per commit; at least 1.
+   * @throw std::invalid_argument if groupSize is 0.
+   * @throw std::runtime_error if the archive cannot be created or opened, or
+   * was written by an incompatible build.
+   */
+  explicit SOLArchiveWriter(const std::string& directory,
+                            std::size_t groupSize = DEFAULT_ARCHIVE_GROUP_SIZE);
+
+  SOLArchiveWriter(const SOLArchiveWriter&) = delete;
+  SOLArchiveWriter& operator=(const SOLArchiveWriter&) = delete;
+
+  /**
+   * @brief Commits pending SOLs and closes the archive.
+   */
+  ~SOLArchiveWriter() override;
+
+  /**
+   * @brief Buffers a SOL, committing the group once it is full.
+   * @param solData The SOL data to append.
+   * @throw std::runtime_error if a commit fails.
+   */
+  void append(const SOLData& solData);
+
+  /**
+   * @brief Makes every pending SOL durable.
+   * @throw std::runtime_error if writing or syncing fails.
+   */
+  void commit();
+
+  /**
+   * @brief Discards committed rows past a commit boundary, e.g. those
+   * committed after the checkpoint being resumed from.
+   * @param rows Rows to keep; 0 or the row count of a commit.
+   * @throw std::logic_error if rows are pending.
+   * @throw std::invalid_argument if rows is not a commit boundary.
+   * @throw std::runtime_error if fewer rows are committed, or truncating fails.
+   */
+  void rollback(std::size_t rows);
+
+  /**
+   * @brief Gets the archive directory.
+   * @return The directory passed to the constructor.
+   */
+  const std::string& getDirectory() const;
+
+  /**
+   * @brief Gets the number of durable rows.
+   * @return The committed row count.
+   */
+  std::size_t getCommittedCount() const;
+
+  /**
+   * @brief Gets the number of buffered rows not yet committed.
+   * @return The pending row count.
+   */
+  std::size_t getPendingCount() const;
+
+  /**
+   * @brief Callback method invoked when a SOL is finalized.
+   * @param solData The finalized SOL data.
+   */
+  void onSOLFinalized(const SOLData& solData) override;
+};
+
+#endif  // SOLARCHIVE_H
@@ -0,0 +1,255 @@
+/**
+ * @file SOLColumnStore.h
+ * @brief Declaration of the SOLColumnStore class.
+ *
+ * The SOLColumnStore class keeps stored SOL data as separate contiguous
+ * columns, so a scan over one field touches only that field's memory. The
+ * columns can also be served straight from a memory-mapped SOLArchive.
+ */
+#ifndef SOLCOLUMNSTORE_H
+#define SOLCOLUMNSTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Data/SOLData.h"
+
+class SOLArchive;
+
+/**
+ * @class ColumnSpan
+ * @brief Read-only span over part of a column.
+ *
+ * Valid until the column is next modified.
+ */
+template <typename T>
+class ColumnSpan {
+ private:
+  const T* first;
+  std::size_t length;
+
+ public:
+  /** @brief Constructs an empty span. */
+  ColumnSpan() : first(nullptr), length(0) {}
+
+  /**
+   * @brief Constructs a span over [data, data + size).
+   * @param data First element of the span.
+   * @param size Number of elements.
+   */
+  ColumnSpan(const T* data, const std::size_t size) : first(data), length(size) {}
+
+  /** @brief Gets a pointer to the first element, for vectorized kernels. */
+  const T* data() const { return first; }
+
+  /** @brief Gets the number of elements. */
+  std::size_t size() const { return length; }
+
+  /** @brief Checks whether the span is empty. */
+  bool empty() const { return length == 0; }
+
+  /** @brief Gets an iterator to the first element. */
+  const T* begin() const { return first; }
+
+  /** @brief Gets an iterator past the last element. */
+  const T* end() const { return first + length; }
+
+  /** @brief Gets an element without bounds checking. */
+  const T& operator[](const std::size_t index) const { return first[index]; }
+
+  /**
+   * @brief Gets a sub-span.
+   * @param offset Index of the first element; must not exceed size().
+   * @param count Number of elements; must fit in the span.
+   * @return The sub-span.
+   */
+  ColumnSpan subspan(const std::size_t offset, const std::size_t count) const {
+    return ColumnSpan(first + offset, count);
+  }
+};
+
+/**
+ * @class ColumnBuffer
+ * @brief One column, either owned or borrowed from read-only memory.
+ *
+ * A borrowed column is copied into owned storage the first time it is
+ * modified, so mapped archive pages are never written.
+ */
+template <typename T>
+class ColumnBuffer {
+ private:
+  const T* borrowed = nullptr;
+  std::size_t borrowedSize = 0;
+  std::vector<T> owned;
+
+ public:
+  /**
+   * @brief Serves the column from memory owned by someone else.
+   * @param data First element; must outlive the borrow.
+   * @param size Number of elements.
+   */
+  void borrow(const T* data, const std::size_t size) {
+    owned = std::vector<T>();
+    borrowed = data;
+    borrowedSize = size;
+  }
+
+  /** @brief Checks whether the column is borrowed. */
+  bool isBorrowed() const { return borrowed != nullptr; }
+
+  /** @brief Gets the owned values, copying a borrowed column first. */
+  std::vector<T>& values() {
+    if (borrowed != nullptr) {
+      owned.assign(borrowed, borrowed + borrowedSize);
+      borrowed = nullptr;
+      borrowedSize = 0;
+    }
+    return owned;
+  }
+
+  /** @brief Gets a span over the whole column. */
+  ColumnSpan<T> span() const {
+    return borrowed != nullptr ? ColumnSpan<T>(borrowed, borrowedSize)
+                               : ColumnSpan<T>(owned.data(), owned.size());
+  }
+};
+
+/**
+ * @struct SOLColumnPointers
+ * @brief Writable pointers to the same rows of every column, for bulk decoders.
+ */
+struct SOLColumnPointers {
+  int* solNumbers;
+  double* temperatures;
+  double* distances;
+  std::uint8_t* directions;
+  std::int16_t* elementIds;
+  TemperatureAggregate* temperatureAggregates;
+  SampleReading* sampleReadings;
+};
+
+/**
+ * @class SOLColumnStore
+ * @brief Structure-of-arrays storage of SOL data.
+ *
+ * Hot columns hold what scans read: SOL number, temperature (the SOL's last
+ * reading in Kelvin), distance in meters, direction code and element ID. Cold
+ * columns hold the rest of each SOLData, namely the full temperature
+ * aggregate and the raw sample reading, so row() can rebuild any entry.
+ * Rows are appended; insert() and replace() exist for the rare out-of-order or
+ * duplicate SOL. A store attached to a SOLArchive reads the mapped file until
+ * its first modification, which copies the columns into memory.
+ */
+class SOLColumnStore {
+ private:
+  ColumnBuffer<int> solNumbers;
+  ColumnBuffer<double> temperatures;
+  ColumnBuffer<double> distances;
+  ColumnBuffer<std::uint8_t> directions;
+  ColumnBuffer<std::int16_t> elementIds;
+  ColumnBuffer<TemperatureAggregate> temperatureAggregates;
+  ColumnBuffer<SampleReading> sampleReadings;
+  std::shared_ptr<const SOLArchive> archive; /**< Keeps borrowed pages mapped. */
+
+  /** @brief Copies borrowed columns into memory and drops the archive. */
+  void detach();
+
+ public:
+  /**
+   * @brief Replaces the contents with the columns of an archive, without
+   * copying them.
+   * @param archive The archive to read from; kept alive by the store.
+   */
+  void attach(const std::shared_ptr<const SOLArchive>& archive);
+
+  /**
+   * @brief Replaces the contents with columns owned elsewhere, without
+   * copying them.
+   * @param columns First row of each column; must outlive the borrow, and the
+   * borrowed rows must not change during it.
+   * @param rows Number of rows.
+   */
+  void borrow(const SOLColumnPointers& columns, std::size_t rows);
+
+  /**
+   * @brief Checks whether the columns are served from an archive.
+   * @return True until the first modification after attach().
+   */
+  bool isAttached() const;
+
+  /**
+   * @brief Appends a row.
+   * @param solData The SOL data to append.
+   */
+  void append(const SOLData& solData);
+
+  /**
+   * @brief Inserts a row before a position, shifting later rows.
+   * @param position The position to insert at; at most size().
+   * @param solData The SOL data to insert.
+   */
+  void insert(std::size_t position, const SOLData& solData);
+
+  /**
+   * @brief Overwrites a row.
+   * @param position The position to overwrite; below size().
+   * @param solData The new SOL data.
+   */
+  void replace(std::size_t position, const SOLData& solData);
+
+  /**
+   * @brief Appends rows for the caller to fill in directly.
+   * @param rows The number of rows to append; they start value-initialized.
+   * @return Pointers to the first new row of each column, valid until the
+   * next modification.
+   */
+  SOLColumnPointers grow(std::size_t rows);
+
+  /**
+   * @brief Removes every row but keeps the allocated capacity.
+   */
+  void clear();
+
+  /**
+   * @brief Rebuilds the SOLData of a row.
+   * @param position The row position; below size().
+   * @return The SOL data.
+   */
+  SOLData row(std::size_t position) const;
+
+  /**
+   * @brief Reserves space for a number of rows in every column.
+   * @param rows The number of rows.
+   */
+  void reserve(std::size_t rows);
+
+  /**
+   * @brief Gets the number of rows.
+   * @return The number of rows.
+   */
+  std::size_t size() const;
+
+  /** @brief Gets the SOL number column. */
+  ColumnSpan<int> getSolNumbers() const;
+
+  /** @brief Gets the temperature column, in Kelvin. */
+  ColumnSpan<double> getTemperatures() const;
+
+  /** @brief Gets the distance column, in meters. */
+  ColumnSpan<double> getDistances() const;
+
+  /** @brief Gets the direction column; codes are Direction values. */
+  ColumnSpan<std::uint8_t> getDirections() const;
+
+  /** @brief Gets the element ID column; see SampleClassification. */
+  ColumnSpan<std::int16_t> getElementIds() const;
+
+  /** @brief Gets the cold temperature aggregate column. */
+  ColumnSpan<TemperatureAggregate> getTemperatureAggregates() const;
+
+  /** @brief Gets the cold raw sample reading column. */
+  ColumnSpan<SampleReading> getSampleReadings() const;
+};
+
+#endif  // SOLCOLUMNSTORE_H
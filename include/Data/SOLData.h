@@ -12,21 +12,29 @@
 #include "Subsystems/Navigation.h"
 #include "Subsystems/SampleAnalysis.h"
 #include "Subsystems/Temperature.h"
+#include "Temperature/TemperatureAggregate.h"
 
 #include <optional>
+#include <type_traits>
 
 
 
 /**
  * @class SOLData
  * @brief Encapsulates all data collected during a single Sol.
+ *
+ * SOLData is a trivially copyable value of under a hundred bytes, with no
+ * heap-owning members, so passing it from the Robot through MissionControl to
+ * DataStorage never allocates. The two 4-byte members are declared together
+ * to avoid padding.
  */
 class SOLData {
  private:
   int solNumber;         /**< The Sol number. */
-  double SOLTemperature{}; /**< The temperature of the Sol. */
-  NavigationRecord navigationData;   /**< The navigation data. */
   SampleClassification sampleData; /**< The sample data. */
+  TemperatureAggregate SOLTemperature; /**< The temperatures of the Sol. */
+  NavigationRecord navigationData;   /**< The navigation data. */
+  SampleReading sampleReading;     /**< The raw sample reading. */
 
  public:
   /**
@@ -36,11 +44,17 @@ class SOLData {
   SOLData(int solNum);
 
   /**
-   * @brief Stores temperature data for the Sol.
+   * @brief Stores temperature data for the Sol as its only reading.
    * @param data The TemperatureData to store.
    */
   void storeTemperatureData(const double& data);
 
+  /**
+   * @brief Stores the aggregate of every temperature reading of the Sol.
+   * @param aggregate The TemperatureAggregate to store.
+   */
+  void storeTemperatureAggregate(const TemperatureAggregate& aggregate);
+
   /**
    * @brief Stores navigation data for the Sol.
    * @param data The NavigationData to store.
@@ -53,6 +67,12 @@ class SOLData {
    */
   void storeSampleData(const SampleClassification& data);
 
+  /**
+   * @brief Stores the raw sample reading for the Sol.
+   * @param reading The SampleReading to store.
+   */
+  void storeSampleReading(const SampleReading& reading);
+
   /**
    * @brief Gets the Sol number.
    * @return The Sol number.
@@ -61,10 +81,16 @@ class SOLData {
 
   /**
    * @brief Gets the temperature data to store.
-   * @return Constant reference to the TemperatureData.
+   * @return Constant reference to the most recent reading of the Sol.
    */
   const double& getTemperatureData() const;
 
+  /**
+   * @brief Gets the aggregate of the Sol's temperature readings.
+   * @return Constant reference to the TemperatureAggregate.
+   */
+  const TemperatureAggregate& getTemperatureAggregate() const;
+
   /**
    * @brief Gets the final navigation Record to store.
    * @return Constant reference to the optional NavigationRecord.
@@ -76,6 +102,15 @@ class SOLData {
    * @return Constant reference to the optional SampleClassification.
    */
   const SampleClassification& getSampleData() const;
+
+  /**
+   * @brief Gets the raw sample reading.
+   * @return Constant reference to the SampleReading.
+   */
+  const SampleReading& getSampleReading() const;
 };
 
+static_assert(std::is_trivially_copyable<SOLData>::value,
+              "SOLData must stay trivially copyable");
+
 #endif  // SOLDATA_H
@@ -0,0 +1,184 @@
+/**
+ * @file SOLDataView.h
+ * @brief Declaration of the SOLDataView class.
+ *
+ * The SOLDataView class is a read-only range over stored SOL data that lets
+ * callers walk the mission, row by row or column by column, without copying
+ * it.
+ */
+#ifndef SOLDATAVIEW_H
+#define SOLDATAVIEW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include "Data/SOLColumnStore.h"
+#include "Data/SOLData.h"
+
+/**
+ * @class SOLDataView
+ * @brief Non-owning, const range of rows in a SOLColumnStore.
+ *
+ * Column accessors return spans limited to the range for vectorized scans.
+ * Row access rebuilds each SOLData on demand, so iterators yield values rather
+ * than references. A view is as cheap to copy as a pointer and two positions
+ * and stays valid while the storage lives; inserting an out-of-order SOL
+ * shifts the rows it covers.
+ */
+class SOLDataView {
+ private:
+  const SOLColumnStore* store; /**< The viewed store, or nullptr if empty. */
+  std::size_t first;           /**< First row of the range. */
+  std::size_t last;            /**< One past the last row of the range. */
+
+ public:
+  /**
+   * @class const_iterator
+   * @brief Iterator yielding rebuilt SOLData rows.
+   */
+  class const_iterator {
+   private:
+    const SOLColumnStore* store;
+    std::size_t position;
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = SOLData;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const SOLData*;
+    using reference = SOLData;
+
+    const_iterator(const SOLColumnStore* store, const std::size_t position)
+        : store(store), position(position) {}
+
+    /** @brief Rebuilds the current row. */
+    SOLData operator*() const { return store->row(position); }
+
+    const_iterator& operator++() {
+      ++position;
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      const_iterator previous = *this;
+      ++position;
+      return previous;
+    }
+
+    const_iterator& operator--() {
+      --position;
+      return *this;
+    }
+
+    bool operator==(const const_iterator& other) const {
+      return position == other.position && store == other.store;
+    }
+
+    bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    /** @brief Gets the row position in the store. */
+    std::size_t getPosition() const { return position; }
+  };
+
+  /**
+   * @brief Constructs an empty view.
+   */
+  SOLDataView() : store(nullptr), first(0), last(0) {}
+
+  /**
+   * @brief Constructs a view over rows [begin, end) of a store.
+   * @param store The store to view; it must outlive the view.
+   * @param begin First row of the range.
+   * @param end One past the last row of the range.
+   */
+  SOLDataView(const SOLColumnStore& store, const std::size_t begin,
+              const std::size_t end)
+      : store(&store), first(begin), last(end) {}
+
+  /** @brief Gets an iterator to the first row. */
+  const_iterator begin() const { return const_iterator(store, first); }
+
+  /** @brief Gets an iterator past the last row. */
+  const_iterator end() const { return const_iterator(store, last); }
+
+  /** @brief Gets the number of rows. */
+  std::size_t size() const { return last - first; }
+
+  /** @brief Checks whether the view is empty. */
+  bool empty() const { return first == last; }
+
+  /** @brief Rebuilds a row without bounds checking. */
+  SOLData operator[](const std::size_t index) const { return store->row(first + index); }
+
+  /**
+   * @brief Rebuilds a row with bounds checking.
+   * @param index Index of the row within the view.
+   * @return The SOL data.
+   * @throw std::out_of_range if index is not below size().
+   */
+  SOLData at(const std::size_t index) const {
+    if (index >= size()) {
+      throw std::out_of_range("SOLDataView index out of range");
+    }
+    return (*this)[index];
+  }
+
+  /** @brief Rebuilds the first row; the view must not be empty. */
+  SOLData front() const { return (*this)[0]; }
+
+  /** @brief Rebuilds the last row; the view must not be empty. */
+  SOLData back() const { return (*this)[size() - 1]; }
+
+  /**
+   * @brief Gets a sub-view.
+   * @param offset Index of the first row of the sub-view.
+   * @param count Maximum number of rows in the sub-view.
+   * @return The sub-view, clamped to this view.
+   */
+  SOLDataView subview(const std::size_t offset, const std::size_t count) const {
+    const std::size_t begin = offset < size() ? offset : size();
+    const std::size_t length = count < size() - begin ? count : size() - begin;
+    SOLDataView view(*this);
+    view.first = first + begin;
+    view.last = first + begin + length;
+    return view;
+  }
+
+  /** @brief Gets the SOL numbers of the viewed rows. */
+  ColumnSpan<int> getSolNumbers() const { return column(&SOLColumnStore::getSolNumbers); }
+
+  /** @brief Gets the temperatures of the viewed rows, in Kelvin. */
+  ColumnSpan<double> getTemperatures() const {
+    return column(&SOLColumnStore::getTemperatures);
+  }
+
+  /** @brief Gets the distances of the viewed rows, in meters. */
+  ColumnSpan<double> getDistances() const { return column(&SOLColumnStore::getDistances); }
+
+  /** @brief Gets the direction codes of the viewed rows. */
+  ColumnSpan<std::uint8_t> getDirections() const {
+    return column(&SOLColumnStore::getDirections);
+  }
+
+  /** @brief Gets the element IDs of the viewed rows. */
+  ColumnSpan<std::int16_t> getElementIds() const {
+    return column(&SOLColumnStore::getElementIds);
+  }
+
+  /** @brief Gets the raw sample readings of the viewed rows. */
+  ColumnSpan<SampleReading> getSampleReadings() const {
+    return column(&SOLColumnStore::getSampleReadings);
+  }
+
+ private:
+  template <typename T>
+  ColumnSpan<T> column(ColumnSpan<T> (SOLColumnStore::*getter)() const) const {
+    if (store == nullptr) {
+      return ColumnSpan<T>();
+    }
+    return (store->*getter)().subspan(first, size());
+  }
+};
+
+#endif  // SOLDATAVIEW_H
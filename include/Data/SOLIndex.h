@@ -0,0 +1,94 @@
+/**
+ * @file SOLIndex.h
+ * @brief Declaration of the SOLIndex class.
+ *
+ * The SOLIndex class maps SOL numbers to positions in storage kept in SOL
+ * order, for constant-time lookups and logarithmic range queries.
+ */
+#ifndef SOLINDEX_H
+#define SOLINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @class SOLIndex
+ * @brief SOL-number index over storage sorted by SOL number.
+ *
+ * The SOL number at every storage position is kept in a sorted key array, so
+ * lookups and range bounds are binary searches. While the stored SOLs are
+ * close to contiguous (their span is at most DENSE_SPAN_FACTOR times their
+ * count plus DENSE_SPAN_SLACK), a direct-addressed table also answers point
+ * lookups in O(1). It is dropped once gaps make it too sparse.
+ */
+class SOLIndex {
+ private:
+  std::vector<int> keys;             /**< SOL number at each position. */
+  std::vector<std::int64_t> dense;   /**< Position per SOL from denseBase. */
+  int denseBase;
+  bool denseEnabled;
+
+  /**
+   * @brief Rebuilds the dense table from the keys, if they are dense enough.
+   */
+  void rebuildDense();
+
+ public:
+  /** @brief Returned by find() when a SOL is not indexed. */
+  static const std::size_t NOT_FOUND;
+  /** @brief Maximum span of SOL numbers per indexed SOL for the dense table. */
+  static const std::size_t DENSE_SPAN_FACTOR = 2;
+  /** @brief Extra span always allowed for the dense table. */
+  static const std::size_t DENSE_SPAN_SLACK = 64;
+
+  /**
+   * @brief Constructs an empty index.
+   */
+  SOLIndex();
+
+  /**
+   * @brief Finds the storage position of a SOL.
+   * @param solNumber The SOL number.
+   * @return The position, or NOT_FOUND.
+   */
+  std::size_t find(int solNumber) const;
+
+  /**
+   * @brief Finds where a new SOL belongs to keep storage in SOL order.
+   * @param solNumber The SOL number.
+   * @return The position of the first stored SOL with a larger number.
+   */
+  std::size_t insertionPoint(int solNumber) const;
+
+  /**
+   * @brief Indexes a new SOL stored at its insertion point; later positions
+   * shift up by one.
+   * @param solNumber The SOL number, which must not be indexed yet.
+   * @param position The value insertionPoint(solNumber) returned.
+   */
+  void insert(int solNumber, std::size_t position);
+
+  /**
+   * @brief Finds the positions of every SOL in [firstSol, lastSol].
+   * @param firstSol The first SOL number of the range.
+   * @param lastSol The last SOL number of the range.
+   * @return The half-open position range; empty if no SOL matches.
+   */
+  std::pair<std::size_t, std::size_t> range(int firstSol, int lastSol) const;
+
+  /**
+   * @brief Checks whether point lookups use the dense table.
+   * @return True if the dense table is active.
+   */
+  bool isDense() const;
+
+  /**
+   * @brief Gets the number of indexed SOLs.
+   * @return The number of SOLs.
+   */
+  std::size_t size() const;
+};
+
+#endif  // SOLINDEX_H
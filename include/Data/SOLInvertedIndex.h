@@ -0,0 +1,77 @@
+/**
+ * @file SOLInvertedIndex.h
+ * @brief Declaration of the SOLInvertedIndex class.
+ *
+ * The SOLInvertedIndex class maps each classified element and each final
+ * direction to the SOLs that have it, so questions such as "which SOLs found
+ * Iron while heading Left?" are answered without scanning the mission.
+ */
+#ifndef SOLINVERTEDINDEX_H
+#define SOLINVERTEDINDEX_H
+
+#include <map>
+#include "Data/SOLData.h"
+#include "Data/SOLPostings.h"
+#include "Data/SOLZoneMap.h"
+
+/**
+ * @class SOLInvertedIndex
+ * @brief Postings of SOL numbers per element ID and per Direction.
+ *
+ * Every stored SOL is listed under its element ID, including
+ * UNKNOWN_ELEMENT_ID and UNCLASSIFIED_ELEMENT_ID, and under its final
+ * Direction. Keys are the integer codes SOLQuery compares, so the postings of
+ * SOLColumn::Element value v list the SOLs a query for "Element == v"
+ * matches. Combine keys with SOLPostings::intersect().
+ */
+class SOLInvertedIndex {
+ private:
+  std::map<int, SOLPostings> elements;
+  std::map<int, SOLPostings> directions;
+
+ public:
+  /**
+   * @brief Lists a SOL under its element and direction.
+   * @param solData The SOL, which must not be listed yet.
+   */
+  void add(const SOLData& solData);
+
+  /**
+   * @brief Lists a SOL from its column codes.
+   * @param solNumber The SOL number, which must not be listed yet.
+   * @param elementId The SOL's element ID.
+   * @param direction The SOL's final Direction, as its enumerator value.
+   */
+  void add(int solNumber, int elementId, int direction);
+
+  /**
+   * @brief Unlists a SOL, as before its entry is replaced.
+   * @param solData The SOL as it was listed.
+   */
+  void remove(const SOLData& solData);
+
+  /**
+   * @brief Gets the postings of every value of a key column.
+   * @param key SOLColumn::Element or SOLColumn::Direction.
+   * @return The postings, by value; values no SOL has are absent.
+   * @throw std::invalid_argument if key is not indexed.
+   */
+  const std::map<int, SOLPostings>& getPostings(SOLColumn key) const;
+
+  /**
+   * @brief Gets the SOLs with one value of a key column.
+   * @param key SOLColumn::Element or SOLColumn::Direction.
+   * @param value The element ID or Direction enumerator value.
+   * @return The postings, empty if no SOL has the value.
+   * @throw std::invalid_argument if key is not indexed.
+   */
+  const SOLPostings& getPostings(SOLColumn key, int value) const;
+
+  /**
+   * @brief Gets the bytes used by every posting list.
+   * @return The footprint in bytes.
+   */
+  std::size_t getFootprint() const;
+};
+
+#endif  // SOLINVERTEDINDEX_H
@@ -8,6 +8,7 @@
 #ifndef SOLMANAGER_H
 #define SOLMANAGER_H
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 #include "Data/SOLData.h"
@@ -37,6 +38,9 @@ class SOLObserver {
 
 using SOLObserverPtr = std::shared_ptr<SOLObserver>;
 
+class AsyncSOLObserver;
+enum class BackpressurePolicy;
+
 /**
  * @class SOLManager
  * @brief Manages SOL progression and notifies observers of SOL finalization.
@@ -47,6 +51,8 @@ class SOLManager {
   int totalSOLs;  /**< The total number of SOLs. */
   std::vector<std::weak_ptr<SOLObserver>>
       observers; /**< The observers of the SOL. */
+  std::vector<std::shared_ptr<AsyncSOLObserver>>
+      dispatchers; /**< The observers notified on their own threads. */
 
  public:
   /**
@@ -55,6 +61,12 @@ class SOLManager {
    */
   SOLManager(int totalSOLs = 0);
 
+  /**
+   * @brief Destructor; delivers the SOLs still queued for asynchronous
+   * observers.
+   */
+  ~SOLManager();
+
   /**
    * @brief Advances to the next SOL.
    */
@@ -72,12 +84,33 @@ class SOLManager {
    */
   int getTotalSOLs() const;
 
+  /**
+   * @brief Restores the counters from a checkpoint.
+   * @param currentSOL The current SOL number.
+   * @param totalSOLs The total number of SOLs elapsed.
+   */
+  void restore(int currentSOL, int totalSOLs);
+
   /**
    * @brief Adds an observer to be notified of SOL finalization.
    * @param observer Shared pointer to the observer to add.
    */
   void addObserver(SOLObserverPtr observer);
 
+  /**
+   * @brief Adds an observer notified on a thread of its own, so that it
+   * cannot stall the thread finalizing SOLs.
+   *
+   * The manager keeps the observer alive until it is removed.
+   * @param observer Shared pointer to the observer to add.
+   * @param policy What to do with a SOL when the observer falls behind.
+   * @param capacity The number of SOLs queued for it, a power of two.
+   * @throw std::invalid_argument if capacity is not a power of two of at
+   * least 2.
+   */
+  void addObserver(SOLObserverPtr observer, BackpressurePolicy policy,
+                   std::size_t capacity);
+
   /**
    * @brief Removes an observer from the notification list.
    * @param observer Shared pointer to the observer to remove.
@@ -85,7 +118,15 @@ class SOLManager {
   void removeObserver(const SOLObserverPtr& observer);
 
   /**
-   * @brief Notifies all observers of SOL finalization.
+   * @brief Waits until every asynchronous observer has received the SOLs
+   * notified so far.
+   * @throw Whatever an asynchronous observer threw, if one failed.
+   */
+  void flushObservers() const;
+
+  /**
+   * @brief Notifies all observers of SOL finalization; asynchronous
+   * observers receive a copy later.
    * @param solData The finalized SOL data.
    */
   void notifyObservers(const SOLData& solData) const;
@@ -0,0 +1,124 @@
+/**
+ * @file SOLPostings.h
+ * @brief Declaration of the SOLPostings class.
+ *
+ * The SOLPostings class holds a sorted list of SOL numbers, such as every SOL
+ * that found Iron, compressed for the inverted index.
+ */
+#ifndef SOLPOSTINGS_H
+#define SOLPOSTINGS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Number of SOL numbers per chunk of a SOLPostings list.
+ */
+const std::size_t POSTINGS_CHUNK_SIZE = 128;
+
+/**
+ * @class SOLPostings
+ * @brief Compressed, sorted list of distinct SOL numbers.
+ *
+ * SOL numbers are stored in chunks of POSTINGS_CHUNK_SIZE: each chunk keeps
+ * its first SOL uncompressed in a skip table, followed by the gaps to the
+ * rest as varints, so a mission of consecutive SOLs costs about a byte per
+ * SOL. Searches binary-search the skip table and decode a single chunk, which
+ * lets intersect() skip whole chunks of a long list.
+ *
+ * Appending a SOL above the last one is O(1). Inserting out of order or
+ * removing re-encodes the list, which is meant for the rare late or replaced
+ * SOL.
+ */
+class SOLPostings {
+ private:
+  /**
+   * @struct Chunk
+   * @brief Skip-table entry of a chunk.
+   */
+  struct Chunk {
+    int first;          /**< The chunk's first SOL number. */
+    std::size_t offset; /**< Where its gaps start in gaps. */
+  };
+
+  class Cursor;
+
+  std::vector<Chunk> chunks;
+  std::vector<std::uint8_t> gaps; /**< Varint gaps after each chunk's first SOL. */
+  std::size_t count;
+  int last;
+
+  /** @brief Finds the last chunk from a given one starting at or below a SOL. */
+  std::size_t chunkOf(int solNumber, std::size_t from) const;
+
+  /** @brief Appends the SOL numbers of a chunk to a vector. */
+  void decodeChunk(std::size_t chunk, std::vector<int>& solNumbers) const;
+
+  /** @brief Replaces the list with sorted, distinct SOL numbers. */
+  void rebuild(const std::vector<int>& solNumbers);
+
+ public:
+  /**
+   * @brief Constructs an empty list.
+   */
+  SOLPostings();
+
+  /**
+   * @brief Adds a SOL number.
+   * @param solNumber The SOL number.
+   * @return False if the SOL was already in the list.
+   */
+  bool add(int solNumber);
+
+  /**
+   * @brief Removes a SOL number.
+   * @param solNumber The SOL number.
+   * @return False if the SOL was not in the list.
+   */
+  bool remove(int solNumber);
+
+  /**
+   * @brief Checks whether a SOL number is in the list.
+   * @param solNumber The SOL number.
+   * @return True if it is.
+   */
+  bool contains(int solNumber) const;
+
+  /**
+   * @brief Decodes the whole list.
+   * @return The SOL numbers, in increasing order.
+   */
+  std::vector<int> getSOLs() const;
+
+  /**
+   * @brief Gets the highest SOL numbers, decoding only the chunks needed.
+   * @param limit The most SOL numbers to return.
+   * @return Up to limit SOL numbers, newest first.
+   */
+  std::vector<int> getLast(std::size_t limit) const;
+
+  /**
+   * @brief Gets the SOL numbers present in every list.
+   *
+   * The shortest list drives the intersection; the others are searched
+   * forward from their last match, skipping chunks through their skip tables.
+   * @param lists The lists to intersect; none may be null.
+   * @return The common SOL numbers, in increasing order; empty if lists is.
+   */
+  static std::vector<int> intersect(const std::vector<const SOLPostings*>& lists);
+
+  /**
+   * @brief Gets the number of SOL numbers in the list.
+   * @return The count.
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Gets the bytes used by the compressed list.
+   * @return The footprint in bytes.
+   */
+  std::size_t getFootprint() const;
+};
+
+#endif  // SOLPOSTINGS_H
@@ -0,0 +1,152 @@
+/**
+ * @file SOLQuery.h
+ * @brief Declaration of the SOLQuery class and its predicate and aggregate
+ * types.
+ *
+ * The SOLQuery class answers filtered questions about the stored mission,
+ * such as "SOLs where the element is Iron and the distance exceeds 50 m" or
+ * "mean temperature per direction", without hand-written loops over rows.
+ */
+#ifndef SOLQUERY_H
+#define SOLQUERY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <vector>
+#include "Data/DataStorage.h"
+#include "Data/SOLZoneMap.h"
+
+/**
+ * @enum SOLComparison
+ * @brief How a predicate compares a column value with its operand.
+ */
+enum class SOLComparison { Less, LessOrEqual, Equal, NotEqual, GreaterOrEqual, Greater };
+
+/**
+ * @struct SOLPredicate
+ * @brief One filter of a query: column, comparison, operand.
+ */
+struct SOLPredicate {
+  SOLColumn column;         /**< The filtered column. */
+  SOLComparison comparison; /**< The comparison applied. */
+  double operand;           /**< The value compared against. */
+};
+
+/**
+ * @struct SOLAggregate
+ * @brief Count, sum, minimum and maximum of a column over matching SOLs.
+ */
+struct SOLAggregate {
+  std::size_t count = 0;                                       /**< Matching SOLs. */
+  double sum = 0.0;                                            /**< Sum of values. */
+  double minimum = std::numeric_limits<double>::infinity();   /**< Lowest value. */
+  double maximum = -std::numeric_limits<double>::infinity();  /**< Highest value. */
+
+  /**
+   * @brief Adds a value to the aggregate.
+   * @param value The value.
+   */
+  void add(double value);
+
+  /**
+   * @brief Folds another aggregate into this one.
+   * @param other The aggregate to fold in.
+   */
+  void merge(const SOLAggregate& other);
+
+  /**
+   * @brief Gets the mean of the values.
+   * @return The mean, or NaN if no SOL matched.
+   */
+  double getMean() const;
+};
+
+/**
+ * @class SOLQuery
+ * @brief Conjunction of column predicates, run against a DataStorage.
+ *
+ * Predicates are pushed down to DataStorage::forEachZone(): a zone whose
+ * zone map rules out any predicate is skipped without being read or, under
+ * the compressed layout, decoded. Within a zone each predicate is evaluated
+ * over its whole column into a selection bitmap, one bit per row, and the
+ * bitmaps are ANDed; projections and aggregates then read only the selected
+ * rows. Runs of fully selected rows are reduced with ReductionKernels.
+ *
+ * Results are in SOL order. A query holds no reference to the storage it
+ * ran on and may be reused.
+ */
+class SOLQuery {
+ private:
+  std::vector<SOLPredicate> predicates;
+
+  /** @brief Checks whether a zone may hold a matching row. */
+  bool mayMatch(const SOLZoneMap& zone) const;
+
+  /** @brief Visits each scanned zone with its selection bitmap. */
+  void scan(const DataStorage& storage,
+            const std::function<void(const SOLDataView&, const std::uint64_t*)>& visitor)
+      const;
+
+ public:
+  /**
+   * @brief Adds a predicate every matching SOL must satisfy.
+   * @param column The filtered column.
+   * @param comparison The comparison applied to the column value.
+   * @param operand The value compared against; Direction values and element
+   * IDs compare as their integer codes.
+   * @return This query, for chaining.
+   */
+  SOLQuery& where(SOLColumn column, SOLComparison comparison, double operand);
+
+  /**
+   * @brief Gets the predicates added so far.
+   * @return The predicates, in the order they were added.
+   */
+  const std::vector<SOLPredicate>& getPredicates() const;
+
+  /**
+   * @brief Counts the matching SOLs.
+   * @param storage The storage to query.
+   * @return The number of matching SOLs.
+   */
+  std::size_t count(const DataStorage& storage) const;
+
+  /**
+   * @brief Projects one column of the matching SOLs.
+   * @param storage The storage to query.
+   * @param column The projected column.
+   * @return The column values of the matching SOLs, in SOL order.
+   */
+  std::vector<double> select(const DataStorage& storage, SOLColumn column) const;
+
+  /**
+   * @brief Gets the SOL numbers of the matching SOLs.
+   * @param storage The storage to query.
+   * @return The matching SOL numbers, in increasing order.
+   */
+  std::vector<int> selectSOLs(const DataStorage& storage) const;
+
+  /**
+   * @brief Aggregates one column over the matching SOLs.
+   * @param storage The storage to query.
+   * @param column The aggregated column.
+   * @return The aggregate.
+   */
+  SOLAggregate aggregate(const DataStorage& storage, SOLColumn column) const;
+
+  /**
+   * @brief Aggregates one column over the matching SOLs, per group.
+   * @param storage The storage to query.
+   * @param key The grouping column: SOLColumn::Direction or SOLColumn::Element.
+   * @param column The aggregated column.
+   * @return The aggregate of each key value that has a matching SOL.
+   * @throw std::invalid_argument if key is not a grouping column.
+   */
+  std::map<int, SOLAggregate> aggregateBy(const DataStorage& storage, SOLColumn key,
+                                          SOLColumn column) const;
+};
+
+#endif  // SOLQUERY_H
@@ -0,0 +1,116 @@
+/**
+ * @file SOLSegmentLog.h
+ * @brief Declaration of the SOLSegmentLog class.
+ *
+ * The SOLSegmentLog class keeps the finalized SOLs where threads other than
+ * the ingest thread, such as live dashboards, can read them while ingest is
+ * still appending.
+ */
+#ifndef SOLSEGMENTLOG_H
+#define SOLSEGMENTLOG_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "Data/SOLColumnStore.h"
+#include "Data/SOLData.h"
+#include "Data/SOLDataView.h"
+#include "Data/SOLManager.h"
+
+/**
+ * @brief Number of rows per segment of a SOLSegmentLog.
+ */
+const std::size_t SOL_SEGMENT_ROWS = 4096;
+
+/**
+ * @class SOLSegmentLog
+ * @brief Append-only, single-writer, multi-reader log of finalized SOLs.
+ *
+ * Rows are written into fixed-size column segments that are never moved or
+ * freed while the log lives, so a row once published stays where readers
+ * found it. The writer fills a row and then publishes the new size with a
+ * release store; readers load the size with acquire and read only the rows
+ * below it, without taking locks or writing shared memory. The segment
+ * directory is replaced rather than grown in place, and retired directories
+ * are kept until the log is destroyed.
+ *
+ * Exactly one thread may call append() or onSOLFinalized(); any number of
+ * threads may call the const methods concurrently with it. Rows are kept in
+ * finalization order, which is SOL order unless input arrives out of order.
+ */
+class SOLSegmentLog : public SOLObserver {
+ private:
+  struct Segment;
+
+  /**
+   * @struct Directory
+   * @brief Fixed-capacity table of segments, replaced when full.
+   */
+  struct Directory {
+    std::vector<Segment*> segments; /**< Sized once; slots filled by the writer. */
+  };
+
+  std::vector<std::unique_ptr<Segment>> segments;       /**< Writer only. */
+  std::vector<std::unique_ptr<Directory>> directories;  /**< Writer only. */
+  std::atomic<const Directory*> directory;
+  std::atomic<std::size_t> published;
+  SOLColumnStore scratch; /**< Writer only; converts a SOLData to columns. */
+
+  /** @brief Adds a segment, replacing the directory if it is full. */
+  void addSegment();
+
+  /** @brief Gets the segment holding a published position. */
+  Segment& segmentOf(std::size_t position) const;
+
+ public:
+  /**
+   * @brief Constructs an empty log.
+   */
+  SOLSegmentLog();
+
+  SOLSegmentLog(const SOLSegmentLog&) = delete;
+  SOLSegmentLog& operator=(const SOLSegmentLog&) = delete;
+
+  /**
+   * @brief Frees every segment; no reader may still be using the log.
+   */
+  ~SOLSegmentLog() override;
+
+  /**
+   * @brief Appends and publishes a SOL; writer thread only.
+   * @param solData The SOL data.
+   */
+  void append(const SOLData& solData);
+
+  /**
+   * @brief Appends a finalized SOL; writer thread only.
+   * @param solData The finalized SOL data.
+   */
+  void onSOLFinalized(const SOLData& solData) override;
+
+  /**
+   * @brief Gets the number of published rows.
+   * @return The count; it only grows.
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Rebuilds a published row.
+   * @param position The row position, in finalization order.
+   * @return The SOL data.
+   * @throw std::out_of_range if the row is not published yet.
+   */
+  SOLData row(std::size_t position) const;
+
+  /**
+   * @brief Visits the rows published when the call starts, one segment at a
+   * time, without copying them.
+   * @param visitor Function invoked with the rows of each segment; the view is
+   * only valid during the call.
+   */
+  void forEachSegment(const std::function<void(const SOLDataView&)>& visitor) const;
+};
+
+#endif  // SOLSEGMENTLOG_H
@@ -0,0 +1,67 @@
+/**
+ * @file SOLZoneMap.h
+ * @brief Declaration of the SOLColumn enum and SOLZoneMap struct.
+ *
+ * A SOLZoneMap summarizes a run of stored rows by the range of each
+ * filterable column, so a query can skip runs that cannot match without
+ * reading them.
+ */
+#ifndef SOLZONEMAP_H
+#define SOLZONEMAP_H
+
+#include <cstddef>
+#include "Data/SOLColumnStore.h"
+
+/**
+ * @enum SOLColumn
+ * @brief The stored columns a query can filter, project and group on.
+ */
+enum class SOLColumn {
+  SolNumber,   /**< The SOL number. */
+  Temperature, /**< The final temperature in Kelvin. */
+  Distance,    /**< The final distance in meters. */
+  Direction,   /**< The final Direction, as its enumerator value. */
+  Element      /**< The classified element ID. */
+};
+
+/**
+ * @brief Number of SOLColumn enumerators.
+ */
+const std::size_t SOL_COLUMN_COUNT = 5;
+
+/**
+ * @struct SOLZoneMap
+ * @brief Minimum and maximum of every SOLColumn over a run of rows.
+ *
+ * A run holding a NaN gets the unbounded range for that column, since NaN
+ * is unordered and a predicate such as "not equal" still matches it.
+ */
+struct SOLZoneMap {
+  double minimum[SOL_COLUMN_COUNT]; /**< Indexed by SOLColumn. */
+  double maximum[SOL_COLUMN_COUNT]; /**< Indexed by SOLColumn. */
+
+  /**
+   * @brief Computes the zone map of a run of rows.
+   * @param rows The store holding the run.
+   * @param first Position of the first row.
+   * @param count Number of rows.
+   * @return The zone map; empty runs get an inverted range.
+   */
+  static SOLZoneMap of(const SOLColumnStore& rows, std::size_t first, std::size_t count);
+
+  /**
+   * @brief Gets the smallest value of a column in the run.
+   * @param column The column.
+   * @return The minimum.
+   */
+  double getMinimum(SOLColumn column) const;
+
+  /**
+   * @brief Gets the largest value of a column in the run.
+   * @param column The column.
+   * @return The maximum.
+   */
+  double getMaximum(SOLColumn column) const;
+};
+
+#endif  // SOLZONEMAP_H
@@ -0,0 +1,129 @@
+/**
+ * @file SeriesDownsampler.h
+ * @brief Declaration of the SeriesDownsampler and IncrementalDownsampler
+ * classes.
+ *
+ * These classes reduce long per-SOL series to a target number of points for
+ * plotting, keeping the visual shape with Largest-Triangle-Three-Buckets and
+ * the value range of each bucket as a min/max envelope.
+ */
+#ifndef SERIESDOWNSAMPLER_H
+#define SERIESDOWNSAMPLER_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @struct DownsampledPoint
+ * @brief A kept point and the envelope of the points it stands for.
+ */
+struct DownsampledPoint {
+  double x;
+  double y;
+  double minimum; /**< Lowest y in the point's bucket. */
+  double maximum; /**< Highest y in the point's bucket. */
+};
+
+/**
+ * @class SeriesDownsampler
+ * @brief Batch Largest-Triangle-Three-Buckets over columnar series.
+ *
+ * The first and last points are always kept; the others are split into
+ * targetPoints - 2 equal buckets and each bucket keeps the point forming the
+ * largest triangle with the previously kept point and the average of the next
+ * bucket. Bucket averages and envelopes are computed in the same linear pass.
+ */
+class SeriesDownsampler {
+ public:
+  /**
+   * @brief Downsamples a series given as x and y columns.
+   * @param x The x column, in increasing order.
+   * @param y The y column.
+   * @param low Per-point lower envelope; pass y for raw data.
+   * @param high Per-point upper envelope; pass y for raw data.
+   * @param size Number of points.
+   * @param targetPoints Number of points to keep.
+   * @return The kept points, or every point if size <= targetPoints.
+   * @throw std::invalid_argument if targetPoints is below 3.
+   */
+  static std::vector<DownsampledPoint> downsample(const double* x, const double* y,
+                                                  const double* low,
+                                                  const double* high,
+                                                  std::size_t size,
+                                                  std::size_t targetPoints);
+
+  /**
+   * @brief Downsamples a raw series given as x and y columns.
+   * @param x The x column, in increasing order.
+   * @param y The y column, of the same length.
+   * @param targetPoints Number of points to keep.
+   * @return The kept points.
+   * @throw std::invalid_argument if targetPoints is below 3 or the columns
+   * differ in length.
+   */
+  static std::vector<DownsampledPoint> downsample(const std::vector<double>& x,
+                                                  const std::vector<double>& y,
+                                                  std::size_t targetPoints);
+};
+
+/**
+ * @class IncrementalDownsampler
+ * @brief Bounded-memory downsampling of a series that keeps growing.
+ *
+ * Points are folded into equal-width buckets that remember their count, sums
+ * and lowest and highest points. Once there are more than 2 * targetPoints
+ * buckets, neighbours are merged pairwise and the bucket width doubles, so
+ * memory stays O(targetPoints) and each point costs amortized O(1).
+ * getPoints() runs LTTB over each bucket's lowest and highest points, which
+ * are the candidates LTTB favours, with the buckets' envelopes carried along.
+ */
+class IncrementalDownsampler {
+ private:
+  /** @brief Summary of a run of consecutive points. */
+  struct Bucket {
+    std::size_t count;
+    double lowX, lowY;   /**< Point with the lowest y. */
+    double highX, highY; /**< Point with the highest y. */
+  };
+
+  std::size_t targetPoints;
+  std::size_t bucketWidth; /**< Points per bucket; a power of two. */
+  std::size_t total;
+  double firstX, firstY;
+  double lastX, lastY;
+  std::vector<Bucket> buckets;
+
+  /**
+   * @brief Merges neighbouring buckets pairwise, doubling the bucket width.
+   */
+  void compact();
+
+ public:
+  /**
+   * @brief Constructs an empty downsampler.
+   * @param targetPoints Number of points getPoints() returns at most.
+   * @throw std::invalid_argument if targetPoints is below 3.
+   */
+  explicit IncrementalDownsampler(std::size_t targetPoints);
+
+  /**
+   * @brief Appends a point; x must not decrease.
+   * @param x The x value, e.g. the SOL number.
+   * @param y The y value.
+   */
+  void add(double x, double y);
+
+  /**
+   * @brief Gets the number of points added.
+   * @return The number of points.
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Downsamples everything added so far.
+   * @return At most targetPoints points.
+   */
+  std::vector<DownsampledPoint> getPoints() const;
+};
+
+#endif  // SERIESDOWNSAMPLER_H
@@ -0,0 +1,82 @@
+/**
+ * @file SeriesExport.h
+ * @brief Declaration of the SeriesExport class.
+ *
+ * The SeriesExport class writes downsampled per-SOL temperature and distance
+ * series for plotting tools that cannot handle multi-year missions at full
+ * resolution.
+ */
+#ifndef SERIESEXPORT_H
+#define SERIESEXPORT_H
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+#include "Data/DataStorage.h"
+#include "Data/SOLManager.h"
+#include "Data/SeriesDownsampler.h"
+
+/**
+ * @brief Default number of points exported per series.
+ */
+const std::size_t DEFAULT_EXPORT_POINTS = 500;
+
+/**
+ * @class SeriesExport
+ * @brief Incremental export of downsampled temperature and distance series.
+ *
+ * As a SOLObserver it keeps one IncrementalDownsampler per series, so the
+ * export is ready at any point of the mission in O(targetPoints) memory.
+ * write() emits CSV with one row per kept point:
+ * series,sol,value,minimum,maximum.
+ */
+class SeriesExport : public SOLObserver {
+ private:
+  IncrementalDownsampler temperature;
+  IncrementalDownsampler distance;
+
+ public:
+  /**
+   * @brief Constructs an empty export.
+   * @param targetPoints Number of points kept per series.
+   * @throw std::invalid_argument if targetPoints is below 3.
+   */
+  explicit SeriesExport(std::size_t targetPoints = DEFAULT_EXPORT_POINTS);
+
+  /**
+   * @brief Gets the downsampled temperature series.
+   * @return The kept temperature points.
+   */
+  std::vector<DownsampledPoint> getTemperatureSeries() const;
+
+  /**
+   * @brief Gets the downsampled distance series.
+   * @return The kept distance points.
+   */
+  std::vector<DownsampledPoint> getDistanceSeries() const;
+
+  /**
+   * @brief Writes both series as CSV.
+   * @param output The stream to write to.
+   */
+  void write(std::ostream& output) const;
+
+  /**
+   * @brief Callback method invoked when a SOL is finalized.
+   * @param solData The finalized SOL data.
+   */
+  void onSOLFinalized(const SOLData& solData) override;
+
+  /**
+   * @brief Exports archived SOLs in one batch, with one linear LTTB pass over
+   * each column.
+   * @param storage The archived mission data.
+   * @param targetPoints Number of points kept per series.
+   * @param output The stream to write the CSV to.
+   * @throw std::invalid_argument if targetPoints is below 3.
+   */
+  static void write(const DataStorage& storage, std::size_t targetPoints,
+                    std::ostream& output);
+};
+
+#endif  // SERIESEXPORT_H
@@ -35,6 +35,16 @@ class NavigationRecordStrategy : public RecordProcessingStrategy {
       const std::vector<std::pair<Measurement, Direction>>& measurements)
       : measurements(measurements) {}
 
+  /**
+   * @brief Applies the navigation record to subsystems of any type.
+   * @tparam NavigationT The navigation subsystem type.
+   * @param navigation The navigation subsystem.
+   */
+  template <typename NavigationT, typename TemperatureT, typename SampleAnalysisT>
+  void apply(NavigationT& navigation, TemperatureT&, SampleAnalysisT&) const {
+    navigation.addRecord(measurements);
+  }
+
   /**
    * @brief Processes the navigation record.
    * @param navigation The navigation subsystem.
@@ -44,8 +54,7 @@ class NavigationRecordStrategy : public RecordProcessingStrategy {
   void process(Navigation& navigation,
                Temperature& temperature,
                SampleAnalysis& sampleAnalysis) const override {
-    navigation.addRecord(measurements);
-    NavigationRecord finalRecord = navigation.getNavigationData();
+    apply(navigation, temperature, sampleAnalysis);
   }
 };
 
@@ -59,6 +68,16 @@ class TemperatureRecordStrategy : public RecordProcessingStrategy {
    */
   TemperatureRecordStrategy(const Measurement& temp) : temperature(temp) {}
 
+  /**
+   * @brief Applies the temperature record to subsystems of any type.
+   * @tparam TemperatureT The temperature subsystem type.
+   * @param temperature The temperature subsystem.
+   */
+  template <typename NavigationT, typename TemperatureT, typename SampleAnalysisT>
+  void apply(NavigationT&, TemperatureT& temperature, SampleAnalysisT&) const {
+    temperature.addTemperature(this->temperature);
+  }
+
   /**
    * @brief Processes the temperature record.
    * @param navigation The navigation subsystem.
@@ -68,7 +87,7 @@ class TemperatureRecordStrategy : public RecordProcessingStrategy {
   void process(Navigation& navigation,
                Temperature& temperature,
                SampleAnalysis& sampleAnalysis) const override {
-    temperature.addTemperature(this->temperature);
+    apply(navigation, temperature, sampleAnalysis);
   }
 };
 
@@ -90,6 +109,16 @@ class SampleAnalysisRecordStrategy : public RecordProcessingStrategy {
   SampleAnalysisRecordStrategy(const Measurement& wave, double intense)
       : wavelength(wave), intensity(intense) {}
 
+  /**
+   * @brief Applies the sample analysis record to subsystems of any type.
+   * @tparam SampleAnalysisT The sample analysis subsystem type.
+   * @param sampleAnalysis The sample analysis subsystem.
+   */
+  template <typename NavigationT, typename TemperatureT, typename SampleAnalysisT>
+  void apply(NavigationT&, TemperatureT&, SampleAnalysisT& sampleAnalysis) const {
+    sampleAnalysis.addRecord(wavelength, intensity);
+  }
+
   /**
    * @brief Processes the sample analysis record.
    * @param navigation The navigation subsystem.
@@ -99,7 +128,28 @@ class SampleAnalysisRecordStrategy : public RecordProcessingStrategy {
   void process(Navigation& navigation,
                Temperature& temperature,
                SampleAnalysis& sampleAnalysis) const override {
-    sampleAnalysis.addRecord(wavelength, intensity);
+    apply(navigation, temperature, sampleAnalysis);
   }
 };
+
+template <typename NavigationT, typename TemperatureT, typename SampleAnalysisT>
+void Records::apply(NavigationT& navigation, TemperatureT& temperature,
+                    SampleAnalysisT& sampleAnalysis) const {
+  // RecordFactory pairs every type with its strategy, so the casts are exact.
+  switch (type) {
+    case RecordType::Navigation:
+      static_cast<const NavigationRecordStrategy&>(*processingStrategy)
+          .apply(navigation, temperature, sampleAnalysis);
+      break;
+    case RecordType::Temperature:
+      static_cast<const TemperatureRecordStrategy&>(*processingStrategy)
+          .apply(navigation, temperature, sampleAnalysis);
+      break;
+    case RecordType::SampleAnalysis:
+      static_cast<const SampleAnalysisRecordStrategy&>(*processingStrategy)
+          .apply(navigation, temperature, sampleAnalysis);
+      break;
+  }
+}
+
 #endif  // RECORDPROCESSINGSTRATEGIES_H
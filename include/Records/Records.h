@@ -28,6 +28,18 @@ struct NavigationRecord {
   Direction finalDirection;
 };
 
+/**
+ * @struct NavigationState
+ * @brief In-flight navigation state of the current SOL, for checkpoints.
+ */
+struct NavigationState {
+  double x = 0.0;             /**< Position along the x-axis. */
+  double y = 0.0;             /**< Position along the y-axis. */
+  double angle = 0.0;         /**< Heading in degrees. */
+  double finalDistance = 0.0; /**< Distance from the origin so far. */
+  Direction finalDirection = Direction::Forward;
+};
+
 /**
  * @class RecordProcessingStrategy
  * @brief Interface for processing records.
@@ -62,7 +74,8 @@ class Records {
   /**
    * @brief Constructor for Records.
    * @param type The type of the record.
-   * @param strategy The processing strategy for the record.
+   * @param strategy The processing strategy for the record; an instance of
+   * the strategy class of type, as RecordFactory creates.
    */
   Records(RecordType type, std::unique_ptr<RecordProcessingStrategy> strategy)
       : type(type), processingStrategy(std::move(strategy)) {}
@@ -84,6 +97,19 @@ class Records {
                SampleAnalysis& sampleAnalysis) const {
     processingStrategy->process(navigation, temperature, sampleAnalysis);
   }
+
+  /**
+   * @brief Processes the record without virtual dispatch, on subsystems of
+   * any type that provide the methods the standard subsystems do.
+   *
+   * Defined in RecordProcessingStrategies.h.
+   * @param navigation The navigation subsystem.
+   * @param temperature The temperature subsystem.
+   * @param sampleAnalysis The sample analysis subsystem.
+   */
+  template <typename NavigationT, typename TemperatureT, typename SampleAnalysisT>
+  void apply(NavigationT& navigation, TemperatureT& temperature,
+             SampleAnalysisT& sampleAnalysis) const;
 };
 
 /**
@@ -0,0 +1,159 @@
+/**
+ * @file ClassificationCache.h
+ * @brief Declaration of the ClassificationCache class.
+ *
+ * The ClassificationCache memoizes sample classification results keyed on the
+ * exact (wavelength, intensity) pair. Downlinked samples repeat heavily, so
+ * a hit skips the walk over the element library entirely.
+ */
+#ifndef CLASSIFICATIONCACHE_H
+#define CLASSIFICATIONCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Default number of entries in a ClassificationCache.
+ */
+const std::size_t DEFAULT_CLASSIFICATION_CACHE_CAPACITY = 4096;
+
+/**
+ * @brief Default number of mantissa bits kept when hashing cache keys.
+ * Quantization only chooses the home bucket; entries match on the exact
+ * values, since the classifier's intensity thresholds and inclusive band
+ * edges can separate readings that agree to any number of bits.
+ */
+const int DEFAULT_CLASSIFICATION_CACHE_MANTISSA_BITS = 20;
+
+/**
+ * @class ClassificationCache
+ * @brief Fixed-size, cache-line-aligned, open-addressing classification cache.
+ *
+ * Entries are grouped two to a 64-byte bucket. A lookup probes the home bucket
+ * and its neighbour, so it touches at most two cache lines. The table never
+ * grows; when both buckets are full the home bucket evicts one entry. The whole
+ * cache is invalidated in O(1) by bumping a generation counter, which happens
+ * automatically when the element library version changes.
+ */
+class ClassificationCache {
+ public:
+  /**
+   * @struct CacheStatistics
+   * @brief Hit-rate statistics of the cache.
+   */
+  struct CacheStatistics {
+    std::uint64_t hits = 0;          /**< Lookups answered from the cache. */
+    std::uint64_t misses = 0;        /**< Lookups that fell through. */
+    std::uint64_t evictions = 0;     /**< Live entries replaced on insert. */
+    std::uint64_t invalidations = 0; /**< Times the cache was cleared. */
+
+    /**
+     * @brief Calculates the fraction of lookups answered from the cache.
+     * @return The hit rate in [0, 1], or 0 if no lookups were made.
+     */
+    double hitRate() const;
+  };
+
+  /**
+   * @brief Constructs an empty cache.
+   * @param capacity Minimum number of entries; rounded up to a power of two.
+   * @param mantissaBits Mantissa bits kept when hashing keys, in [1, 20].
+   * @throw std::invalid_argument if mantissaBits is out of range.
+   */
+  explicit ClassificationCache(
+      std::size_t capacity = DEFAULT_CLASSIFICATION_CACHE_CAPACITY,
+      int mantissaBits = DEFAULT_CLASSIFICATION_CACHE_MANTISSA_BITS);
+
+  /**
+   * @brief Looks up a cached classification.
+   * @param wavelength The wavelength of the sample.
+   * @param intensity The intensity of the sample.
+   * @param elementId Receives the cached element ID on a hit.
+   * @return True on a hit, false on a miss.
+   */
+  bool lookup(double wavelength, double intensity, int& elementId);
+
+  /**
+   * @brief Stores a classification result.
+   * @param wavelength The wavelength of the sample.
+   * @param intensity The intensity of the sample.
+   * @param elementId The element ID returned by the classifier.
+   */
+  void insert(double wavelength, double intensity, int elementId);
+
+  /**
+   * @brief Records the element library version the cached results belong to.
+   * Invalidates the cache if the version differs from the current one.
+   * @param version The element library version.
+   */
+  void setLibraryVersion(unsigned int version);
+
+  /**
+   * @brief Discards every cached entry.
+   */
+  void invalidate();
+
+  /**
+   * @brief Gets the hit-rate statistics.
+   * @return The cache statistics.
+   */
+  const CacheStatistics& getStatistics() const;
+
+  /**
+   * @brief Gets the number of entries the cache can hold.
+   * @return The cache capacity.
+   */
+  std::size_t getCapacity() const;
+
+ private:
+  /** @brief One cached classification; 24 bytes, two per cache line. */
+  struct Slot {
+    std::uint64_t wavelengthBits; /**< Exact bit pattern of the wavelength. */
+    std::uint64_t intensityBits;  /**< Exact bit pattern of the intensity. */
+    std::uint32_t generation; /**< 0 or stale means the slot is empty. */
+    std::int32_t elementId;
+  };
+
+  /** @brief Number of slots sharing one cache line. */
+  static const int SLOTS_PER_BUCKET = 2;
+
+  /** @brief A cache line worth of slots. */
+  struct alignas(64) Bucket {
+    Slot slots[SLOTS_PER_BUCKET];
+  };
+
+  std::unique_ptr<unsigned char[]> storage; /**< Raw, over-allocated memory. */
+  Bucket* buckets;                          /**< Aligned view into storage. */
+  std::size_t bucketMask;
+  int mantissaShift;
+  std::uint32_t generation;
+  unsigned int libraryVersion;
+  CacheStatistics statistics;
+
+  /**
+   * @brief Gets the bit pattern of a value.
+   * @param value The value.
+   * @return The bits of value.
+   */
+  static std::uint64_t bitsOf(double value);
+
+  /**
+   * @brief Quantizes a value's bits by keeping its sign, exponent and top
+   * mantissa bits.
+   * @param bits The bit pattern to quantize.
+   * @return The quantized key.
+   */
+  std::uint32_t quantize(std::uint64_t bits) const;
+
+  /**
+   * @brief Computes the home bucket for a key pair from its quantized bits.
+   * @param wavelengthBits The bits of the wavelength.
+   * @param intensityBits The bits of the intensity.
+   * @return The home bucket index.
+   */
+  std::size_t homeBucket(std::uint64_t wavelengthBits,
+                         std::uint64_t intensityBits) const;
+};
+
+#endif  // CLASSIFICATIONCACHE_H
@@ -14,6 +14,7 @@
 #include "Utility/Units.h"
 #include "Utility/Measurement.h"
 #include "Records/Records.h"
+
 /**
  * @class Position
  * @brief Represents the robot's position in a 2D coordinate system.
@@ -25,6 +26,27 @@ class Position {
   double y =
       0;  ///> Default y-coordinate is 0 (Origin A.K.A. Rover Landing Site)
  public:
+  Position() = default;
+
+  /**
+   * @brief Constructs a position at given coordinates.
+   * @param x The x-coordinate.
+   * @param y The y-coordinate.
+   */
+  Position(double x, double y);
+
+  /**
+   * @brief Gets the x-coordinate.
+   * @return The x-coordinate.
+   */
+  double getX() const;
+
+  /**
+   * @brief Gets the y-coordinate.
+   * @return The y-coordinate.
+   */
+  double getY() const;
+
   /**
    * @brief Updates the position based on a movement.
    * Forward (+) and Backward (-) are along the y-axis.
@@ -62,6 +84,14 @@ class DirectionManager {
   double currentAngle = 0;
 
  public:
+  DirectionManager() = default;
+
+  /**
+   * @brief Constructs a manager facing a given angle.
+   * @param angle The heading in degrees, in [0, 360).
+   */
+  explicit DirectionManager(double angle);
+
   /**
    * @brief Rotates the robot in a given direction.
    * @param direction The direction to rotate (left or right).
@@ -121,6 +151,18 @@ class Navigation {
    */
   void reset();
 
+  /**
+   * @brief Captures the in-flight state of the current SOL.
+   * @return The navigation state.
+   */
+  NavigationState getState() const;
+
+  /**
+   * @brief Restores state captured by getState().
+   * @param state The navigation state.
+   */
+  void restoreState(const NavigationState& state);
+
 
   /**
    * @brief Gets the final distance traveled.
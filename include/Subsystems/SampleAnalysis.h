@@ -9,8 +9,19 @@
 #ifndef SAMPLEANALYSIS_H
 #define SAMPLEANALYSIS_H
 
+#include "Subsystems/ClassificationCache.h"
 #include "Subsystems/SampleClassification.h"
 #include "Utility/Measurement.h"
+/**
+ * @struct SampleReading
+ * @brief Raw spectrometer reading of a SOL's sample in base units.
+ */
+struct SampleReading {
+  double wavelength = 0.0; /**< The wavelength in meters. */
+  double intensity = 0.0;  /**< The relative intensity. */
+  bool collected = false;  /**< Whether a sample was taken this SOL. */
+};
+
 /**
  * @class SampleAnalysis
  * @brief Manages sample analysis records and classifications.
@@ -18,8 +29,11 @@
 class SampleAnalysis {
  private:
   std::pair<Measurement, double> sample; /**< The samples collected. */
+  bool sampleCollected = false; /**< Whether a record was added. */
   SampleClassification
       classification; /**< The classifications of the samples. */
+  std::unique_ptr<ClassificationCache>
+      classificationCache; /**< Optional memoized classifications. */
 
  public:
   /**
@@ -46,10 +60,37 @@ class SampleAnalysis {
    */
   SampleClassification getSampleClassification() const;
 
+  /**
+   * @brief Retrieves the raw reading of the collected sample.
+   * @return The sample reading; collected is false if no record was added.
+   */
+  SampleReading getSampleReading() const;
+
+  /**
+   * @brief Places a classification cache in front of the classifier.
+   * The cache survives reset() so repeated samples hit across SOLs.
+   * @param capacity The number of entries the cache should hold.
+   */
+  void enableClassificationCache(
+      std::size_t capacity = DEFAULT_CLASSIFICATION_CACHE_CAPACITY);
+
+  /**
+   * @brief Retrieves the classification cache, if enabled.
+   * @return Pointer to the cache, or nullptr if caching is disabled.
+   */
+  const ClassificationCache* getClassificationCache() const;
+
   /**
    * @brief Resets the sample analysis data.
    */
   void reset();
+
+  /**
+   * @brief Restores the sample of the current SOL from a checkpoint.
+   * @param reading The reading returned by getSampleReading().
+   * @param elementId The element ID of getSampleClassification().
+   */
+  void restoreSample(const SampleReading& reading, int elementId);
 };
 
 #endif  // SAMPLEANALYSIS_H
\ No newline at end of file
@@ -11,9 +11,32 @@
 
 #include <string>
 #include <vector>
+
+/**
+ * @brief Version of the built-in element library.
+ * Bump whenever the element or intensity tables change so that any cached
+ * classification results are discarded.
+ */
+const unsigned int ELEMENT_LIBRARY_VERSION = 1;
+
+/**
+ * @brief Element ID reported when a sample qualified for an intensity level but
+ * matched no element band.
+ */
+const int UNKNOWN_ELEMENT_ID = -1;
+
+/**
+ * @brief Element ID reported when a sample qualified for no intensity level at
+ * all, leaving the previous classification untouched.
+ */
+const int UNCLASSIFIED_ELEMENT_ID = -2;
+
 /**
  * @class SampleClassification
  * @brief Classifies the sample based on the intensity and wavelength.
+ *
+ * The element library and intensity tables are shared by every instance, so
+ * a classification is just an element ID and is cheap to copy and store.
  */
 class SampleClassification {
  public:
@@ -39,12 +62,31 @@ class SampleClassification {
   };
 
  private:
-  std::string classification;
-  std::vector<Element> elementLibrary;
-  std::vector<IntensityRanges> intensityRanges;
+  int elementId; /**< Classified element ID; see getClassifiedElement(). */
 
  public:
-  SampleClassification();
+  /**
+   * @brief Constructs a classification.
+   * @param elementId An element library index, UNKNOWN_ELEMENT_ID or
+   * UNCLASSIFIED_ELEMENT_ID for a sample that was never classified.
+   */
+  explicit SampleClassification(int elementId = UNCLASSIFIED_ELEMENT_ID);
+  /**
+   * @brief Gets the shared element library, built once.
+   * @return The element library.
+   */
+  static const std::vector<Element>& getElementLibrary();
+  /**
+   * @brief Gets the shared intensity ranges, built once.
+   * @return The intensity ranges.
+   */
+  static const std::vector<IntensityRanges>& getIntensityRanges();
+  /**
+   * @brief Gets the name reported for an element ID.
+   * @param elementId An element ID as returned by getElementId().
+   * @return The element name, "Unknown", or empty if unclassified.
+   */
+  static const std::string& getElementName(int elementId);
   /**
    * @brief Initializes the intensity ranges for elements.
    * @return A vector of IntensityRanges.
@@ -61,11 +103,35 @@ class SampleClassification {
    * @param intensity The intensity of the sample.
    */
   void classify(double wavelength, double intensity);
+  /**
+   * @brief Matches a sample against the library without changing state.
+   * @param wavelength The wavelength of the sample.
+   * @param intensity The intensity of the sample.
+   * @return The index of the matched element in the element library,
+   * UNKNOWN_ELEMENT_ID or UNCLASSIFIED_ELEMENT_ID.
+   */
+  int matchElement(double wavelength, double intensity) const;
+  /**
+   * @brief Applies the result of matchElement() to this classification.
+   * @param elementId The element ID returned by matchElement().
+   */
+  void applyElementMatch(int elementId);
+  /**
+   * @brief Retrieves the version of the element library in use.
+   * @return The element library version.
+   */
+  unsigned int getLibraryVersion() const;
   /**
    * @brief Retrieves the classified element.
    * @return A string representing the classified element.
    */
   const std::string& getClassifiedElement() const;
+  /**
+   * @brief Retrieves the classified element ID.
+   * @return The element library index, UNKNOWN_ELEMENT_ID or
+   * UNCLASSIFIED_ELEMENT_ID.
+   */
+  int getElementId() const;
 
   SampleClassification getSampleClassification() const;
 };
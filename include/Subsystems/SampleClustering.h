@@ -0,0 +1,98 @@
+/**
+ * @file SampleClustering.h
+ * @brief Declaration of the SampleClustering class.
+ *
+ * The SampleClustering class groups samples the fixed-band classifier could
+ * not identify by the similarity of their (wavelength, intensity) readings
+ * across the whole mission, using mini-batch k-means.
+ */
+#ifndef SAMPLECLUSTERING_H
+#define SAMPLECLUSTERING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Subsystems/SampleAnalysis.h"
+
+class DataStorage;
+
+/**
+ * @struct ClusteringOptions
+ * @brief Tuning parameters for mini-batch k-means.
+ */
+struct ClusteringOptions {
+  std::size_t clusterCount = 8;  /**< Number of clusters (k). */
+  std::size_t batchSize = 4096;  /**< Samples drawn per mini-batch. */
+  std::size_t iterations = 100;  /**< Number of mini-batch updates. */
+  unsigned int threadCount = 0;  /**< Worker threads; 0 uses all cores. */
+  std::uint64_t seed = 1;        /**< Seed for initialization and batches. */
+  bool unknownOnly = true;       /**< Only cluster unclassified samples. */
+};
+
+/**
+ * @struct SampleCluster
+ * @brief A cluster centroid in base units and the number of member samples.
+ */
+struct SampleCluster {
+  double wavelength;
+  double intensity;
+  std::size_t size;
+};
+
+/**
+ * @struct ClusterAssignment
+ * @brief The cluster a SOL's sample was assigned to.
+ */
+struct ClusterAssignment {
+  int solNumber;
+  int cluster;
+};
+
+/**
+ * @struct ClusteringResult
+ * @brief Output of a clustering run.
+ */
+struct ClusteringResult {
+  std::vector<SampleCluster> clusters;
+  std::vector<ClusterAssignment> assignments;
+  double inertia = 0.0; /**< Sum of squared normalized distances. */
+};
+
+/**
+ * @class SampleClustering
+ * @brief Clusters sample spectra with multithreaded mini-batch k-means.
+ *
+ * Readings are z-score normalized per dimension and stored as float columns.
+ * Nearest-centroid assignment runs four samples at a time with SSE2 where
+ * available and is split across worker threads.
+ */
+class SampleClustering {
+ private:
+  ClusteringOptions options;
+
+ public:
+  /**
+   * @brief Constructs a clustering stage.
+   * @param options The clustering parameters.
+   */
+  explicit SampleClustering(const ClusteringOptions& options = ClusteringOptions());
+
+  /**
+   * @brief Clusters the samples of every SOL held by a data storage.
+   * @param storage The storage to read SOL data from.
+   * @return The clusters and the per-SOL assignments.
+   */
+  ClusteringResult clusterSamples(const DataStorage& storage) const;
+
+  /**
+   * @brief Clusters a set of sample readings.
+   * @param solNumbers The SOL number of each reading.
+   * @param readings The readings to cluster; must match solNumbers in size.
+   * @return The clusters and the per-SOL assignments.
+   * @throw std::invalid_argument if the input sizes differ.
+   */
+  ClusteringResult clusterReadings(const std::vector<int>& solNumbers,
+                                   const std::vector<SampleReading>& readings) const;
+};
+
+#endif  // SAMPLECLUSTERING_H
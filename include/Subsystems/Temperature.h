@@ -11,6 +11,9 @@
 
 #include "Records/Records.h"
 #include "Data/SOLData.h"
+#include "Temperature/MomentAccumulator.h"
+#include "Temperature/QuantileSketch.h"
+#include "Temperature/TemperatureAggregate.h"
 
 /**
  * @class Statistics
@@ -20,18 +23,52 @@ class Statistics {
 public:
     /**
      * @brief Calculates the mean of a dataset.
+     *
+     * Large datasets are summed with the vectorized ReductionKernels, whose
+     * result may differ from a sequential sum within its documented tolerance.
      * @param data Vector of temperature readings.
      * @return The mean temperature.
      */
     static double calculateMean(const std::vector<double>& data);
 
     /**
-     * @brief Calculates the median of a dataset.
+     * @brief Calculates mergeable moments of a dataset, e.g. for one shard.
+     * @param data Vector of temperature readings.
+     * @return The moment accumulator.
+     */
+    static MomentAccumulator calculateMoments(const std::vector<double>& data);
+
+    /**
+     * @brief Summarizes a dataset in a mergeable quantile sketch, e.g. for one
+     * shard.
+     * @param data Vector of temperature readings.
+     * @param compression Compression of the sketch.
+     * @return The quantile sketch.
+     */
+    static QuantileSketch buildQuantileSketch(
+        const std::vector<double>& data,
+        double compression = DEFAULT_SKETCH_COMPRESSION);
+
+    /**
+     * @brief Calculates the median of a dataset by the same selection as
+     * calculatePercentile(), in O(n) on a single working copy.
      * @param data Vector of temperature readings.
      * @return The median temperature.
      */
     static double calculateMedian(const std::vector<double>& data);
 
+    /**
+     * @brief Calculates an exact percentile of a dataset by selection.
+     * Interpolates linearly between the two closest ranks, so the 50th
+     * percentile equals the median. Runs in O(n) on a single working copy.
+     * @param data Vector of temperature readings.
+     * @param percentile The percentile to compute, in [0, 100].
+     * @return The percentile value, or 0 if the dataset is empty.
+     * @throw std::invalid_argument if percentile is outside [0, 100].
+     */
+    static double calculatePercentile(const std::vector<double>& data,
+                                      double percentile);
+
     /**
      * @brief Finds the N largest values in a dataset.
      * @param data Vector of temperature readings.
@@ -51,16 +88,22 @@ public:
                                      const int n);
 
     /**
-     * @brief Finds the lowest temperature in the two summers.
+     * @brief Finds the lowest temperature of any northern summer.
+     * Reading i is taken to be SOL INITIAL_SOL + i of a mission starting at
+     * Ls 0; see SeasonModel.
      * @param data Vector of temperature readings.
-     * @return The lowest temperature in the two summers.
+     * @return The lowest summer temperature, or infinity if no reading
+     * falls in a summer.
      */
     static double calculateLowestSummerTemperature(const std::vector<double>& data);
 
     /**
-     * @brief Finds the highest temperature in the two winters.
+     * @brief Finds the lowest temperature of any northern winter.
+     * Reading i is taken to be SOL INITIAL_SOL + i of a mission starting at
+     * Ls 0; see SeasonModel.
      * @param data Vector of temperature readings.
-     * @return The highest temperature in the two winters.
+     * @return The lowest winter temperature, or infinity if no reading
+     * falls in a winter.
      */
     static double calculateLowestWinterTemperature(const std::vector<double>& data);
 };
@@ -68,10 +111,17 @@ public:
 /**
  * @class Temperature
  * @brief Manages temperature data and calculations for a SOL.
+ *
+ * Every reading of the current SOL is folded into a TemperatureAggregate, so
+ * any number of readings per SOL costs constant memory. The aggregate only
+ * spans several readings when the caller finalizes SOLs less often than it
+ * adds readings: the mission ingest in main, MissionControl's tests and
+ * ingestRecords() finalize a SOL after every 't' record, so there each
+ * aggregate holds one reading, with minimum, maximum, mean and last equal.
  */
 class Temperature {
 private:
-    double SOLTemperature; /**< The temperatures collected. */
+    TemperatureAggregate SOLTemperature; /**< The temperatures collected. */
 public:
     /**
      * @brief Adds a new temperature reading.
@@ -81,14 +131,26 @@ public:
 
     /**
      * @brief Retrieves the temperature data.
-     * @return The temperature data.
+     * @return The most recent reading, or 0 if there is none.
      */
     double getTemperatureData() const;
 
+    /**
+     * @brief Retrieves the aggregate of every reading of the current SOL.
+     * @return The temperature aggregate.
+     */
+    const TemperatureAggregate& getTemperatureAggregate() const;
+
     /**
      * @brief Resets all temperature data.
      */
     void reset();
+
+    /**
+     * @brief Restores the readings of the current SOL from a checkpoint.
+     * @param aggregate The aggregate returned by getTemperatureAggregate().
+     */
+    void restoreTemperatureAggregate(const TemperatureAggregate& aggregate);
 };
 
 #endif  // TEMPERATURE_H
\ No newline at end of file
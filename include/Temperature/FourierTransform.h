@@ -0,0 +1,80 @@
+/**
+ * @file FourierTransform.h
+ * @brief Declaration of the FourierTransform class.
+ *
+ * The FourierTransform class computes discrete Fourier transforms of any
+ * length, reusing its twiddle tables and work buffers across calls.
+ */
+#ifndef FOURIERTRANSFORM_H
+#define FOURIERTRANSFORM_H
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class FourierTransform
+ * @brief In-tree radix-2 FFT with Bluestein's algorithm for other lengths.
+ *
+ * Power-of-two lengths use an iterative radix-2 transform. Any other length n
+ * is rewritten as a circular convolution of power-of-two length m >= 2n - 1
+ * (Bluestein's chirp z-transform), which costs three radix-2 transforms. The
+ * tables for the most recent length are cached, so repeated transforms of the
+ * same length do not allocate. Real input of even length is transformed at
+ * half length.
+ */
+class FourierTransform {
+ private:
+  std::size_t size;       /**< Length the tables are prepared for. */
+  std::size_t paddedSize; /**< Radix-2 length; equals size for powers of two. */
+  std::vector<std::complex<double>> twiddles;      /**< paddedSize / 2 roots. */
+  std::vector<std::size_t> bitReversal;            /**< Radix-2 permutation. */
+  std::vector<std::complex<double>> chirp;         /**< Bluestein chirp. */
+  std::vector<std::complex<double>> chirpSpectrum; /**< FFT of the filter. */
+  std::vector<std::complex<double>> work;          /**< Convolution buffer. */
+  std::vector<std::complex<double>> packed;        /**< Real-input packing. */
+  std::vector<std::complex<double>> realTwiddles;  /**< Real-input unpacking. */
+
+  /**
+   * @brief Runs the forward radix-2 transform of paddedSize points in place.
+   * @param data The data to transform.
+   */
+  void radix2(std::complex<double>* data) const;
+
+ public:
+  /**
+   * @brief Constructs a transform with no prepared length.
+   */
+  FourierTransform();
+
+  /**
+   * @brief Builds the tables for a length, if it differs from the current one.
+   * @param length The transform length.
+   */
+  void prepare(std::size_t length);
+
+  /**
+   * @brief Computes the forward DFT in place, X_k = sum x_j e^{-2 pi i jk/n}.
+   * @param data The data to transform; its size is the transform length.
+   */
+  void forward(std::vector<std::complex<double>>& data);
+
+  /**
+   * @brief Computes the non-negative frequency half of the DFT of real input.
+   *
+   * Even lengths are packed into a complex transform of half the length,
+   * roughly halving the cost.
+   * @param input The real samples.
+   * @param output Receives bins 0 to input.size() / 2.
+   */
+  void forwardReal(const std::vector<double>& input,
+                   std::vector<std::complex<double>>& output);
+
+  /**
+   * @brief Gets the length the tables are prepared for.
+   * @return The prepared length, or 0 if none.
+   */
+  std::size_t getSize() const;
+};
+
+#endif  // FOURIERTRANSFORM_H
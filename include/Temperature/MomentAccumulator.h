@@ -0,0 +1,47 @@
+/**
+ * @file MomentAccumulator.h
+ * @brief Declaration of the MomentAccumulator struct.
+ *
+ * The MomentAccumulator struct keeps count, mean, variance and range of a
+ * temperature stream in a form that shards can combine.
+ */
+#ifndef MOMENTACCUMULATOR_H
+#define MOMENTACCUMULATOR_H
+
+#include <cstddef>
+
+/**
+ * @struct MomentAccumulator
+ * @brief Mergeable Welford accumulator of the first two moments.
+ *
+ * add() is Welford's update; merge() is Chan et al.'s pairwise combination,
+ * so accumulators built on separate shards combine associatively and match a
+ * single pass over all values up to rounding.
+ */
+struct MomentAccumulator {
+  std::size_t count = 0;
+  double mean = 0.0;
+  double m2 = 0.0;      /**< Sum of squared deviations from the mean. */
+  double minimum = 0.0; /**< Lowest value; 0 if empty. */
+  double maximum = 0.0; /**< Highest value; 0 if empty. */
+
+  /**
+   * @brief Adds a value.
+   * @param value The value to add.
+   */
+  void add(double value);
+
+  /**
+   * @brief Folds another accumulator into this one.
+   * @param other The accumulator to merge.
+   */
+  void merge(const MomentAccumulator& other);
+
+  /**
+   * @brief Calculates the population variance.
+   * @return The variance, or 0 if empty.
+   */
+  double variance() const;
+};
+
+#endif  // MOMENTACCUMULATOR_H
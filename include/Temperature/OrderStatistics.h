@@ -0,0 +1,92 @@
+/**
+ * @file OrderStatistics.h
+ * @brief Declaration of the OrderStatistics class.
+ *
+ * The OrderStatistics class maintains temperature readings incrementally so
+ * that any rank or percentile can be queried as SOLs are appended, without
+ * sorting the whole series.
+ */
+#ifndef ORDERSTATISTICS_H
+#define ORDERSTATISTICS_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class OrderStatistics
+ * @brief Incremental order-statistic structure over quantized buckets.
+ *
+ * Values are distributed into equal-width buckets over [lowerBound,
+ * upperBound); values outside the range land in the edge buckets. A Fenwick
+ * tree over the bucket counts locates the bucket holding any rank in
+ * O(log B), and each bucket keeps its own values sorted, so answers are exact.
+ * Insertion costs O(log B) plus the size of the target bucket.
+ *
+ * Unlike QuantileSketch, answers stay exact however many values are
+ * inserted, at the cost of keeping every value; use it when a long mission
+ * needs exact percentiles rather than mergeable, bounded-memory ones.
+ */
+class OrderStatistics {
+ private:
+  double lowerBound;
+  double bucketWidth;
+  std::size_t count;
+  std::size_t topStep; /**< Largest power of two not above the bucket count. */
+  std::vector<std::size_t> tree;             /**< 1-based Fenwick tree. */
+  std::vector<std::vector<double>> buckets;  /**< Sorted values per bucket. */
+
+  /**
+   * @brief Maps a value to its bucket.
+   * @param value The value to map.
+   * @return The bucket index.
+   */
+  std::size_t bucketFor(double value) const;
+
+ public:
+  /**
+   * @brief Constructs an empty structure.
+   * @param lowerBound Lower edge of the bucketed range.
+   * @param upperBound Upper edge of the bucketed range.
+   * @param bucketCount Number of buckets.
+   * @throw std::invalid_argument if the range is empty or bucketCount is 0.
+   */
+  OrderStatistics(double lowerBound = -100.0, double upperBound = 400.0,
+                  std::size_t bucketCount = 2048);
+
+  /**
+   * @brief Inserts a value.
+   * @param value The value to insert.
+   */
+  void insert(double value);
+
+  /**
+   * @brief Gets the number of inserted values.
+   * @return The number of values.
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Selects the value of a given rank.
+   * @param rank The zero-based rank; 0 is the smallest value.
+   * @return The value at that rank.
+   * @throw std::out_of_range if rank is not below size().
+   */
+  double select(std::size_t rank) const;
+
+  /**
+   * @brief Calculates a percentile, interpolating like
+   * Statistics::calculatePercentile.
+   * @param percentile The percentile to compute, in [0, 100].
+   * @return The percentile value, or 0 if empty.
+   * @throw std::invalid_argument if percentile is outside [0, 100].
+   */
+  double percentile(double percentile) const;
+
+  /**
+   * @brief Calculates the median, matching Statistics::calculateMedian.
+   * @return The median, or 0 if empty.
+   */
+  double median() const;
+};
+
+#endif  // ORDERSTATISTICS_H
@@ -0,0 +1,129 @@
+/**
+ * @file QuantileSketch.h
+ * @brief Declaration of the QuantileSketch class.
+ *
+ * The QuantileSketch class summarizes a temperature stream in bounded memory
+ * so that percentiles can be computed from shards that are built separately
+ * and merged afterwards.
+ */
+#ifndef QUANTILESKETCH_H
+#define QUANTILESKETCH_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Default t-digest compression; see QuantileSketch for the error bound.
+ */
+const double DEFAULT_SKETCH_COMPRESSION = 200.0;
+
+/**
+ * @brief Default number of values a sketch keeps exactly before compressing.
+ */
+const std::size_t DEFAULT_SKETCH_EXACT_LIMIT = 4096;
+
+/**
+ * @class QuantileSketch
+ * @brief Mergeable t-digest with an exact mode for small inputs.
+ *
+ * Up to exactLimit values are kept verbatim, and percentiles then match
+ * Statistics::calculatePercentile exactly. Beyond that the values are
+ * compressed into a merging t-digest with the k1 (arcsine) scale function.
+ * It holds at most about compression centroids plus a buffer of
+ * 5 * compression pending values. A centroid near quantile q covers at most
+ * 2 * pi * sqrt(q(1-q)) / compression of the data, so a percentile's rank
+ * error is at most about half of that. Tails are the most accurate and the
+ * minimum and maximum are exact.
+ *
+ * merge() is associative up to the grouping of centroids, so shards, rovers
+ * or missions can be summarized independently and combined in any order.
+ * Queries fold pending values into the digest first, so const queries are
+ * not safe to run concurrently on the same sketch.
+ */
+class QuantileSketch {
+ private:
+  /** @brief A cluster of values summarized by its mean and weight. */
+  struct Centroid {
+    double mean;
+    double weight;
+  };
+
+  double compression;
+  std::size_t exactLimit;
+  std::size_t count;
+  double minimum;
+  double maximum;
+  bool exact;                              /**< Still holding raw values. */
+  mutable std::vector<Centroid> centroids; /**< Sorted digest. */
+  mutable std::vector<Centroid> pending;   /**< Values not yet compressed. */
+  mutable std::vector<Centroid> merged;    /**< Scratch for compress(). */
+
+  /**
+   * @brief Folds the pending values into the digest, or sorts them in exact
+   * mode.
+   */
+  void flush() const;
+
+  /**
+   * @brief Leaves exact mode, compressing every raw value into centroids.
+   */
+  void leaveExactMode();
+
+ public:
+  /**
+   * @brief Constructs an empty sketch.
+   * @param compression Controls accuracy and size; larger is more accurate.
+   * @param exactLimit Number of values kept exactly before compressing.
+   * @throw std::invalid_argument if compression is below 10.
+   */
+  explicit QuantileSketch(double compression = DEFAULT_SKETCH_COMPRESSION,
+                          std::size_t exactLimit = DEFAULT_SKETCH_EXACT_LIMIT);
+
+  /**
+   * @brief Adds a value.
+   * @param value The value to add.
+   */
+  void insert(double value);
+
+  /**
+   * @brief Folds another sketch into this one.
+   * @param other The sketch to merge; its settings need not match.
+   */
+  void merge(const QuantileSketch& other);
+
+  /**
+   * @brief Gets the number of values summarized.
+   * @return The number of values.
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Checks whether percentiles are still exact.
+   * @return True while no more than exactLimit values have been summarized.
+   */
+  bool isExact() const;
+
+  /**
+   * @brief Gets the number of centroids or exact values held.
+   * @return The memory footprint in entries.
+   */
+  std::size_t getFootprint() const;
+
+  /**
+   * @brief Calculates a percentile, interpolating like
+   * Statistics::calculatePercentile in exact mode.
+   * @param percentile The percentile to compute, in [0, 100].
+   * @return The percentile value, or 0 if empty.
+   * @throw std::invalid_argument if percentile is outside [0, 100].
+   */
+  double percentile(double percentile) const;
+
+  /**
+   * @brief Calculates the median, matching Statistics::calculateMedian in
+   * exact mode.
+   * @return The median, or 0 if empty.
+   */
+  double median() const;
+};
+
+#endif  // QUANTILESKETCH_H
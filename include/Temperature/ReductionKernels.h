@@ -0,0 +1,114 @@
+/**
+ * @file ReductionKernels.h
+ * @brief Declaration of the ReductionKernels class.
+ *
+ * The ReductionKernels class provides vectorized sum, sum of squares, min, max
+ * and fused min/max/sum reductions over contiguous temperature data. The best
+ * instruction set supported by the running CPU is chosen once at runtime.
+ */
+#ifndef REDUCTIONKERNELS_H
+#define REDUCTIONKERNELS_H
+
+#include <cstddef>
+
+/**
+ * @struct MinMaxSum
+ * @brief Result of a fused min/max/sum reduction.
+ */
+struct MinMaxSum {
+  double minimum; /**< +infinity for empty input. */
+  double maximum; /**< -infinity for empty input. */
+  double sum;
+};
+
+/**
+ * @class ReductionKernels
+ * @brief Runtime-dispatched SIMD reductions over arrays of doubles.
+ *
+ * Every kernel runs several independent accumulators so consecutive additions
+ * do not wait on each other. The AVX2 path keeps four 256-bit accumulators
+ * (16 doubles per iteration), the SSE2 path four 128-bit accumulators and the
+ * scalar fallback four scalar ones.
+ *
+ * Tolerance: min and max are exact and match std::min_element and
+ * std::max_element for NaN-free input. Sums are reassociated, so they may
+ * differ from a left-to-right std::accumulate by at most
+ * SUM_TOLERANCE_FACTOR * n * DBL_EPSILON * sum(|x|) (use x*x for sums of
+ * squares). That is the standard floating-point summation error bound,
+ * doubled because both the kernel and the reference carry error.
+ */
+class ReductionKernels {
+ public:
+  /**
+   * @enum InstructionSet
+   * @brief Kernel implementations, from slowest to fastest.
+   */
+  enum class InstructionSet { Scalar, SSE2, AVX2 };
+
+  /**
+   * @brief Factor of the documented summation tolerance.
+   */
+  static const int SUM_TOLERANCE_FACTOR = 2;
+
+  /**
+   * @brief Sums an array.
+   * @param data Pointer to the first element.
+   * @param size Number of elements.
+   * @return The sum, or 0 for empty input.
+   */
+  static double sum(const double* data, std::size_t size);
+
+  /**
+   * @brief Sums the squares of an array.
+   * @param data Pointer to the first element.
+   * @param size Number of elements.
+   * @return The sum of squares, or 0 for empty input.
+   */
+  static double sumOfSquares(const double* data, std::size_t size);
+
+  /**
+   * @brief Finds the smallest element of an array.
+   * @param data Pointer to the first element.
+   * @param size Number of elements.
+   * @return The minimum, or +infinity for empty input.
+   */
+  static double minimum(const double* data, std::size_t size);
+
+  /**
+   * @brief Finds the largest element of an array.
+   * @param data Pointer to the first element.
+   * @param size Number of elements.
+   * @return The maximum, or -infinity for empty input.
+   */
+  static double maximum(const double* data, std::size_t size);
+
+  /**
+   * @brief Computes min, max and sum in a single pass.
+   * @param data Pointer to the first element.
+   * @param size Number of elements.
+   * @return The fused reduction.
+   */
+  static MinMaxSum minMaxSum(const double* data, std::size_t size);
+
+  /**
+   * @brief Gets the instruction set the kernels currently use.
+   * @return The active instruction set.
+   */
+  static InstructionSet getInstructionSet();
+
+  /**
+   * @brief Checks whether the running CPU supports an instruction set.
+   * @param instructionSet The instruction set to check.
+   * @return True if kernels for it can run here.
+   */
+  static bool isSupported(InstructionSet instructionSet);
+
+  /**
+   * @brief Selects the kernels to use, e.g. to compare paths in tests.
+   * @param instructionSet The instruction set to use.
+   * @throw std::invalid_argument if the CPU does not support it.
+   */
+  static void setInstructionSet(InstructionSet instructionSet);
+};
+
+#endif  // REDUCTIONKERNELS_H
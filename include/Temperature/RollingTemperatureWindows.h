@@ -0,0 +1,118 @@
+/**
+ * @file RollingTemperatureWindows.h
+ * @brief Declaration of the RollingTemperatureWindows class.
+ *
+ * The RollingTemperatureWindows class answers "min/max/mean over the last K
+ * SOLs" for several window sizes at once, plus exponentially weighted moving
+ * averages, updating everything in one pass per finalized SOL.
+ */
+#ifndef ROLLINGTEMPERATUREWINDOWS_H
+#define ROLLINGTEMPERATUREWINDOWS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Data/SOLManager.h"
+
+/**
+ * @struct WindowStatistics
+ * @brief Statistics of one sliding window.
+ */
+struct WindowStatistics {
+  std::size_t windowSize = 0; /**< Configured window length in SOLs. */
+  std::size_t count = 0;      /**< SOLs currently in the window. */
+  double minimum = 0.0;
+  double maximum = 0.0;
+  double sum = 0.0;
+  double mean = 0.0;
+};
+
+/**
+ * @class RollingTemperatureWindows
+ * @brief Sliding-window temperature analytics over the most recent SOLs.
+ *
+ * All windows share one ring buffer of recent temperatures sized for the
+ * largest window. Each window keeps a rolling sum and monotonic min and max
+ * deques stored as fixed rings, giving O(1) amortized updates and O(1)
+ * queries. Every buffer is allocated in the constructor, so updates never
+ * allocate.
+ */
+class RollingTemperatureWindows : public SOLObserver {
+ private:
+  /** @brief Fixed-capacity deque of (position, value) pairs. */
+  struct MonotonicDeque {
+    std::vector<std::uint64_t> positions;
+    std::vector<double> values;
+    std::size_t head = 0;
+    std::size_t length = 0;
+
+    void reset(std::size_t capacity);
+    /** @brief Pushes a value, dropping back entries that compare worse. */
+    template <typename Compare>
+    void push(std::uint64_t position, double value, Compare keepBefore);
+    /** @brief Drops the front entry if it is older than the window. */
+    void expire(std::uint64_t oldestPosition);
+    double front() const;
+  };
+
+  /** @brief State of one registered window. */
+  struct Window {
+    std::size_t size;
+    double sum;
+    MonotonicDeque minimum;
+    MonotonicDeque maximum;
+  };
+
+  std::vector<double> history; /**< Ring of the most recent temperatures. */
+  std::uint64_t total;         /**< Temperatures seen so far. */
+  std::vector<Window> windows;
+  std::vector<double> ewmaAlphas;
+  std::vector<double> ewmaValues;
+
+ public:
+  /**
+   * @brief Registers the windows and EWMA smoothing factors up front.
+   * @param windowSizes Window lengths in SOLs; each must be at least 1.
+   * @param ewmaAlphas EWMA smoothing factors, each in (0, 1].
+   * @throw std::invalid_argument on a zero window size or invalid alpha.
+   */
+  explicit RollingTemperatureWindows(
+      const std::vector<std::size_t>& windowSizes,
+      const std::vector<double>& ewmaAlphas = std::vector<double>());
+
+  /**
+   * @brief Adds the temperature of the next SOL to every window.
+   * @param temperature The temperature in Kelvin.
+   */
+  void addTemperature(double temperature);
+
+  /**
+   * @brief Gets the statistics of a registered window.
+   * @param windowIndex Index of the window in registration order.
+   * @return The window statistics.
+   * @throw std::out_of_range if windowIndex is invalid.
+   */
+  WindowStatistics getWindow(std::size_t windowIndex) const;
+
+  /**
+   * @brief Gets the current value of a registered EWMA.
+   * @param ewmaIndex Index of the EWMA in registration order.
+   * @return The EWMA, or 0 before the first temperature.
+   * @throw std::out_of_range if ewmaIndex is invalid.
+   */
+  double getEwma(std::size_t ewmaIndex) const;
+
+  /**
+   * @brief Gets the number of registered windows.
+   * @return The number of windows.
+   */
+  std::size_t getWindowCount() const;
+
+  /**
+   * @brief Callback method invoked when a SOL is finalized.
+   * @param solData The finalized SOL data.
+   */
+  void onSOLFinalized(const SOLData& solData) override;
+};
+
+#endif  // ROLLINGTEMPERATUREWINDOWS_H
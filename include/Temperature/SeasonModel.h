@@ -0,0 +1,179 @@
+/**
+ * @file SeasonModel.h
+ * @brief Declaration of the SeasonModel and SeasonalStatistics classes.
+ *
+ * The SeasonModel maps SOL numbers to Mars years and northern-hemisphere
+ * seasons from the areocentric solar longitude (Ls), so seasonal statistics
+ * work for any mission length and start date. SeasonalStatistics keeps
+ * per-season, per-year temperature aggregates as SOLs are finalized.
+ */
+#ifndef SEASONMODEL_H
+#define SEASONMODEL_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+#include "Data/SOLManager.h"
+
+/**
+ * @brief Length of a Mars year in sols.
+ */
+const double MARS_YEAR_SOLS = 668.6;
+
+/**
+ * @enum Season
+ * @brief Northern-hemisphere seasons; each spans 90 degrees of Ls.
+ */
+enum class Season { Spring, Summer, Autumn, Winter };
+
+/**
+ * @brief Number of seasons in a Mars year.
+ */
+const std::size_t SEASON_COUNT = 4;
+
+/**
+ * @struct SeasonPosition
+ * @brief Where a SOL falls in the Mars calendar.
+ */
+struct SeasonPosition {
+  int marsYear;           /**< Mars years since the mission started, from 0. */
+  Season season;          /**< The season of the SOL. */
+  double solarLongitude;  /**< Ls in degrees, in [0, 360). */
+};
+
+/**
+ * @class SeasonModel
+ * @brief Maps SOL numbers to Mars years and seasons.
+ *
+ * Ls advances unevenly because Mars' orbit is eccentric: northern spring lasts
+ * about 194 sols but autumn only about 142. The model solves Kepler's equation
+ * for each SOL, so seasons have their true lengths. A new Mars year begins
+ * whenever Ls wraps past 0.
+ */
+class SeasonModel {
+ private:
+  double yearSols;
+  int firstSol;
+  double startPhase;      /**< Mean anomaly past Ls 0 at the first SOL. */
+  double meanAnomalyAtLs0;
+
+  /**
+   * @brief Gets the phase (mean anomaly past Ls 0, accumulated over years)
+   * at the start of a SOL.
+   * @param solNumber The SOL number.
+   * @return The phase in radians.
+   */
+  double phaseOf(int solNumber) const;
+
+ public:
+  /**
+   * @brief Constructs a season model.
+   * @param yearSols Length of a Mars year in sols.
+   * @param startSolarLongitude Ls in degrees at the start of the first SOL.
+   * @param firstSol The SOL number the mission starts at.
+   * @throw std::invalid_argument if yearSols is not positive.
+   */
+  explicit SeasonModel(double yearSols = MARS_YEAR_SOLS,
+                       double startSolarLongitude = 0.0,
+                       int firstSol = INITIAL_SOL);
+
+  /**
+   * @brief Locates a SOL in the Mars calendar.
+   * @param solNumber The SOL number.
+   * @return The Mars year, season and Ls of the SOL.
+   */
+  SeasonPosition locate(int solNumber) const;
+
+  /**
+   * @brief Finds the first SOL of the season after the one a SOL is in.
+   * @param solNumber The SOL number.
+   * @return The first SOL number of the following season.
+   */
+  int nextSeasonStart(int solNumber) const;
+
+  /**
+   * @brief Gets the SOL number the mission starts at.
+   * @return The first SOL number.
+   */
+  int getFirstSol() const;
+};
+
+/**
+ * @struct SeasonAggregate
+ * @brief Temperature aggregate over one season.
+ */
+struct SeasonAggregate {
+  std::size_t count = 0;
+  double minimum = 0.0;
+  double maximum = 0.0;
+  double sum = 0.0;
+
+  /**
+   * @brief Adds a temperature to the aggregate.
+   * @param temperature The temperature to add.
+   */
+  void add(double temperature);
+
+  /**
+   * @brief Calculates the mean temperature.
+   * @return The mean, or 0 if the aggregate is empty.
+   */
+  double mean() const;
+};
+
+/**
+ * @class SeasonalStatistics
+ * @brief Incremental per-season, per-year temperature aggregates.
+ *
+ * Each SOL costs one season lookup and one aggregate update; every query is
+ * O(1) and never revisits stored data.
+ */
+class SeasonalStatistics : public SOLObserver {
+ private:
+  SeasonModel model;
+  std::vector<std::array<SeasonAggregate, SEASON_COUNT>> years;
+  std::array<SeasonAggregate, SEASON_COUNT> totals;
+
+ public:
+  /**
+   * @brief Constructs empty seasonal statistics.
+   * @param model The season model used to place SOLs.
+   */
+  explicit SeasonalStatistics(const SeasonModel& model = SeasonModel());
+
+  /**
+   * @brief Adds the temperature of a SOL.
+   * @param solNumber The SOL number.
+   * @param temperature The temperature in Kelvin.
+   */
+  void addTemperature(int solNumber, double temperature);
+
+  /**
+   * @brief Gets the aggregate of one season of one Mars year.
+   * @param marsYear The Mars year, counted from 0 at mission start.
+   * @param season The season.
+   * @return The season aggregate; empty if no SOL fell in it.
+   */
+  SeasonAggregate getAggregate(int marsYear, Season season) const;
+
+  /**
+   * @brief Gets the aggregate of a season across all Mars years.
+   * @param season The season.
+   * @return The season aggregate.
+   */
+  const SeasonAggregate& getAggregate(Season season) const;
+
+  /**
+   * @brief Gets the number of Mars years with at least one SOL.
+   * @return The number of Mars years seen.
+   */
+  int getYearCount() const;
+
+  /**
+   * @brief Callback method invoked when a SOL is finalized.
+   * @param solData The finalized SOL data.
+   */
+  void onSOLFinalized(const SOLData& solData) override;
+};
+
+#endif  // SEASONMODEL_H
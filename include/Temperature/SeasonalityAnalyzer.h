@@ -0,0 +1,92 @@
+/**
+ * @file SeasonalityAnalyzer.h
+ * @brief Declaration of the SeasonalityAnalyzer class.
+ *
+ * The SeasonalityAnalyzer class measures the dominant periods of a temperature
+ * series and derives season boundaries from the data instead of assuming them.
+ */
+#ifndef SEASONALITYANALYZER_H
+#define SEASONALITYANALYZER_H
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+#include "Data/SOLManager.h"
+#include "Temperature/FourierTransform.h"
+#include "Temperature/SeasonModel.h"
+
+/**
+ * @struct SpectralPeak
+ * @brief A periodic component of the temperature series.
+ */
+struct SpectralPeak {
+  double period; /**< Period in SOLs, refined between frequency bins. */
+  double power;  /**< Spectral power of the peak bin. */
+};
+
+/**
+ * @struct SeasonBoundary
+ * @brief First SOL of a measured season.
+ */
+struct SeasonBoundary {
+  int sol;
+  Season season;
+};
+
+/**
+ * @struct SeasonalityResult
+ * @brief Measured periodicity of a temperature series.
+ */
+struct SeasonalityResult {
+  std::vector<SpectralPeak> peaks;     /**< Strongest peaks, by power. */
+  double dominantPeriod = 0.0;         /**< Period of the strongest peak. */
+  double amplitude = 0.0;              /**< Amplitude of that cycle in Kelvin. */
+  double warmestSol = 0.0;             /**< First peak of that cycle. */
+  std::vector<SeasonBoundary> seasons; /**< Season starts, in SOL order. */
+};
+
+/**
+ * @class SeasonalityAnalyzer
+ * @brief Periodogram-based seasonality detection.
+ *
+ * The series is linearly detrended and Hann-windowed, then its power spectrum
+ * comes from a real-input FourierTransform of the exact series length. Local maxima are
+ * refined by parabolic interpolation of the log power. A sinusoid fitted at
+ * the dominant period places the warmest point of the cycle, and seasons are
+ * quarter periods with summer centred on it.
+ *
+ * Work buffers and FFT tables are kept between calls, so analyzing series of
+ * the same length repeatedly does not allocate beyond the result.
+ */
+class SeasonalityAnalyzer {
+ private:
+  std::size_t peakCount;
+  double minimumPeriod;
+  FourierTransform transform;
+  std::vector<std::complex<double>> spectrum;
+  std::vector<double> window; /**< Hann window for the prepared length. */
+  std::vector<double> detrended;
+  std::vector<double> windowed;
+  std::vector<std::size_t> candidates;
+
+ public:
+  /**
+   * @brief Constructs an analyzer.
+   * @param peakCount How many spectral peaks to report.
+   * @param minimumPeriod Shortest period in SOLs considered a peak.
+   * @throw std::invalid_argument if peakCount is 0 or minimumPeriod < 2.
+   */
+  explicit SeasonalityAnalyzer(std::size_t peakCount = 3,
+                               double minimumPeriod = 2.0);
+
+  /**
+   * @brief Analyzes a series of one temperature per consecutive SOL.
+   * @param temperatures The temperatures in SOL order.
+   * @param firstSol The SOL number of the first temperature.
+   * @return The measured seasonality; empty for fewer than 4 temperatures.
+   */
+  SeasonalityResult analyze(const std::vector<double>& temperatures,
+                            int firstSol = INITIAL_SOL);
+};
+
+#endif  // SEASONALITYANALYZER_H
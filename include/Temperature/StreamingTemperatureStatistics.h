@@ -0,0 +1,104 @@
+/**
+ * @file StreamingTemperatureStatistics.h
+ * @brief Declaration of the StreamingTemperatureStatistics class.
+ *
+ * The StreamingTemperatureStatistics class accumulates the temperature
+ * statistics of the final report one SOL at a time, as SOLs are finalized, so
+ * the report never has to revisit the stored mission.
+ */
+#ifndef STREAMINGTEMPERATURESTATISTICS_H
+#define STREAMINGTEMPERATURESTATISTICS_H
+
+#include <cstddef>
+#include <vector>
+#include "Data/SOLManager.h"
+#include "Temperature/MomentAccumulator.h"
+#include "Temperature/QuantileSketch.h"
+#include "Temperature/SeasonModel.h"
+
+/**
+ * @struct TemperatureSnapshot
+ * @brief Point-in-time view of the streamed temperature statistics.
+ */
+struct TemperatureSnapshot {
+  std::size_t count = 0;      /**< Number of SOLs seen. */
+  double mean = 0.0;          /**< Running mean. */
+  double variance = 0.0;      /**< Population variance. */
+  double minimum = 0.0;       /**< Lowest temperature. */
+  double maximum = 0.0;       /**< Highest temperature. */
+  double median = 0.0;        /**< Median from the quantile sketch. */
+  double lowestSummer = 0.0;  /**< Lowest summer temperature; +inf if none. */
+  double lowestWinter = 0.0;  /**< Lowest winter temperature; +inf if none. */
+  std::vector<double> highest; /**< Largest temperatures, descending. */
+  std::vector<double> lowest;  /**< Smallest temperatures, ascending. */
+};
+
+/**
+ * @class StreamingTemperatureStatistics
+ * @brief Single-pass temperature statistics fed by SOL finalization.
+ *
+ * Keeps a mergeable MomentAccumulator for mean, variance and range, bounded
+ * top-K and bottom-K heaps, a QuantileSketch for the median and per-season
+ * aggregates from a SeasonModel. Memory is bounded independent of mission
+ * length, and the moments and sketch can be merged with other shards'.
+ */
+class StreamingTemperatureStatistics : public SOLObserver {
+ private:
+  std::size_t extremeCount;
+  MomentAccumulator moments;
+  std::vector<double> highestHeap; /**< Min-heap of the largest values. */
+  std::vector<double> lowestHeap;  /**< Max-heap of the smallest values. */
+  QuantileSketch quantileSketch;
+  SeasonalStatistics seasonalStatistics;
+
+ public:
+  /**
+   * @brief Constructs an empty accumulator.
+   * @param extremeCount How many highest and lowest temperatures to keep.
+   * @param seasonModel The season model used to place SOLs in seasons.
+   * @param sketchCompression Compression of the quantile sketch.
+   */
+  explicit StreamingTemperatureStatistics(
+      std::size_t extremeCount = 3,
+      const SeasonModel& seasonModel = SeasonModel(),
+      double sketchCompression = DEFAULT_SKETCH_COMPRESSION);
+
+  /**
+   * @brief Adds the temperature of a SOL.
+   * @param solNumber The SOL number.
+   * @param temperature The temperature in Kelvin.
+   */
+  void addTemperature(int solNumber, double temperature);
+
+  /**
+   * @brief Gets the per-season, per-year aggregates.
+   * @return The seasonal statistics.
+   */
+  const SeasonalStatistics& getSeasonalStatistics() const;
+
+  /**
+   * @brief Gets the mergeable moments of every temperature seen.
+   * @return The moment accumulator.
+   */
+  const MomentAccumulator& getMoments() const;
+
+  /**
+   * @brief Gets the mergeable quantile sketch of every temperature seen.
+   * @return The quantile sketch.
+   */
+  const QuantileSketch& getQuantileSketch() const;
+
+  /**
+   * @brief Builds a snapshot of the current statistics.
+   * @return The temperature snapshot.
+   */
+  TemperatureSnapshot getSnapshot() const;
+
+  /**
+   * @brief Callback method invoked when a SOL is finalized.
+   * @param solData The finalized SOL data.
+   */
+  void onSOLFinalized(const SOLData& solData) override;
+};
+
+#endif  // STREAMINGTEMPERATURESTATISTICS_H
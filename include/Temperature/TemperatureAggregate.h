@@ -0,0 +1,40 @@
+/**
+ * @file TemperatureAggregate.h
+ * @brief Declaration of the TemperatureAggregate struct.
+ *
+ * The TemperatureAggregate struct summarizes every temperature reading taken
+ * during one SOL in a fixed amount of memory.
+ */
+#ifndef TEMPERATUREAGGREGATE_H
+#define TEMPERATUREAGGREGATE_H
+
+#include <cstddef>
+
+/**
+ * @struct TemperatureAggregate
+ * @brief Online count, min, max, mean and last value of a SOL's readings.
+ *
+ * Each reading is folded in with O(1) work and no allocation, so a high-rate
+ * temperature stream still costs a constant amount of memory per SOL.
+ */
+struct TemperatureAggregate {
+  std::size_t count = 0; /**< Number of readings. */
+  double minimum = 0.0;  /**< Lowest reading. */
+  double maximum = 0.0;  /**< Highest reading. */
+  double mean = 0.0;     /**< Running mean of the readings. */
+  double last = 0.0;     /**< Most recent reading. */
+
+  /**
+   * @brief Adds a reading to the aggregate.
+   * @param temperature The temperature in Kelvin.
+   */
+  void add(double temperature);
+
+  /**
+   * @brief Checks whether any reading has been added.
+   * @return True if the aggregate holds no readings.
+   */
+  bool empty() const;
+};
+
+#endif  // TEMPERATUREAGGREGATE_H
@@ -0,0 +1,177 @@
+/**
+ * @file TemperatureAnomalyDetector.h
+ * @brief Declaration of the TemperatureAnomalyDetector class.
+ *
+ * The TemperatureAnomalyDetector class flags SOLs whose temperature deviates
+ * sharply from recent history as they are finalized, and can re-run the same
+ * screen over archived data.
+ */
+#ifndef TEMPERATUREANOMALYDETECTOR_H
+#define TEMPERATUREANOMALYDETECTOR_H
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <vector>
+#include "Data/DataStorage.h"
+#include "Data/SOLManager.h"
+
+/**
+ * @enum AnomalyMethod
+ * @brief How a detector measures deviation from recent history.
+ */
+enum class AnomalyMethod {
+  RollingZScore, /**< Distance from the mean of the last windowSize SOLs. */
+  EwmaControl,   /**< Distance from EWMA control limits. */
+  RobustMad      /**< Modified z-score from a running median and MAD. */
+};
+
+/**
+ * @struct AnomalyDetectorOptions
+ * @brief Tuning parameters of a TemperatureAnomalyDetector.
+ */
+struct AnomalyDetectorOptions {
+  AnomalyMethod method = AnomalyMethod::RollingZScore;
+  std::size_t windowSize = 30;     /**< Rolling window length in SOLs. */
+  std::size_t minimumHistory = 10; /**< SOLs seen before anything is flagged. */
+  double threshold = 3.0;          /**< Score above which a SOL is flagged. */
+  double ewmaAlpha = 0.1;          /**< Smoothing factor of EwmaControl. */
+  double madLearningRate = 0.05;   /**< Step size of RobustMad, relative to MAD. */
+  std::size_t queueCapacity = 1024; /**< Queued anomalies kept; 0 disables. */
+};
+
+/**
+ * @struct TemperatureAnomaly
+ * @brief A flagged SOL.
+ */
+struct TemperatureAnomaly {
+  int solNumber;
+  double temperature; /**< The flagged temperature. */
+  double expected;    /**< The baseline it was compared against. */
+  double score;       /**< Deviation in units of the method's spread. */
+};
+
+/**
+ * @class TemperatureAnomalyDetector
+ * @brief Online temperature anomaly detection fed by SOL finalization.
+ *
+ * Each SOL is scored against the state built from the SOLs before it, then
+ * folded into that state. Updates are O(1) and every buffer is sized at
+ * construction from windowSize, so memory does not grow with the mission.
+ * RobustMad seeds its median and MAD exactly from the first minimumHistory
+ * SOLs and then tracks them by stochastic approximation.
+ *
+ * Flagged SOLs are passed to the callback, if one is set, and appended to a
+ * bounded queue that drops its oldest entry when full.
+ */
+class TemperatureAnomalyDetector : public SOLObserver {
+ public:
+  /** @brief Callback invoked for every flagged SOL. */
+  using AnomalyCallback = std::function<void(const TemperatureAnomaly&)>;
+
+ private:
+  AnomalyDetectorOptions options;
+  AnomalyCallback callback;
+  std::deque<TemperatureAnomaly> queue;
+  std::size_t droppedAnomalies;
+
+  std::size_t count;           /**< SOLs seen so far. */
+  std::vector<double> history; /**< Ring of the last windowSize SOLs. */
+  std::vector<double> scratch; /**< Seed buffer of RobustMad. */
+  double center;               /**< Mean, EWMA or median. */
+  double spread;               /**< Windowed M2, EW variance or MAD. */
+
+  double score(double temperature) const;
+  void update(double temperature);
+  void report(const TemperatureAnomaly& anomaly);
+
+ public:
+  /**
+   * @brief Constructs a detector.
+   * @param options The detector options.
+   * @throw std::invalid_argument if the options are inconsistent.
+   */
+  explicit TemperatureAnomalyDetector(
+      const AnomalyDetectorOptions& options = AnomalyDetectorOptions());
+
+  /**
+   * @brief Scores a SOL and folds it into the detector state.
+   * @param solNumber The SOL number.
+   * @param temperature The temperature in Kelvin.
+   * @return True if the SOL was flagged.
+   */
+  bool addTemperature(int solNumber, double temperature);
+
+  /**
+   * @brief Sets the callback invoked for every flagged SOL.
+   * @param anomalyCallback The callback, or an empty function to clear it.
+   */
+  void setCallback(const AnomalyCallback& anomalyCallback);
+
+  /**
+   * @brief Pops the oldest queued anomaly.
+   * @param anomaly Receives the anomaly.
+   * @return False if the queue is empty.
+   */
+  bool pollAnomaly(TemperatureAnomaly& anomaly);
+
+  /**
+   * @brief Gets the number of queued anomalies.
+   * @return The queue length.
+   */
+  std::size_t getPendingCount() const;
+
+  /**
+   * @brief Gets how many anomalies were dropped from a full queue.
+   * @return The dropped count.
+   */
+  std::size_t getDroppedCount() const;
+
+  /**
+   * @brief Callback method invoked when a SOL is finalized.
+   * @param solData The finalized SOL data.
+   */
+  void onSOLFinalized(const SOLData& solData) override;
+
+  /**
+   * @brief Screens archived temperatures in one batch.
+   *
+   * Replays a fresh detector over the series in O(n), so the flagged SOLs,
+   * baselines and scores are exactly those of streaming detection.
+   * @param solNumbers The SOL number of each temperature.
+   * @param temperatures The temperatures in SOL order.
+   * @param options The detector options.
+   * @return The flagged SOLs in order.
+   * @throw std::invalid_argument if the options are inconsistent or the
+   * inputs differ in length.
+   */
+  static std::vector<TemperatureAnomaly> evaluate(
+      const std::vector<int>& solNumbers, const std::vector<double>& temperatures,
+      const AnomalyDetectorOptions& options = AnomalyDetectorOptions());
+
+  /**
+   * @brief Screens archived temperature columns in one batch.
+   * @param solNumbers The SOL number column.
+   * @param temperatures The temperature column, in SOL order.
+   * @param size Number of rows in both columns.
+   * @param options The detector options.
+   * @return The flagged SOLs in order.
+   * @throw std::invalid_argument if the options are inconsistent.
+   */
+  static std::vector<TemperatureAnomaly> evaluate(
+      const int* solNumbers, const double* temperatures, std::size_t size,
+      const AnomalyDetectorOptions& options = AnomalyDetectorOptions());
+
+  /**
+   * @brief Screens every SOL in a DataStorage in one batch, gathering its
+   * columns one block at a time.
+   * @param storage The archived mission data.
+   * @param options The detector options.
+   * @return The flagged SOLs in order.
+   */
+  static std::vector<TemperatureAnomaly> evaluate(
+      const DataStorage& storage,
+      const AnomalyDetectorOptions& options = AnomalyDetectorOptions());
+};
+
+#endif  // TEMPERATUREANOMALYDETECTOR_H
@@ -0,0 +1,152 @@
+/**
+ * @file BoundedQueue.h
+ * @brief Declaration of the BoundedQueue class template.
+ *
+ * A fixed-capacity, lock-free ring that hands values between threads without
+ * allocating after construction.
+ */
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @class BoundedQueue
+ * @brief Bounded multi-producer, multi-consumer FIFO ring.
+ *
+ * Every slot carries a sequence number telling whether it is free for the
+ * push at a position or holds the value for the pop at that position.
+ * Producers and consumers claim positions with a compare-and-swap on their
+ * own counter and publish the slot with a release store of its sequence, so
+ * neither side takes a lock and a full or empty ring fails fast instead of
+ * waiting. Values are copied in and out; T should be cheap to copy.
+ *
+ * @tparam T The value type.
+ */
+template <typename T>
+class BoundedQueue {
+ private:
+  static const std::size_t CACHE_LINE = 64;
+
+  std::unique_ptr<std::atomic<std::size_t>[]> sequences;
+  std::vector<T> values;
+  std::size_t mask;
+  // Producers and consumers each write their own counter; keep the two on
+  // separate cache lines.
+  char padding0[CACHE_LINE];
+  std::atomic<std::size_t> pushPosition;
+  char padding1[CACHE_LINE - sizeof(std::atomic<std::size_t>)];
+  std::atomic<std::size_t> popPosition;
+  char padding2[CACHE_LINE - sizeof(std::atomic<std::size_t>)];
+
+ public:
+  /**
+   * @brief Constructs an empty queue.
+   * @param capacity The number of slots, a power of two of at least 2.
+   * @param fill The value slots hold before their first push.
+   * @throw std::invalid_argument if capacity is not a power of two of at
+   * least 2.
+   */
+  explicit BoundedQueue(const std::size_t capacity, const T& fill = T())
+      : sequences(new std::atomic<std::size_t>[capacity]),
+        values(capacity, fill),
+        mask(capacity - 1),
+        pushPosition(0),
+        popPosition(0) {
+    if (capacity < 2 || (capacity & mask) != 0) {
+      throw std::invalid_argument("Queue capacity must be a power of two of at least 2");
+    }
+    for (std::size_t slot = 0; slot < capacity; ++slot) {
+      sequences[slot].store(slot, std::memory_order_relaxed);
+    }
+  }
+
+  BoundedQueue(const BoundedQueue&) = delete;
+  BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+  /**
+   * @brief Appends a value unless the queue is full.
+   * @param value The value.
+   * @return True if the value was appended.
+   */
+  bool tryPush(const T& value) {
+    std::size_t position = pushPosition.load(std::memory_order_relaxed);
+    for (;;) {
+      const std::size_t slot = position & mask;
+      const std::size_t sequence = sequences[slot].load(std::memory_order_acquire);
+      const std::ptrdiff_t lag =
+          static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+      if (lag == 0) {
+        if (pushPosition.compare_exchange_weak(position, position + 1,
+                                               std::memory_order_relaxed)) {
+          values[slot] = value;
+          sequences[slot].store(position + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (lag < 0) {
+        // The slot still holds the value pushed one lap earlier.
+        return false;
+      } else {
+        position = pushPosition.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @brief Removes the oldest value unless the queue is empty.
+   * @param value Receives the value.
+   * @return True if a value was removed.
+   */
+  bool tryPop(T& value) {
+    std::size_t position = popPosition.load(std::memory_order_relaxed);
+    for (;;) {
+      const std::size_t slot = position & mask;
+      const std::size_t sequence = sequences[slot].load(std::memory_order_acquire);
+      const std::ptrdiff_t lag =
+          static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+      if (lag == 0) {
+        if (popPosition.compare_exchange_weak(position, position + 1,
+                                              std::memory_order_relaxed)) {
+          value = values[slot];
+          sequences[slot].store(position + mask + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (lag < 0) {
+        // The value for this position is not published yet.
+        return false;
+      } else {
+        position = popPosition.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @brief Tells whether the next pop would find a value.
+   * @return True if the oldest slot is published; may be stale on return.
+   */
+  bool canPop() const {
+    const std::size_t position = popPosition.load(std::memory_order_relaxed);
+    return sequences[position & mask].load(std::memory_order_acquire) == position + 1;
+  }
+
+  /**
+   * @brief Tells whether the next push would find a free slot.
+   * @return True if the next slot is free; may be stale on return.
+   */
+  bool canPush() const {
+    const std::size_t position = pushPosition.load(std::memory_order_relaxed);
+    return sequences[position & mask].load(std::memory_order_acquire) == position;
+  }
+
+  /**
+   * @brief Gets the number of slots.
+   * @return The capacity.
+   */
+  std::size_t capacity() const { return mask + 1; }
+};
+
+#endif  // BOUNDEDQUEUE_H
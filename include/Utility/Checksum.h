@@ -0,0 +1,32 @@
+/**
+ * @file Checksum.h
+ * @brief Declaration of the Checksum class.
+ *
+ * The Checksum class computes CRC-32C checksums used to detect torn or
+ * corrupted data in on-disk files.
+ */
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class Checksum
+ * @brief Table-driven CRC-32C (Castagnoli), eight bytes per step.
+ */
+class Checksum {
+ public:
+  /**
+   * @brief Computes or extends a CRC-32C checksum.
+   * @param data Pointer to the first byte.
+   * @param size Number of bytes.
+   * @param previous Checksum of the preceding bytes, to checksum data in
+   * pieces; 0 to start a new checksum.
+   * @return The checksum of everything seen so far.
+   */
+  static std::uint32_t crc32c(const void* data, std::size_t size,
+                              std::uint32_t previous = 0);
+};
+
+#endif  // CHECKSUM_H
@@ -0,0 +1,259 @@
+/**
+ * @file IngestCheckpoint.cpp
+ * @brief Implementation of the CheckpointWriter class.
+ */
+
+#include "Core/IngestCheckpoint.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include "Utility/Checksum.h"
+
+namespace {
+const char CHECKPOINT_MAGIC[8] = {'E', 'N', 'I', 'G', 'M', 'A', 'C', 'P'};
+
+[[noreturn]] void throwSystemError(const std::string& what) {
+  throw std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+/** @brief Appends the bytes of a value. */
+template <typename T>
+void put(std::string& bytes, const T value) {
+  bytes.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/** @brief Reads values back in the order they were put. */
+class ByteReader {
+ private:
+  const std::string& bytes;
+  std::size_t offset;
+
+ public:
+  explicit ByteReader(const std::string& bytes) : bytes(bytes), offset(0) {}
+
+  template <typename T>
+  T get() {
+    if (offset + sizeof(T) > bytes.size()) {
+      throw std::runtime_error("Checkpoint is truncated");
+    }
+    T value;
+    std::memcpy(&value, bytes.data() + offset, sizeof(value));
+    offset += sizeof(value);
+    return value;
+  }
+};
+
+/**
+ * @brief Serializes field by field, so padding never reaches the file, and
+ * appends a CRC-32C of everything before it.
+ */
+std::string serialize(const IngestCheckpoint& checkpoint) {
+  std::string bytes(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+  put(bytes, INGEST_CHECKPOINT_VERSION);
+  put(bytes, checkpoint.inputOffset);
+  put(bytes, static_cast<std::int32_t>(checkpoint.currentSOL));
+  put(bytes, static_cast<std::int32_t>(checkpoint.totalSOLs));
+  put(bytes, checkpoint.storedSOLs);
+  const RobotState& robot = checkpoint.robotState;
+  put(bytes, robot.navigation.x);
+  put(bytes, robot.navigation.y);
+  put(bytes, robot.navigation.angle);
+  put(bytes, robot.navigation.finalDistance);
+  put(bytes, static_cast<std::uint8_t>(robot.navigation.finalDirection));
+  put(bytes, static_cast<std::uint64_t>(robot.temperature.count));
+  put(bytes, robot.temperature.minimum);
+  put(bytes, robot.temperature.maximum);
+  put(bytes, robot.temperature.mean);
+  put(bytes, robot.temperature.last);
+  put(bytes, robot.sampleReading.wavelength);
+  put(bytes, robot.sampleReading.intensity);
+  put(bytes, static_cast<std::uint8_t>(robot.sampleReading.collected));
+  put(bytes, static_cast<std::int32_t>(robot.elementId));
+  put(bytes, Checksum::crc32c(bytes.data(), bytes.size()));
+  return bytes;
+}
+
+IngestCheckpoint deserialize(const std::string& bytes) {
+  if (bytes.size() < sizeof(CHECKPOINT_MAGIC) + sizeof(std::uint32_t) ||
+      std::memcmp(bytes.data(), CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0) {
+    throw std::runtime_error("Checkpoint is corrupt");
+  }
+  const std::size_t body = bytes.size() - sizeof(std::uint32_t);
+  std::uint32_t checksum;
+  std::memcpy(&checksum, bytes.data() + body, sizeof(checksum));
+  if (checksum != Checksum::crc32c(bytes.data(), body)) {
+    throw std::runtime_error("Checkpoint is corrupt");
+  }
+
+  ByteReader reader(bytes);
+  for (std::size_t i = 0; i < sizeof(CHECKPOINT_MAGIC); ++i) {
+    reader.get<char>();
+  }
+  if (reader.get<std::uint32_t>() != INGEST_CHECKPOINT_VERSION) {
+    throw std::runtime_error("Checkpoint was written by an incompatible build");
+  }
+  IngestCheckpoint checkpoint;
+  checkpoint.inputOffset = reader.get<std::uint64_t>();
+  checkpoint.currentSOL = reader.get<std::int32_t>();
+  checkpoint.totalSOLs = reader.get<std::int32_t>();
+  checkpoint.storedSOLs = reader.get<std::uint64_t>();
+  RobotState& robot = checkpoint.robotState;
+  robot.navigation.x = reader.get<double>();
+  robot.navigation.y = reader.get<double>();
+  robot.navigation.angle = reader.get<double>();
+  robot.navigation.finalDistance = reader.get<double>();
+  robot.navigation.finalDirection = static_cast<Direction>(reader.get<std::uint8_t>());
+  robot.temperature.count = static_cast<std::size_t>(reader.get<std::uint64_t>());
+  robot.temperature.minimum = reader.get<double>();
+  robot.temperature.maximum = reader.get<double>();
+  robot.temperature.mean = reader.get<double>();
+  robot.temperature.last = reader.get<double>();
+  robot.sampleReading.wavelength = reader.get<double>();
+  robot.sampleReading.intensity = reader.get<double>();
+  robot.sampleReading.collected = reader.get<std::uint8_t>() != 0;
+  robot.elementId = reader.get<std::int32_t>();
+  return checkpoint;
+}
+
+std::string directoryOf(const std::string& path) {
+  const std::size_t slash = path.find_last_of('/');
+  if (slash == std::string::npos) {
+    return ".";
+  }
+  return slash == 0 ? "/" : path.substr(0, slash);
+}
+}  // namespace
+
+CheckpointWriter::CheckpointWriter(const std::string& path)
+    : path(path),
+      hasWaiting(false),
+      writing(false),
+      stopping(false),
+      writtenCount(0),
+      worker(&CheckpointWriter::run, this) {}
+
+CheckpointWriter::~CheckpointWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  worker.join();
+}
+
+void CheckpointWriter::run() {
+  std::unique_lock<std::mutex> lock(mutex);
+  for (;;) {
+    wake.wait(lock, [this] { return hasWaiting || stopping; });
+    if (!hasWaiting) {
+      return;
+    }
+    const IngestCheckpoint checkpoint = waiting;
+    hasWaiting = false;
+    writing = true;
+    lock.unlock();
+    std::string error;
+    try {
+      write(path, checkpoint);
+    } catch (const std::exception& exception) {
+      error = exception.what();
+    }
+    lock.lock();
+    writing = false;
+    lastError = error;
+    if (error.empty()) {
+      ++writtenCount;
+    }
+    wake.notify_all();
+  }
+}
+
+void CheckpointWriter::submit(const IngestCheckpoint& checkpoint) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    waiting = checkpoint;
+    hasWaiting = true;
+  }
+  wake.notify_all();
+}
+
+void CheckpointWriter::flush() {
+  std::unique_lock<std::mutex> lock(mutex);
+  wake.wait(lock, [this] { return !hasWaiting && !writing; });
+  if (!lastError.empty()) {
+    throw std::runtime_error(lastError);
+  }
+}
+
+std::size_t CheckpointWriter::getWrittenCount() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return writtenCount;
+}
+
+void CheckpointWriter::write(const std::string& path, const IngestCheckpoint& checkpoint) {
+  const std::string bytes = serialize(checkpoint);
+  const std::string temporary = path + ".tmp";
+  const int descriptor =
+      ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (descriptor < 0) {
+    throwSystemError("Unable to create checkpoint");
+  }
+  std::size_t written = 0;
+  while (written < bytes.size()) {
+    const ssize_t done = ::write(descriptor, bytes.data() + written, bytes.size() - written);
+    if (done < 0 && errno == EINTR) {
+      continue;
+    }
+    if (done < 0) {
+      ::close(descriptor);
+      throwSystemError("Unable to write checkpoint");
+    }
+    written += static_cast<std::size_t>(done);
+  }
+  if (::fdatasync(descriptor) != 0) {
+    ::close(descriptor);
+    throwSystemError("Unable to sync checkpoint");
+  }
+  ::close(descriptor);
+  if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+    throwSystemError("Unable to publish checkpoint");
+  }
+  // Make the rename itself durable.
+  const int folder = ::open(directoryOf(path).c_str(), O_RDONLY | O_CLOEXEC);
+  if (folder >= 0) {
+    ::fsync(folder);
+    ::close(folder);
+  }
+}
+
+bool CheckpointWriter::read(const std::string& path, IngestCheckpoint& checkpoint) {
+  const int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (descriptor < 0) {
+    if (errno == ENOENT) {
+      return false;
+    }
+    throwSystemError("Unable to open checkpoint");
+  }
+  std::string bytes;
+  char buffer[256];
+  for (;;) {
+    const ssize_t done = ::read(descriptor, buffer, sizeof(buffer));
+    if (done < 0 && errno == EINTR) {
+      continue;
+    }
+    if (done < 0) {
+      ::close(descriptor);
+      throwSystemError("Unable to read checkpoint");
+    }
+    if (done == 0) {
+      break;
+    }
+    bytes.append(buffer, static_cast<std::size_t>(done));
+  }
+  ::close(descriptor);
+  checkpoint = deserialize(bytes);
+  return true;
+}
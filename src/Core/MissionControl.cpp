@@ -4,6 +4,7 @@
  */
 
 #include "MissionControl.h"
+#include <stdexcept>
 
 MissionControl::MissionControl(RobotInterfacePtr robot,
                                std::unique_ptr<SOLManager> solManager,
@@ -12,7 +13,9 @@ MissionControl::MissionControl(RobotInterfacePtr robot,
     : robot(std::move(robot)),
       solManager(std::move(solManager)),
       dataStorage(std::move(dataStorage)),
-      recordParser(std::move(recordParser)) {
+      recordParser(std::move(recordParser)),
+      checkpointInterval(DEFAULT_CHECKPOINT_INTERVAL),
+      checkpointedSOLs(0) {
   // Use shared_from_this() to safely add the current instance as an observer
 }
 
@@ -28,15 +31,92 @@ void MissionControl::handleRecord(const std::string& record) const {
 void MissionControl::finalizeCurrentSOL() const {
   const int currentSolNumber = solManager->getCurrentSOL();
   const SOLData currentSOLData = robot->getCurrentSOLData(currentSolNumber);
-  dataStorage->storeSOLData(currentSOLData);
+  // Observers, including this MissionControl, store and analyze the SOL.
+  solManager->notifyObservers(currentSOLData);
   solManager->advanceSOL();
   robot->reset();
 }
 
+void MissionControl::flushObservers() const {
+  solManager->flushObservers();
+}
+
 std::vector<SOLData> MissionControl::getObservations() const {
   return dataStorage->getAllSOLData();
 }
 
+SOLDataView MissionControl::viewObservations() const {
+  return dataStorage->view();
+}
+
+void MissionControl::forEachObservation(
+    const std::function<void(const SOLData&)>& visitor) const {
+  dataStorage->forEachSOLData(visitor);
+}
+
+const DataStorage& MissionControl::getDataStorage() const {
+  return *dataStorage;
+}
+
+void MissionControl::enableCheckpoints(std::shared_ptr<SOLArchiveWriter> archiveWriter,
+                                       std::unique_ptr<CheckpointWriter> checkpointWriter,
+                                       const std::size_t interval) {
+  if (interval == 0) {
+    throw std::invalid_argument("Checkpoint interval must be at least 1");
+  }
+  this->archiveWriter = std::move(archiveWriter);
+  this->checkpointWriter = std::move(checkpointWriter);
+  checkpointInterval = interval;
+  checkpointedSOLs = solManager->getTotalSOLs();
+}
+
+void MissionControl::advanceInput(const std::uint64_t inputOffset) {
+  if (checkpointWriter &&
+      static_cast<std::size_t>(solManager->getTotalSOLs() - checkpointedSOLs) >=
+          checkpointInterval) {
+    checkpoint(inputOffset);
+  }
+}
+
+void MissionControl::checkpoint(const std::uint64_t inputOffset) {
+  if (!checkpointWriter) {
+    throw std::logic_error("Checkpoints are not enabled");
+  }
+  // The checkpoint may only claim SOLs the archive has made durable, and the
+  // archive may be fed on another thread.
+  solManager->flushObservers();
+  archiveWriter->commit();
+  IngestCheckpoint checkpoint;
+  checkpoint.inputOffset = inputOffset;
+  checkpoint.currentSOL = solManager->getCurrentSOL();
+  checkpoint.totalSOLs = solManager->getTotalSOLs();
+  checkpoint.robotState = robot->saveState();
+  checkpoint.storedSOLs = archiveWriter->getCommittedCount();
+  checkpointWriter->submit(checkpoint);
+  checkpointedSOLs = checkpoint.totalSOLs;
+}
+
+void MissionControl::flushCheckpoints() const {
+  if (checkpointWriter) {
+    checkpointWriter->flush();
+  }
+}
+
+std::uint64_t MissionControl::resume(const IngestCheckpoint& checkpoint) {
+  if (!checkpointWriter) {
+    throw std::logic_error("Checkpoints are not enabled");
+  }
+  archiveWriter->rollback(static_cast<std::size_t>(checkpoint.storedSOLs));
+  dataStorage->loadArchive(SOLArchive::open(archiveWriter->getDirectory()));
+  if (dataStorage->size() != checkpoint.storedSOLs) {
+    throw std::runtime_error("Archive does not match the checkpoint");
+  }
+  solManager->restore(checkpoint.currentSOL, checkpoint.totalSOLs);
+  robot->restoreState(checkpoint.robotState);
+  checkpointedSOLs = checkpoint.totalSOLs;
+  return checkpoint.inputOffset;
+}
+
 void MissionControl::onSOLFinalized(const SOLData& solData) {
   dataStorage->storeSOLData(solData);
   // Additional actions when a SOL is finalized can be added here
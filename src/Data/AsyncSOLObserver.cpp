@@ -0,0 +1,179 @@
+/**
+ * @file AsyncSOLObserver.cpp
+ * @brief Implementation of the AsyncSOLObserver class.
+ */
+
+#include "Data/AsyncSOLObserver.h"
+#include <stdexcept>
+#include <utility>
+
+namespace {
+const int IDLE_YIELDS = 64;
+}  // namespace
+
+AsyncSOLObserver::AsyncSOLObserver(SOLObserverPtr target, const std::size_t capacity,
+                                   const BackpressurePolicy policy)
+    : target(std::move(target)),
+      policy(policy),
+      queue(capacity, SOLData(0)),
+      consumerWaiting(false),
+      producerWaiting(false),
+      stopping(false),
+      delivered(0),
+      dropped(0),
+      coalesced(0),
+      pushed(0),
+      overflow(0),
+      hasOverflow(false),
+      failed(false) {
+  if (!this->target) {
+    throw std::invalid_argument("Asynchronous observer needs a target");
+  }
+  consumer = std::thread(&AsyncSOLObserver::consume, this);
+}
+
+AsyncSOLObserver::~AsyncSOLObserver() {
+  if (hasOverflow) {
+    pushWaiting(overflow);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping.store(true);
+    consumerWake.notify_one();
+  }
+  consumer.join();
+}
+
+void AsyncSOLObserver::consume() {
+  SOLData solData(0);
+  int idleRounds = 0;
+  for (;;) {
+    if (queue.tryPop(solData)) {
+      if (!failed.load(std::memory_order_relaxed)) {
+        try {
+          target->onSOLFinalized(solData);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(mutex);
+          failure = std::current_exception();
+          failed.store(true, std::memory_order_relaxed);
+        }
+      }
+      delivered.fetch_add(1);
+      wakeProducer();
+      idleRounds = 0;
+      continue;
+    }
+    // Give the producer a chance to queue more before paying for a sleep and
+    // a wakeup per SOL.
+    if (idleRounds < IDLE_YIELDS) {
+      ++idleRounds;
+      std::this_thread::yield();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    consumerWaiting.store(true);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    consumerWake.wait(lock, [this]() { return queue.canPop() || stopping.load(); });
+    consumerWaiting.store(false);
+    if (!queue.canPop()) {
+      return;
+    }
+  }
+}
+
+void AsyncSOLObserver::wakeConsumer() {
+  // Pairs with the fence in consume(): either the consumer sees the push
+  // before sleeping or this sees that it sleeps.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (consumerWaiting.load()) {
+    std::lock_guard<std::mutex> lock(mutex);
+    consumerWake.notify_one();
+  }
+}
+
+void AsyncSOLObserver::wakeProducer() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (producerWaiting.load()) {
+    std::lock_guard<std::mutex> lock(mutex);
+    producerWake.notify_one();
+  }
+}
+
+void AsyncSOLObserver::pushWaiting(const SOLData& solData) {
+  while (!queue.tryPush(solData)) {
+    std::unique_lock<std::mutex> lock(mutex);
+    producerWaiting.store(true);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    producerWake.wait(lock, [this]() { return queue.canPush(); });
+    producerWaiting.store(false);
+  }
+  ++pushed;
+  wakeConsumer();
+}
+
+void AsyncSOLObserver::onSOLFinalized(const SOLData& solData) {
+  switch (policy) {
+    case BackpressurePolicy::Block:
+      pushWaiting(solData);
+      return;
+    case BackpressurePolicy::DropOldest: {
+      SOLData discarded(0);
+      while (!queue.tryPush(solData)) {
+        // The consumer may win the race for the oldest SOL; then there is room.
+        if (queue.tryPop(discarded)) {
+          dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+      ++pushed;
+      wakeConsumer();
+      return;
+    }
+    case BackpressurePolicy::Coalesce:
+      if (hasOverflow && queue.tryPush(overflow)) {
+        ++pushed;
+        hasOverflow = false;
+      }
+      if (!hasOverflow && queue.tryPush(solData)) {
+        ++pushed;
+      } else {
+        if (hasOverflow) {
+          coalesced.fetch_add(1, std::memory_order_relaxed);
+        }
+        overflow = solData;
+        hasOverflow = true;
+      }
+      wakeConsumer();
+      return;
+  }
+}
+
+void AsyncSOLObserver::flush() {
+  if (hasOverflow) {
+    pushWaiting(overflow);
+    hasOverflow = false;
+  }
+  const std::size_t expected = pushed - dropped.load(std::memory_order_relaxed);
+  if (delivered.load() != expected) {
+    std::unique_lock<std::mutex> lock(mutex);
+    producerWaiting.store(true);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    producerWake.wait(lock, [this, expected]() { return delivered.load() == expected; });
+    producerWaiting.store(false);
+  }
+  if (failed.load()) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::rethrow_exception(failure);
+  }
+}
+
+const SOLObserverPtr& AsyncSOLObserver::getTarget() const {
+  return target;
+}
+
+std::size_t AsyncSOLObserver::getDroppedCount() const {
+  return dropped.load(std::memory_order_relaxed);
+}
+
+std::size_t AsyncSOLObserver::getCoalescedCount() const {
+  return coalesced.load(std::memory_order_relaxed);
+}
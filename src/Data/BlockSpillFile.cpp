@@ -0,0 +1,114 @@
+/**
+ * @file BlockSpillFile.cpp
+ * @brief Implementation of the BlockSpillFile class.
+ */
+
+#include "Data/BlockSpillFile.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+[[noreturn]] void throwSystemError(const std::string& what) {
+  throw std::runtime_error(what + ": " + std::strerror(errno));
+}
+}  // namespace
+
+BlockSpillFile::BlockSpillFile(const std::string& directory) : descriptor(-1), length(0) {
+  const std::string pattern = directory + "/sol_spill_XXXXXX";
+  std::vector<char> path(pattern.begin(), pattern.end());
+  path.push_back('\0');
+  descriptor = ::mkstemp(path.data());
+  if (descriptor < 0) {
+    throwSystemError("Unable to create spill file");
+  }
+  ::fcntl(descriptor, F_SETFD, FD_CLOEXEC);
+  // Only the descriptor keeps the file alive from here on.
+  ::unlink(path.data());
+}
+
+BlockSpillFile::~BlockSpillFile() {
+  ::close(descriptor);
+}
+
+void BlockSpillFile::writeAt(const std::uint64_t offset, const std::string& bytes) {
+  std::size_t written = 0;
+  while (written < bytes.size()) {
+    const ssize_t done = ::pwrite(descriptor, bytes.data() + written, bytes.size() - written,
+                                  static_cast<off_t>(offset + written));
+    if (done < 0 && errno == EINTR) {
+      continue;
+    }
+    if (done < 0) {
+      throwSystemError("Unable to write spill file");
+    }
+    written += static_cast<std::size_t>(done);
+  }
+}
+
+std::uint64_t BlockSpillFile::write(const std::string& bytes) {
+  for (std::map<std::uint64_t, std::uint64_t>::iterator range = freeRanges.begin();
+       range != freeRanges.end(); ++range) {
+    if (range->second < bytes.size()) {
+      continue;
+    }
+    const std::uint64_t offset = range->first;
+    writeAt(offset, bytes);
+    const std::uint64_t rest = range->second - bytes.size();
+    freeRanges.erase(range);
+    if (rest > 0) {
+      freeRanges[offset + bytes.size()] = rest;
+    }
+    return offset;
+  }
+  const std::uint64_t offset = length;
+  writeAt(offset, bytes);
+  length += bytes.size();
+  return offset;
+}
+
+void BlockSpillFile::release(std::uint64_t offset, const std::size_t size) {
+  if (size == 0) {
+    return;
+  }
+  std::uint64_t end = offset + size;
+  std::map<std::uint64_t, std::uint64_t>::iterator next = freeRanges.lower_bound(offset);
+  if (next != freeRanges.end() && next->first == end) {
+    end += next->second;
+    next = freeRanges.erase(next);
+  }
+  if (next != freeRanges.begin()) {
+    std::map<std::uint64_t, std::uint64_t>::iterator previous = std::prev(next);
+    if (previous->first + previous->second == offset) {
+      offset = previous->first;
+      freeRanges.erase(previous);
+    }
+  }
+  freeRanges[offset] = end - offset;
+}
+
+std::string BlockSpillFile::read(const std::uint64_t offset, const std::size_t size) const {
+  std::string bytes(size, '\0');
+  std::size_t done = 0;
+  while (done < size) {
+    const ssize_t got = ::pread(descriptor, &bytes[done], size - done,
+                                static_cast<off_t>(offset + done));
+    if (got < 0 && errno == EINTR) {
+      continue;
+    }
+    if (got <= 0) {
+      throwSystemError("Unable to read spill file");
+    }
+    done += static_cast<std::size_t>(got);
+  }
+  return bytes;
+}
+
+std::uint64_t BlockSpillFile::size() const {
+  return length;
+}
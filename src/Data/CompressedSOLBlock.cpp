@@ -0,0 +1,477 @@
+/**
+ * @file CompressedSOLBlock.cpp
+ * @brief Implementation of the CompressedSOLBlock class.
+ */
+
+#include "Data/CompressedSOLBlock.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+const unsigned DIRECTION_WIDTH = 2;
+const unsigned MAX_LEADING_ZEROS = 31; /**< Largest count a 5-bit field holds. */
+
+std::uint64_t bitsOf(const double value) {
+  std::uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+double doubleOf(const std::uint64_t bits) {
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/** @brief Appends bit fields to a word vector, least significant bit first. */
+class BitWriter {
+ private:
+  std::vector<std::uint64_t>& words;
+  unsigned used; /**< Bits used in the last word; 64 when it is full. */
+
+ public:
+  explicit BitWriter(std::vector<std::uint64_t>& words) : words(words), used(64) {}
+
+  void write(std::uint64_t value, const unsigned width) {
+    if (width == 0) {
+      return;
+    }
+    if (width < 64) {
+      value &= (std::uint64_t(1) << width) - 1;
+    }
+    if (used == 64) {
+      words.push_back(0);
+      used = 0;
+    }
+    words.back() |= value << used;
+    const unsigned room = 64 - used;
+    if (width <= room) {
+      used += width;
+    } else {
+      words.push_back(value >> room);
+      used = width - room;
+    }
+  }
+};
+
+/** @brief Reads bit fields written by BitWriter. */
+class BitReader {
+ private:
+  const std::uint64_t* words;
+  std::size_t position;
+
+ public:
+  explicit BitReader(const std::vector<std::uint64_t>& words)
+      : words(words.data()), position(0) {}
+
+  std::uint64_t read(const unsigned width) {
+    if (width == 0) {
+      return 0;
+    }
+    const std::size_t word = position >> 6;
+    const unsigned offset = static_cast<unsigned>(position & 63);
+    std::uint64_t value = words[word] >> offset;
+    if (offset + width > 64) {
+      value |= words[word + 1] << (64 - offset);
+    }
+    position += width;
+    return width == 64 ? value : value & ((std::uint64_t(1) << width) - 1);
+  }
+
+  bool readBit() { return read(1) != 0; }
+};
+
+/** @brief Gorilla XOR encoder for one stream of doubles. */
+class XorEncoder {
+ private:
+  BitWriter& writer;
+  std::uint64_t previous;
+  unsigned leading;
+  unsigned trailing;
+  bool started;
+
+ public:
+  explicit XorEncoder(BitWriter& writer)
+      : writer(writer), previous(0), leading(0), trailing(0), started(false) {}
+
+  void add(const double value) {
+    const std::uint64_t bits = bitsOf(value);
+    if (!started) {
+      writer.write(bits, 64);
+      previous = bits;
+      // No window yet: an impossible width forces the first one to be written.
+      leading = 64;
+      trailing = 64;
+      started = true;
+      return;
+    }
+    const std::uint64_t difference = bits ^ previous;
+    previous = bits;
+    if (difference == 0) {
+      writer.write(0, 1);
+      return;
+    }
+    writer.write(1, 1);
+    const unsigned newLeading =
+        std::min(static_cast<unsigned>(__builtin_clzll(difference)), MAX_LEADING_ZEROS);
+    const unsigned newTrailing = static_cast<unsigned>(__builtin_ctzll(difference));
+    if (newLeading >= leading && newTrailing >= trailing) {
+      // The meaningful bits fit the previous window.
+      writer.write(0, 1);
+      writer.write(difference >> trailing, 64 - leading - trailing);
+      return;
+    }
+    leading = newLeading;
+    trailing = newTrailing;
+    const unsigned meaningful = 64 - leading - trailing;
+    writer.write(1, 1);
+    writer.write(leading, 5);
+    writer.write(meaningful - 1, 6);
+    writer.write(difference >> trailing, meaningful);
+  }
+};
+
+/** @brief Decoder matching XorEncoder. */
+class XorDecoder {
+ private:
+  BitReader& reader;
+  std::uint64_t previous;
+  unsigned leading;
+  unsigned trailing;
+  bool started;
+
+ public:
+  explicit XorDecoder(BitReader& reader)
+      : reader(reader), previous(0), leading(0), trailing(0), started(false) {}
+
+  double next() {
+    if (!started) {
+      previous = reader.read(64);
+      started = true;
+      return doubleOf(previous);
+    }
+    if (!reader.readBit()) {
+      return doubleOf(previous);
+    }
+    if (reader.readBit()) {
+      leading = static_cast<unsigned>(reader.read(5));
+      const unsigned meaningful = static_cast<unsigned>(reader.read(6)) + 1;
+      trailing = 64 - leading - meaningful;
+    }
+    previous ^= reader.read(64 - leading - trailing) << trailing;
+    return doubleOf(previous);
+  }
+};
+
+unsigned widthFor(const std::size_t values) {
+  unsigned width = 0;
+  while ((std::size_t(1) << width) < values) {
+    ++width;
+  }
+  return width;
+}
+
+bool isSingleReading(const TemperatureAggregate& aggregate, const double temperature) {
+  const std::uint64_t bits = bitsOf(temperature);
+  return aggregate.count == 1 && bitsOf(aggregate.minimum) == bits &&
+         bitsOf(aggregate.maximum) == bits && bitsOf(aggregate.mean) == bits &&
+         bitsOf(aggregate.last) == bits;
+}
+
+bool isEmpty(const TemperatureAggregate& aggregate) {
+  return aggregate.count == 0 && bitsOf(aggregate.minimum) == 0 &&
+         bitsOf(aggregate.maximum) == 0 && bitsOf(aggregate.mean) == 0 &&
+         bitsOf(aggregate.last) == 0;
+}
+
+bool isNoSample(const SampleReading& reading) {
+  return !reading.collected && bitsOf(reading.wavelength) == 0 &&
+         bitsOf(reading.intensity) == 0;
+}
+
+template <typename T>
+std::size_t capacityBytes(const std::vector<T>& values) {
+  return values.capacity() * sizeof(T);
+}
+
+template <typename T>
+void put(std::string& bytes, const T value) {
+  bytes.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/** @brief Appends a vector as its length followed by its elements. */
+template <typename T>
+void putVector(std::string& bytes, const std::vector<T>& values) {
+  put(bytes, static_cast<std::uint64_t>(values.size()));
+  bytes.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+/** @brief Reads values back in the order they were put. */
+class ByteReader {
+ private:
+  const std::string& bytes;
+  std::size_t offset;
+
+  void need(const std::size_t size) const {
+    if (size > bytes.size() - offset) {
+      throw std::runtime_error("Compressed SOL block is truncated");
+    }
+  }
+
+ public:
+  explicit ByteReader(const std::string& bytes) : bytes(bytes), offset(0) {}
+
+  template <typename T>
+  T get() {
+    need(sizeof(T));
+    T value;
+    std::memcpy(&value, bytes.data() + offset, sizeof(value));
+    offset += sizeof(value);
+    return value;
+  }
+
+  template <typename T>
+  std::vector<T> getVector() {
+    const std::uint64_t size = get<std::uint64_t>();
+    need(static_cast<std::size_t>(size) * sizeof(T));
+    std::vector<T> values(static_cast<std::size_t>(size));
+    std::memcpy(values.data(), bytes.data() + offset, values.size() * sizeof(T));
+    offset += values.size() * sizeof(T);
+    return values;
+  }
+};
+}  // namespace
+
+CompressedSOLBlock::CompressedSOLBlock()
+    : rows(0), firstSol(0), solDelta(0), constantSolDelta(true), elementWidth(0) {}
+
+CompressedSOLBlock CompressedSOLBlock::encode(const SOLColumnStore& source,
+                                              const std::size_t first,
+                                              const std::size_t count) {
+  CompressedSOLBlock block;
+  block.rows = count;
+  if (count == 0) {
+    return block;
+  }
+  const int* sols = source.getSolNumbers().data() + first;
+  const double* temperatures = source.getTemperatures().data() + first;
+  const double* distances = source.getDistances().data() + first;
+  const std::uint8_t* directions = source.getDirections().data() + first;
+  const std::int16_t* elementIds = source.getElementIds().data() + first;
+  const TemperatureAggregate* aggregates = source.getTemperatureAggregates().data() + first;
+  const SampleReading* readings = source.getSampleReadings().data() + first;
+
+  block.firstSol = sols[0];
+  block.solDelta = count > 1 ? sols[1] - sols[0] : 0;
+  for (std::size_t i = 1; i < count && block.constantSolDelta; ++i) {
+    block.constantSolDelta = sols[i] - sols[i - 1] == block.solDelta;
+  }
+  if (!block.constantSolDelta) {
+    for (std::size_t i = 1; i < count; ++i) {
+      const std::int64_t delta = static_cast<std::int64_t>(sols[i]) - sols[i - 1];
+      std::uint64_t zigzag = (static_cast<std::uint64_t>(delta) << 1) ^
+                             static_cast<std::uint64_t>(delta >> 63);
+      while (zigzag >= 0x80) {
+        block.solDeltas.push_back(static_cast<std::uint8_t>(zigzag | 0x80));
+        zigzag >>= 7;
+      }
+      block.solDeltas.push_back(static_cast<std::uint8_t>(zigzag));
+    }
+  }
+
+  BitWriter temperatureWriter(block.temperatureBits);
+  XorEncoder temperatureEncoder(temperatureWriter);
+  BitWriter distanceWriter(block.distanceBits);
+  XorEncoder distanceEncoder(distanceWriter);
+  BitWriter directionWriter(block.directionBits);
+  for (std::size_t i = 0; i < count; ++i) {
+    temperatureEncoder.add(temperatures[i]);
+    // Alternating still and moving SOLs would defeat the XOR window, so
+    // zero distances only cost their flag.
+    if (bitsOf(distances[i]) == 0) {
+      distanceWriter.write(0, 1);
+    } else {
+      distanceWriter.write(1, 1);
+      distanceEncoder.add(distances[i]);
+    }
+    directionWriter.write(directions[i], DIRECTION_WIDTH);
+  }
+
+  std::vector<std::uint32_t> elementIndexes(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::vector<std::int16_t>::const_iterator found =
+        std::find(block.elementDictionary.begin(), block.elementDictionary.end(),
+                  elementIds[i]);
+    elementIndexes[i] = static_cast<std::uint32_t>(found - block.elementDictionary.begin());
+    if (found == block.elementDictionary.end()) {
+      block.elementDictionary.push_back(elementIds[i]);
+    }
+  }
+  block.elementWidth = widthFor(block.elementDictionary.size());
+  BitWriter elementWriter(block.elementBits);
+  for (std::size_t i = 0; i < count; ++i) {
+    elementWriter.write(elementIndexes[i], block.elementWidth);
+  }
+
+  BitWriter aggregateWriter(block.aggregateBits);
+  BitWriter sampleWriter(block.sampleBits);
+  XorEncoder wavelengthEncoder(sampleWriter);
+  XorEncoder intensityEncoder(sampleWriter);
+  for (std::size_t i = 0; i < count; ++i) {
+    const TemperatureAggregate& aggregate = aggregates[i];
+    if (isSingleReading(aggregate, temperatures[i])) {
+      aggregateWriter.write(1, 1);
+    } else if (isEmpty(aggregate)) {
+      aggregateWriter.write(0b10, 2);
+    } else {
+      aggregateWriter.write(0b00, 2);
+      aggregateWriter.write(aggregate.count, 64);
+      aggregateWriter.write(bitsOf(aggregate.minimum), 64);
+      aggregateWriter.write(bitsOf(aggregate.maximum), 64);
+      aggregateWriter.write(bitsOf(aggregate.mean), 64);
+      aggregateWriter.write(bitsOf(aggregate.last), 64);
+    }
+
+    const SampleReading& reading = readings[i];
+    if (isNoSample(reading)) {
+      sampleWriter.write(0, 1);
+    } else {
+      sampleWriter.write(1, 1);
+      sampleWriter.write(reading.collected ? 1 : 0, 1);
+      wavelengthEncoder.add(reading.wavelength);
+      intensityEncoder.add(reading.intensity);
+    }
+  }
+
+  block.solDeltas.shrink_to_fit();
+  block.temperatureBits.shrink_to_fit();
+  block.distanceBits.shrink_to_fit();
+  block.directionBits.shrink_to_fit();
+  block.elementDictionary.shrink_to_fit();
+  block.elementBits.shrink_to_fit();
+  block.aggregateBits.shrink_to_fit();
+  block.sampleBits.shrink_to_fit();
+  return block;
+}
+
+void CompressedSOLBlock::decode(SOLColumnStore& target) const {
+  if (rows == 0) {
+    return;
+  }
+  const SOLColumnPointers out = target.grow(rows);
+
+  out.solNumbers[0] = firstSol;
+  if (constantSolDelta) {
+    for (std::size_t i = 1; i < rows; ++i) {
+      out.solNumbers[i] = out.solNumbers[i - 1] + solDelta;
+    }
+  } else {
+    std::size_t byte = 0;
+    for (std::size_t i = 1; i < rows; ++i) {
+      std::uint64_t zigzag = 0;
+      unsigned shift = 0;
+      std::uint8_t next;
+      do {
+        next = solDeltas[byte++];
+        zigzag |= static_cast<std::uint64_t>(next & 0x7F) << shift;
+        shift += 7;
+      } while (next & 0x80);
+      const std::int64_t delta =
+          static_cast<std::int64_t>(zigzag >> 1) ^ -static_cast<std::int64_t>(zigzag & 1);
+      out.solNumbers[i] = static_cast<int>(out.solNumbers[i - 1] + delta);
+    }
+  }
+
+  BitReader temperatureReader(temperatureBits);
+  XorDecoder temperatureDecoder(temperatureReader);
+  BitReader distanceReader(distanceBits);
+  XorDecoder distanceDecoder(distanceReader);
+  BitReader directionReader(directionBits);
+  BitReader elementReader(elementBits);
+  for (std::size_t i = 0; i < rows; ++i) {
+    out.temperatures[i] = temperatureDecoder.next();
+    out.distances[i] = distanceReader.readBit() ? distanceDecoder.next() : 0.0;
+    out.directions[i] = static_cast<std::uint8_t>(directionReader.read(DIRECTION_WIDTH));
+    out.elementIds[i] = elementDictionary[elementReader.read(elementWidth)];
+  }
+
+  BitReader aggregateReader(aggregateBits);
+  BitReader sampleReader(sampleBits);
+  XorDecoder wavelengthDecoder(sampleReader);
+  XorDecoder intensityDecoder(sampleReader);
+  for (std::size_t i = 0; i < rows; ++i) {
+    TemperatureAggregate& aggregate = out.temperatureAggregates[i];
+    if (aggregateReader.readBit()) {
+      aggregate.count = 1;
+      aggregate.minimum = aggregate.maximum = aggregate.mean = aggregate.last =
+          out.temperatures[i];
+    } else if (!aggregateReader.readBit()) {
+      aggregate.count = static_cast<std::size_t>(aggregateReader.read(64));
+      aggregate.minimum = doubleOf(aggregateReader.read(64));
+      aggregate.maximum = doubleOf(aggregateReader.read(64));
+      aggregate.mean = doubleOf(aggregateReader.read(64));
+      aggregate.last = doubleOf(aggregateReader.read(64));
+    }
+
+    if (sampleReader.readBit()) {
+      SampleReading& reading = out.sampleReadings[i];
+      reading.collected = sampleReader.readBit();
+      reading.wavelength = wavelengthDecoder.next();
+      reading.intensity = intensityDecoder.next();
+    }
+  }
+}
+
+std::string CompressedSOLBlock::serialize() const {
+  std::string bytes;
+  bytes.reserve(getFootprint());
+  put(bytes, static_cast<std::uint64_t>(rows));
+  put(bytes, static_cast<std::int32_t>(firstSol));
+  put(bytes, static_cast<std::int32_t>(solDelta));
+  put(bytes, static_cast<std::uint8_t>(constantSolDelta));
+  put(bytes, static_cast<std::uint8_t>(elementWidth));
+  putVector(bytes, solDeltas);
+  putVector(bytes, temperatureBits);
+  putVector(bytes, distanceBits);
+  putVector(bytes, directionBits);
+  putVector(bytes, elementDictionary);
+  putVector(bytes, elementBits);
+  putVector(bytes, aggregateBits);
+  putVector(bytes, sampleBits);
+  return bytes;
+}
+
+CompressedSOLBlock CompressedSOLBlock::deserialize(const std::string& bytes) {
+  ByteReader reader(bytes);
+  CompressedSOLBlock block;
+  block.rows = static_cast<std::size_t>(reader.get<std::uint64_t>());
+  block.firstSol = reader.get<std::int32_t>();
+  block.solDelta = reader.get<std::int32_t>();
+  block.constantSolDelta = reader.get<std::uint8_t>() != 0;
+  block.elementWidth = reader.get<std::uint8_t>();
+  block.solDeltas = reader.getVector<std::uint8_t>();
+  block.temperatureBits = reader.getVector<std::uint64_t>();
+  block.distanceBits = reader.getVector<std::uint64_t>();
+  block.directionBits = reader.getVector<std::uint64_t>();
+  block.elementDictionary = reader.getVector<std::int16_t>();
+  block.elementBits = reader.getVector<std::uint64_t>();
+  block.aggregateBits = reader.getVector<std::uint64_t>();
+  block.sampleBits = reader.getVector<std::uint64_t>();
+  return block;
+}
+
+std::size_t CompressedSOLBlock::size() const {
+  return rows;
+}
+
+int CompressedSOLBlock::getFirstSol() const {
+  return firstSol;
+}
+
+std::size_t CompressedSOLBlock::getFootprint() const {
+  return sizeof(*this) + capacityBytes(solDeltas) + capacityBytes(temperatureBits) +
+         capacityBytes(distanceBits) + capacityBytes(directionBits) +
+         capacityBytes(elementDictionary) + capacityBytes(elementBits) +
+         capacityBytes(aggregateBits) + capacityBytes(sampleBits);
+}
@@ -4,30 +4,460 @@
  */
 
 #include "Data/DataStorage.h"
+#include <algorithm>
+#include <functional>
 #include <stdexcept>
+#include <utility>
+#include "Utility/MakeUnique.h"
 
-void DataStorage::storeSOLData(const SOLData& solData) {
-  masterSOLData.push_back(solData);
+namespace {
+const std::size_t NO_BLOCK = static_cast<std::size_t>(-1);
+const std::size_t COLUMN_ROW_BYTES = sizeof(int) + 2 * sizeof(double) + sizeof(std::uint8_t) +
+                                     sizeof(std::int16_t) + sizeof(TemperatureAggregate) +
+                                     sizeof(SampleReading);
+}  // namespace
+
+DataStorage::DataStorage(const DuplicateSOLPolicy duplicatePolicy,
+                         const SOLStorageLayout layout)
+    : duplicatePolicy(duplicatePolicy),
+      layout(layout),
+      sealedRows(0),
+      decodedBlockIndex(NO_BLOCK),
+      materializedValid(false),
+      columnZonesValid(false),
+      memoryBudget(0),
+      residentBlockBytes(0) {}
+
+std::size_t DataStorage::blockOf(const std::size_t position) const {
+  return static_cast<std::size_t>(
+      std::upper_bound(blockStarts.begin(), blockStarts.end(), position) -
+      blockStarts.begin() - 1);
+}
+
+std::shared_ptr<const CompressedSOLBlock> DataStorage::loadBlock(
+    const std::size_t blockIndex) const {
+  SealedBlock& sealed = sealedBlocks[blockIndex];
+  if (sealed.resident) {
+    recentBlocks.splice(recentBlocks.begin(), recentBlocks, sealed.recent);
+    return sealed.resident;
+  }
+  sealed.resident = std::make_shared<const CompressedSOLBlock>(CompressedSOLBlock::deserialize(
+      spillFile->read(sealed.spillOffset, sealed.spillLength)));
+  sealed.recent = recentBlocks.insert(recentBlocks.begin(), blockIndex);
+  residentBlockBytes += sealed.footprint;
+  enforceBudget();
+  return sealed.resident;
+}
+
+std::shared_ptr<const CompressedSOLBlock> DataStorage::peekBlock(
+    const std::size_t blockIndex) const {
+  const SealedBlock& sealed = sealedBlocks[blockIndex];
+  if (sealed.resident) {
+    return sealed.resident;
+  }
+  return std::make_shared<const CompressedSOLBlock>(CompressedSOLBlock::deserialize(
+      spillFile->read(sealed.spillOffset, sealed.spillLength)));
+}
+
+void DataStorage::setBlock(const std::size_t blockIndex, CompressedSOLBlock&& block) {
+  if (blockIndex == sealedBlocks.size()) {
+    SealedBlock sealed;
+    sealed.footprint = 0;
+    sealed.spillOffset = 0;
+    sealed.spillLength = 0;
+    sealedBlocks.push_back(sealed);
+  }
+  SealedBlock& sealed = sealedBlocks[blockIndex];
+  if (sealed.resident) {
+    residentBlockBytes -= sealed.footprint;
+    recentBlocks.splice(recentBlocks.begin(), recentBlocks, sealed.recent);
+  } else {
+    sealed.recent = recentBlocks.insert(recentBlocks.begin(), blockIndex);
+  }
+  sealed.footprint = block.getFootprint();
+  sealed.resident = std::make_shared<const CompressedSOLBlock>(std::move(block));
+  if (sealed.spillLength != 0) {
+    // The spilled copy is stale; its range is reused by the next spill.
+    spillFile->release(sealed.spillOffset, sealed.spillLength);
+    sealed.spillLength = 0;
+  }
+  residentBlockBytes += sealed.footprint;
+  enforceBudget();
+}
+
+void DataStorage::enforceBudget() const {
+  if (memoryBudget == 0) {
+    return;
+  }
+  // The most recently used block is the one being accessed, so it stays.
+  while (recentBlocks.size() > 1 && getResidentBytes() > memoryBudget) {
+    SealedBlock& victim = sealedBlocks[recentBlocks.back()];
+    if (victim.spillLength == 0) {
+      const std::string bytes = victim.resident->serialize();
+      victim.spillOffset = spillFile->write(bytes);
+      victim.spillLength = bytes.size();
+    }
+    victim.resident.reset();
+    residentBlockBytes -= victim.footprint;
+    recentBlocks.pop_back();
+  }
+}
+
+std::size_t DataStorage::insertionPoint(const int solNumber) const {
+  if (memoryBudget == 0) {
+    return index.insertionPoint(solNumber);
+  }
+  // The first block whose last SOL is not below solNumber holds its place.
+  const std::vector<SOLZoneMap>::const_iterator zone = std::lower_bound(
+      sealedZones.begin(), sealedZones.end(), static_cast<double>(solNumber),
+      [](const SOLZoneMap& candidate, const double sol) {
+        return candidate.getMaximum(SOLColumn::SolNumber) < sol;
+      });
+  if (zone == sealedZones.end()) {
+    const ColumnSpan<int> tail = columns.getSolNumbers();
+    return sealedRows + static_cast<std::size_t>(
+                            std::lower_bound(tail.begin(), tail.end(), solNumber) - tail.begin());
+  }
+  const std::size_t blockIndex = static_cast<std::size_t>(zone - sealedZones.begin());
+  if (solNumber <= zone->getMinimum(SOLColumn::SolNumber)) {
+    return blockStarts[blockIndex];
+  }
+  const ColumnSpan<int> block = decodeBlock(blockIndex).getSolNumbers();
+  return blockStarts[blockIndex] + static_cast<std::size_t>(
+                                       std::lower_bound(block.begin(), block.end(), solNumber) -
+                                       block.begin());
+}
+
+std::size_t DataStorage::find(const int solNumber) const {
+  if (memoryBudget == 0) {
+    return index.find(solNumber);
+  }
+  const std::size_t position = insertionPoint(solNumber);
+  if (position >= size()) {
+    return SOLIndex::NOT_FOUND;
+  }
+  int stored;
+  if (position >= sealedRows) {
+    stored = columns.getSolNumbers()[position - sealedRows];
+  } else {
+    const std::size_t blockIndex = blockOf(position);
+    stored = decodeBlock(blockIndex).getSolNumbers()[position - blockStarts[blockIndex]];
+  }
+  return stored == solNumber ? position : SOLIndex::NOT_FOUND;
+}
+
+void DataStorage::requireUnbounded() const {
+  if (memoryBudget != 0) {
+    throw std::logic_error("Whole-mission views are unavailable under a memory budget");
+  }
+}
+
+const SOLColumnStore& DataStorage::decodeBlock(const std::size_t blockIndex) const {
+  if (decodedBlockIndex != blockIndex) {
+    decodedBlock.clear();
+    loadBlock(blockIndex)->decode(decodedBlock);
+    decodedBlockIndex = blockIndex;
+    enforceBudget();
+  }
+  return decodedBlock;
+}
+
+SOLData DataStorage::rowAt(const std::size_t position) const {
+  if (position >= sealedRows) {
+    return columns.row(position - sealedRows);
+  }
+  const std::size_t blockIndex = blockOf(position);
+  return decodeBlock(blockIndex).row(position - blockStarts[blockIndex]);
+}
+
+void DataStorage::modifySealed(const std::size_t position, const SOLData& solData,
+                               const bool replace) {
+  const std::size_t blockIndex = blockOf(position);
+  SOLColumnStore rows;
+  loadBlock(blockIndex)->decode(rows);
+  const std::size_t offset = position - blockStarts[blockIndex];
+  if (replace) {
+    rows.replace(offset, solData);
+  } else {
+    rows.insert(offset, solData);
+    for (std::size_t later = blockIndex + 1; later < blockStarts.size(); ++later) {
+      ++blockStarts[later];
+    }
+    ++sealedRows;
+  }
+  sealedZones[blockIndex] = SOLZoneMap::of(rows, 0, rows.size());
+  setBlock(blockIndex, CompressedSOLBlock::encode(rows, 0, rows.size()));
+}
+
+void DataStorage::sealFullTail() {
+  if (layout != SOLStorageLayout::CompressedBlocks || columns.size() < SOL_BLOCK_SIZE) {
+    return;
+  }
+  CompressedSOLBlock block = CompressedSOLBlock::encode(columns, 0, columns.size());
+  blockStarts.push_back(sealedRows);
+  sealedZones.push_back(SOLZoneMap::of(columns, 0, columns.size()));
+  sealedRows += columns.size();
+  columns.clear();
+  setBlock(sealedBlocks.size(), std::move(block));
+}
+
+const SOLColumnStore& DataStorage::contiguous() const {
+  requireUnbounded();
+  if (sealedBlocks.empty()) {
+    return columns;
+  }
+  if (!materializedValid) {
+    materialized.clear();
+    materialized.reserve(size());
+    for (const SealedBlock& sealed : sealedBlocks) {
+      sealed.resident->decode(materialized);
+    }
+    for (std::size_t position = 0; position < columns.size(); ++position) {
+      materialized.append(columns.row(position));
+    }
+    materializedValid = true;
+  }
+  return materialized;
+}
+
+void DataStorage::invalidateDecodes() {
+  decodedBlockIndex = NO_BLOCK;
+  materializedValid = false;
+  columnZonesValid = false;
+}
+
+void DataStorage::setMemoryBudget(const std::size_t bytes, const std::string& spillDirectory) {
+  if (layout != SOLStorageLayout::CompressedBlocks) {
+    throw std::invalid_argument("A memory budget needs the compressed storage layout");
+  }
+  if (bytes < MIN_MEMORY_BUDGET) {
+    throw std::invalid_argument("Memory budget is below the minimum");
+  }
+  if (!spillFile) {
+    spillFile = make_unique_ptr<BlockSpillFile>(spillDirectory);
+  }
+  memoryBudget = bytes;
+  index = SOLIndex();
+  postings = SOLInvertedIndex();
+  materialized = SOLColumnStore();
+  invalidateDecodes();
+  enforceBudget();
+}
+
+bool DataStorage::storeSOLData(const SOLData& solData) {
+  const int solNumber = solData.getSolNumber();
+  const std::size_t existing = find(solNumber);
+  if (existing != SOLIndex::NOT_FOUND) {
+    switch (duplicatePolicy) {
+      case DuplicateSOLPolicy::Replace:
+        if (memoryBudget == 0) {
+          postings.remove(rowAt(existing));
+          postings.add(solData);
+        }
+        invalidateDecodes();
+        if (existing >= sealedRows) {
+          columns.replace(existing - sealedRows, solData);
+        } else {
+          modifySealed(existing, solData, true);
+        }
+        return true;
+      case DuplicateSOLPolicy::Throw:
+        throw std::invalid_argument("SOL number already stored");
+      case DuplicateSOLPolicy::Reject:
+        break;
+    }
+    return false;
+  }
+  const std::size_t position = insertionPoint(solNumber);
+  invalidateDecodes();
+  if (position >= sealedRows) {
+    columns.insert(position - sealedRows, solData);
+  } else {
+    modifySealed(position, solData, false);
+  }
+  if (memoryBudget == 0) {
+    index.insert(solNumber, position);
+    postings.add(solData);
+  }
+  sealFullTail();
+  enforceBudget();
+  return true;
+}
+
+void DataStorage::loadArchive(const std::shared_ptr<const SOLArchive>& archive) {
+  columns = SOLColumnStore();
+  index = SOLIndex();
+  postings = SOLInvertedIndex();
+  for (const SealedBlock& sealed : sealedBlocks) {
+    if (sealed.spillLength != 0) {
+      spillFile->release(sealed.spillOffset, sealed.spillLength);
+    }
+  }
+  sealedBlocks.clear();
+  blockStarts.clear();
+  sealedZones.clear();
+  recentBlocks.clear();
+  residentBlockBytes = 0;
+  sealedRows = 0;
+  invalidateDecodes();
+  const ColumnSpan<int> solNumbers = archive->getSolNumbers();
+  if (std::adjacent_find(solNumbers.begin(), solNumbers.end(),
+                         std::greater_equal<int>()) == solNumbers.end()) {
+    columns.attach(archive);
+    const ColumnSpan<std::int16_t> elementIds = archive->getElementIds();
+    const ColumnSpan<std::uint8_t> directions = archive->getDirections();
+    for (std::size_t position = 0; memoryBudget == 0 && position < solNumbers.size();
+         ++position) {
+      index.insert(solNumbers[position], position);
+      postings.add(solNumbers[position], elementIds[position], directions[position]);
+    }
+    if (layout == SOLStorageLayout::CompressedBlocks) {
+      const SOLColumnStore mapped = columns;
+      const std::size_t fullRows = mapped.size() - mapped.size() % SOL_BLOCK_SIZE;
+      for (std::size_t first = 0; first < fullRows; first += SOL_BLOCK_SIZE) {
+        blockStarts.push_back(first);
+        sealedZones.push_back(SOLZoneMap::of(mapped, first, SOL_BLOCK_SIZE));
+        setBlock(sealedBlocks.size(), CompressedSOLBlock::encode(mapped, first, SOL_BLOCK_SIZE));
+      }
+      sealedRows = fullRows;
+      columns = SOLColumnStore();
+      for (std::size_t position = fullRows; position < mapped.size(); ++position) {
+        columns.append(mapped.row(position));
+      }
+    }
+    return;
+  }
+  SOLColumnStore archived;
+  archived.attach(archive);
+  for (std::size_t position = 0; position < archived.size(); ++position) {
+    storeSOLData(archived.row(position));
+  }
 }
 
 std::vector<SOLData> DataStorage::getAllSOLData() const {
-  return masterSOLData;
+  std::vector<SOLData> allSOLData;
+  allSOLData.reserve(size());
+  forEachSOLData([&allSOLData](const SOLData& solData) { allSOLData.push_back(solData); });
+  return allSOLData;
+}
+
+SOLDataView DataStorage::view() const {
+  const SOLColumnStore& rows = contiguous();
+  return SOLDataView(rows, 0, rows.size());
+}
+
+const SOLColumnStore& DataStorage::getColumns() const {
+  return contiguous();
+}
+
+SOLDataView DataStorage::getSOLRange(const int firstSol, const int lastSol) const {
+  requireUnbounded();
+  const std::pair<std::size_t, std::size_t> positions = index.range(firstSol, lastSol);
+  return SOLDataView(contiguous(), positions.first, positions.second);
+}
+
+const SOLInvertedIndex& DataStorage::getInvertedIndex() const {
+  requireUnbounded();
+  return postings;
+}
+
+bool DataStorage::findSOLData(const int solNumber, SOLData& solData) const {
+  const std::size_t position = find(solNumber);
+  if (position == SOLIndex::NOT_FOUND) {
+    return false;
+  }
+  solData = rowAt(position);
+  return true;
 }
 
 SOLData DataStorage::getSOLData(const int solNumber) const {
-  for (const auto& solData : masterSOLData) {
-    if (solData.getSolNumber() == solNumber) {
-      return solData;
+  const std::size_t position = find(solNumber);
+  if (position == SOLIndex::NOT_FOUND) {
+    throw std::out_of_range("SOL number not found");
+  }
+  return rowAt(position);
+}
+
+void DataStorage::forEachSOLData(
+    const std::function<void(const SOLData&)>& visitor) const {
+  forEachBlock([&visitor](const SOLColumnStore& rows) {
+    for (std::size_t position = 0; position < rows.size(); ++position) {
+      visitor(rows.row(position));
+    }
+  });
+}
+
+void DataStorage::forEachBlock(
+    const std::function<void(const SOLColumnStore&)>& visitor) const {
+  // A scratch store of its own, so visitors may still call the row APIs.
+  SOLColumnStore block;
+  block.reserve(sealedBlocks.empty() ? 0 : SOL_BLOCK_SIZE);
+  for (std::size_t blockIndex = 0; blockIndex < sealedBlocks.size(); ++blockIndex) {
+    block.clear();
+    peekBlock(blockIndex)->decode(block);
+    visitor(block);
+  }
+  if (columns.size() > 0) {
+    visitor(columns);
+  }
+}
+
+void DataStorage::forEachZone(const std::function<bool(const SOLZoneMap&)>& mayMatch,
+                              const std::function<void(const SOLDataView&)>& visitor) const {
+  SOLColumnStore block;
+  for (std::size_t blockIndex = 0; blockIndex < sealedBlocks.size(); ++blockIndex) {
+    if (!mayMatch(sealedZones[blockIndex])) {
+      continue;
+    }
+    block.clear();
+    peekBlock(blockIndex)->decode(block);
+    visitor(SOLDataView(block, 0, block.size()));
+  }
+  if (!columnZonesValid) {
+    columnZones.clear();
+    for (std::size_t first = 0; first < columns.size(); first += SOL_BLOCK_SIZE) {
+      columnZones.push_back(
+          SOLZoneMap::of(columns, first, std::min(SOL_BLOCK_SIZE, columns.size() - first)));
+    }
+    columnZonesValid = true;
+  }
+  for (std::size_t zone = 0; zone < columnZones.size(); ++zone) {
+    if (mayMatch(columnZones[zone])) {
+      const std::size_t first = zone * SOL_BLOCK_SIZE;
+      visitor(SOLDataView(columns, first, std::min(columns.size(), first + SOL_BLOCK_SIZE)));
     }
   }
-  throw std::out_of_range("SOL number not found");
 }
 
-std::vector<double> createMasterTemperatureData(const std::vector<SOLData>& solData) {
-  std::vector<double> MasterTemperatureData;
-  for (const auto& data : solData) {
-    MasterTemperatureData.push_back(data.getTemperatureData());
+std::size_t DataStorage::getFootprint() const {
+  std::size_t footprint = columns.isAttached() ? 0 : columns.size() * COLUMN_ROW_BYTES;
+  for (const SealedBlock& sealed : sealedBlocks) {
+    footprint += sealed.footprint;
   }
-  return MasterTemperatureData;
+  return footprint;
 }
 
+std::size_t DataStorage::getResidentBytes() const {
+  std::size_t resident = columns.isAttached() ? 0 : columns.size() * COLUMN_ROW_BYTES;
+  resident += residentBlockBytes;
+  if (decodedBlockIndex != NO_BLOCK) {
+    resident += decodedBlock.size() * COLUMN_ROW_BYTES;
+  }
+  if (materializedValid) {
+    resident += materialized.size() * COLUMN_ROW_BYTES;
+  }
+  return resident;
+}
+
+std::uint64_t DataStorage::getSpilledBytes() const {
+  return spillFile ? spillFile->size() : 0;
+}
+
+std::size_t DataStorage::size() const {
+  return sealedRows + columns.size();
+}
+
+std::vector<double> createMasterTemperatureData(const SOLDataView& solData) {
+  const ColumnSpan<double> temperatures = solData.getTemperatures();
+  return std::vector<double>(temperatures.begin(), temperatures.end());
+}
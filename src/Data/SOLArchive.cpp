@@ -0,0 +1,484 @@
+/**
+ * @file SOLArchive.cpp
+ * @brief Implementation of the SOLArchive and SOLArchiveWriter classes.
+ */
+
+#include "Data/SOLArchive.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include "Utility/Checksum.h"
+
+namespace {
+const char MANIFEST_FILE[] = "MANIFEST";
+const char MANIFEST_MAGIC[8] = {'E', 'N', 'I', 'G', 'M', 'A', 'S', 'A'};
+const std::uint32_t BYTE_ORDER_MARK = 0x01020304u;
+
+/** @brief Column files, in SOLColumnStore column order. */
+struct ColumnFile {
+  const char* name;
+  std::uint32_t elementSize;
+};
+
+const std::size_t COLUMN_COUNT = 7;
+const ColumnFile COLUMN_FILES[COLUMN_COUNT] = {
+    {"sol_numbers.col", sizeof(int)},
+    {"temperatures.col", sizeof(double)},
+    {"distances.col", sizeof(double)},
+    {"directions.col", sizeof(std::uint8_t)},
+    {"element_ids.col", sizeof(std::int16_t)},
+    {"temperature_aggregates.col", sizeof(TemperatureAggregate)},
+    {"sample_readings.col", sizeof(SampleReading)}};
+
+/** @brief Fixed MANIFEST prefix; the element sizes pin the row layout. */
+struct ManifestHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byteOrder;
+  std::uint32_t columnCount;
+  std::uint32_t elementSizes[COLUMN_COUNT];
+  std::uint32_t checksum; /**< CRC-32C of the fields above. */
+};
+
+/** @brief Appended to the MANIFEST once a group of rows is durable. */
+struct CommitRecord {
+  std::uint64_t rows; /**< Total committed rows after this commit. */
+  std::uint32_t columnChecksums[COLUMN_COUNT]; /**< CRC-32C of each new chunk. */
+  std::uint32_t checksum; /**< CRC-32C of the fields above. */
+};
+
+static_assert(sizeof(ManifestHeader) == 52, "ManifestHeader must not be padded");
+static_assert(sizeof(CommitRecord) == 40, "CommitRecord must not be padded");
+
+/** @brief What a MANIFEST says about its archive. */
+struct ManifestState {
+  bool hasHeader = false;
+  std::vector<CommitRecord> commits;
+  std::size_t validBytes = 0; /**< Length up to the last valid record. */
+  std::size_t rows = 0;
+};
+
+/** @brief Closes a file descriptor when leaving scope. */
+struct ScopedDescriptor {
+  int descriptor;
+  explicit ScopedDescriptor(const int descriptor) : descriptor(descriptor) {}
+  ~ScopedDescriptor() {
+    if (descriptor >= 0) {
+      ::close(descriptor);
+    }
+  }
+};
+
+[[noreturn]] void throwSystemError(const std::string& what) {
+  throw std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+std::string pathOf(const std::string& directory, const char* file) {
+  return directory + "/" + file;
+}
+
+ManifestHeader makeHeader() {
+  ManifestHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, MANIFEST_MAGIC, sizeof(header.magic));
+  header.version = SOL_ARCHIVE_VERSION;
+  header.byteOrder = BYTE_ORDER_MARK;
+  header.columnCount = COLUMN_COUNT;
+  for (std::size_t column = 0; column < COLUMN_COUNT; ++column) {
+    header.elementSizes[column] = COLUMN_FILES[column].elementSize;
+  }
+  header.checksum = Checksum::crc32c(&header, offsetof(ManifestHeader, checksum));
+  return header;
+}
+
+void readAll(const int descriptor, void* data, std::size_t size) {
+  char* bytes = static_cast<char*>(data);
+  off_t offset = 0;
+  while (size > 0) {
+    const ssize_t done = ::pread(descriptor, bytes, size, offset);
+    if (done < 0 && errno == EINTR) {
+      continue;
+    }
+    if (done <= 0) {
+      throwSystemError("Unable to read SOL archive");
+    }
+    bytes += done;
+    offset += done;
+    size -= static_cast<std::size_t>(done);
+  }
+}
+
+void writeAll(const int descriptor, const void* data, std::size_t size) {
+  const char* bytes = static_cast<const char*>(data);
+  while (size > 0) {
+    const ssize_t done = ::write(descriptor, bytes, size);
+    if (done < 0 && errno == EINTR) {
+      continue;
+    }
+    if (done < 0) {
+      throwSystemError("Unable to write SOL archive");
+    }
+    bytes += done;
+    size -= static_cast<std::size_t>(done);
+  }
+}
+
+void syncDescriptor(const int descriptor) {
+  if (::fdatasync(descriptor) != 0) {
+    throwSystemError("Unable to sync SOL archive");
+  }
+}
+
+std::size_t fileSize(const int descriptor) {
+  struct stat info;
+  if (::fstat(descriptor, &info) != 0) {
+    throwSystemError("Unable to stat SOL archive");
+  }
+  return static_cast<std::size_t>(info.st_size);
+}
+
+/**
+ * @brief Parses a MANIFEST, stopping at the first torn or corrupt record.
+ * @throw std::runtime_error if the header is corrupt or incompatible.
+ */
+ManifestState readManifest(const int descriptor) {
+  ManifestState state;
+  std::vector<char> bytes(fileSize(descriptor));
+  if (bytes.size() < sizeof(ManifestHeader)) {
+    return state;
+  }
+  readAll(descriptor, bytes.data(), bytes.size());
+
+  ManifestHeader header;
+  std::memcpy(&header, bytes.data(), sizeof(header));
+  if (std::memcmp(header.magic, MANIFEST_MAGIC, sizeof(header.magic)) != 0 ||
+      header.checksum != Checksum::crc32c(&header, offsetof(ManifestHeader, checksum))) {
+    throw std::runtime_error("SOL archive MANIFEST is corrupt");
+  }
+  const ManifestHeader expected = makeHeader();
+  if (std::memcmp(&header, &expected, sizeof(header)) != 0) {
+    throw std::runtime_error("SOL archive was written by an incompatible build");
+  }
+  state.hasHeader = true;
+  state.validBytes = sizeof(ManifestHeader);
+
+  while (state.validBytes + sizeof(CommitRecord) <= bytes.size()) {
+    CommitRecord record;
+    std::memcpy(&record, bytes.data() + state.validBytes, sizeof(record));
+    if (record.checksum != Checksum::crc32c(&record, offsetof(CommitRecord, checksum)) ||
+        record.rows <= state.rows) {
+      break;
+    }
+    state.commits.push_back(record);
+    state.rows = static_cast<std::size_t>(record.rows);
+    state.validBytes += sizeof(CommitRecord);
+  }
+  return state;
+}
+
+/** @brief Gets the bytes of every column of a store, in column order. */
+void collectColumns(const SOLColumnStore& store, const void* (&data)[COLUMN_COUNT]) {
+  data[0] = store.getSolNumbers().data();
+  data[1] = store.getTemperatures().data();
+  data[2] = store.getDistances().data();
+  data[3] = store.getDirections().data();
+  data[4] = store.getElementIds().data();
+  data[5] = store.getTemperatureAggregates().data();
+  data[6] = store.getSampleReadings().data();
+}
+}  // namespace
+
+SOLArchive::SOLArchive() : rows(0) {}
+
+SOLArchive::~SOLArchive() {
+  for (const Mapping& mapping : mappings) {
+    if (mapping.address != nullptr) {
+      ::munmap(mapping.address, mapping.length);
+    }
+  }
+}
+
+std::shared_ptr<const SOLArchive> SOLArchive::open(const std::string& directory,
+                                                   const bool verifyChecksums) {
+  std::shared_ptr<SOLArchive> archive(new SOLArchive());
+  {
+    const ScopedDescriptor manifest(
+        ::open(pathOf(directory, MANIFEST_FILE).c_str(), O_RDONLY | O_CLOEXEC));
+    if (manifest.descriptor < 0) {
+      throwSystemError("Unable to open SOL archive");
+    }
+    const ManifestState state = readManifest(manifest.descriptor);
+    if (!state.hasHeader) {
+      throw std::runtime_error("SOL archive MANIFEST is corrupt");
+    }
+    archive->rows = state.rows;
+
+    for (std::size_t column = 0; column < COLUMN_COUNT; ++column) {
+      const ScopedDescriptor file(::open(
+          pathOf(directory, COLUMN_FILES[column].name).c_str(), O_RDONLY | O_CLOEXEC));
+      if (file.descriptor < 0) {
+        throwSystemError("Unable to open SOL archive column");
+      }
+      const std::size_t length = archive->rows * COLUMN_FILES[column].elementSize;
+      if (fileSize(file.descriptor) < length) {
+        throw std::runtime_error("SOL archive column is truncated");
+      }
+      Mapping mapping = {nullptr, length};
+      if (length > 0) {
+        mapping.address =
+            ::mmap(nullptr, length, PROT_READ, MAP_SHARED, file.descriptor, 0);
+        if (mapping.address == MAP_FAILED) {
+          throwSystemError("Unable to map SOL archive column");
+        }
+      }
+      archive->mappings.push_back(mapping);
+      archive->columnData.push_back(mapping.address);
+    }
+
+    if (verifyChecksums) {
+      std::size_t firstRow = 0;
+      for (const CommitRecord& record : state.commits) {
+        const std::size_t count = static_cast<std::size_t>(record.rows) - firstRow;
+        for (std::size_t column = 0; column < COLUMN_COUNT; ++column) {
+          const std::size_t elementSize = COLUMN_FILES[column].elementSize;
+          const char* chunk = static_cast<const char*>(archive->columnData[column]) +
+                              firstRow * elementSize;
+          if (Checksum::crc32c(chunk, count * elementSize) !=
+              record.columnChecksums[column]) {
+            throw std::runtime_error("SOL archive checksum mismatch");
+          }
+        }
+        firstRow = static_cast<std::size_t>(record.rows);
+      }
+    }
+  }
+  return archive;
+}
+
+bool SOLArchive::exists(const std::string& directory) {
+  struct stat info;
+  return ::stat(pathOf(directory, MANIFEST_FILE).c_str(), &info) == 0;
+}
+
+std::size_t SOLArchive::size() const {
+  return rows;
+}
+
+template <typename T>
+ColumnSpan<T> SOLArchive::column(const std::size_t columnIndex) const {
+  return ColumnSpan<T>(static_cast<const T*>(columnData[columnIndex]), rows);
+}
+
+ColumnSpan<int> SOLArchive::getSolNumbers() const {
+  return column<int>(0);
+}
+
+ColumnSpan<double> SOLArchive::getTemperatures() const {
+  return column<double>(1);
+}
+
+ColumnSpan<double> SOLArchive::getDistances() const {
+  return column<double>(2);
+}
+
+ColumnSpan<std::uint8_t> SOLArchive::getDirections() const {
+  return column<std::uint8_t>(3);
+}
+
+ColumnSpan<std::int16_t> SOLArchive::getElementIds() const {
+  return column<std::int16_t>(4);
+}
+
+ColumnSpan<TemperatureAggregate> SOLArchive::getTemperatureAggregates() const {
+  return column<TemperatureAggregate>(5);
+}
+
+ColumnSpan<SampleReading> SOLArchive::getSampleReadings() const {
+  return column<SampleReading>(6);
+}
+
+SOLArchiveWriter::SOLArchiveWriter(const std::string& directory,
+                                   const std::size_t groupSize)
+    : directory(directory),
+      groupSize(groupSize),
+      manifestDescriptor(-1),
+      manifestBytes(0),
+      committedRows(0) {
+  if (groupSize == 0) {
+    throw std::invalid_argument("Archive group size must be at least 1");
+  }
+  if (::mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+    throwSystemError("Unable to create SOL archive");
+  }
+  try {
+    manifestDescriptor = ::open(pathOf(directory, MANIFEST_FILE).c_str(),
+                                O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (manifestDescriptor < 0) {
+      throwSystemError("Unable to open SOL archive");
+    }
+    const ManifestState state = readManifest(manifestDescriptor);
+    committedRows = state.rows;
+    manifestBytes = state.validBytes;
+    // Drop a torn record, or a torn header left by a crash during creation.
+    if (::ftruncate(manifestDescriptor, static_cast<off_t>(manifestBytes)) != 0) {
+      throwSystemError("Unable to truncate SOL archive");
+    }
+    if (!state.hasHeader) {
+      const ManifestHeader header = makeHeader();
+      writeAll(manifestDescriptor, &header, sizeof(header));
+      syncDescriptor(manifestDescriptor);
+      manifestBytes = sizeof(header);
+    }
+
+    for (std::size_t column = 0; column < COLUMN_COUNT; ++column) {
+      const int descriptor = ::open(pathOf(directory, COLUMN_FILES[column].name).c_str(),
+                                    O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+      if (descriptor < 0) {
+        throwSystemError("Unable to open SOL archive column");
+      }
+      columnDescriptors.push_back(descriptor);
+      const std::size_t length = committedRows * COLUMN_FILES[column].elementSize;
+      if (fileSize(descriptor) < length) {
+        throw std::runtime_error("SOL archive column is truncated");
+      }
+      // Rows past the last commit were never acknowledged.
+      if (::ftruncate(descriptor, static_cast<off_t>(length)) != 0) {
+        throwSystemError("Unable to truncate SOL archive column");
+      }
+    }
+
+    const ScopedDescriptor folder(::open(directory.c_str(), O_RDONLY | O_CLOEXEC));
+    if (folder.descriptor < 0 || ::fsync(folder.descriptor) != 0) {
+      throwSystemError("Unable to sync SOL archive directory");
+    }
+  } catch (...) {
+    closeFiles();
+    throw;
+  }
+  pending.reserve(groupSize);
+}
+
+SOLArchiveWriter::~SOLArchiveWriter() {
+  try {
+    commit();
+  } catch (const std::exception&) {
+    // Destructors must not throw; the uncommitted group is lost.
+  }
+  closeFiles();
+}
+
+void SOLArchiveWriter::closeFiles() {
+  for (const int descriptor : columnDescriptors) {
+    ::close(descriptor);
+  }
+  columnDescriptors.clear();
+  if (manifestDescriptor >= 0) {
+    ::close(manifestDescriptor);
+    manifestDescriptor = -1;
+  }
+}
+
+void SOLArchiveWriter::append(const SOLData& solData) {
+  pending.append(solData);
+  if (pending.size() >= groupSize) {
+    commit();
+  }
+}
+
+void SOLArchiveWriter::commit() {
+  const std::size_t count = pending.size();
+  if (count == 0) {
+    return;
+  }
+  const void* data[COLUMN_COUNT];
+  collectColumns(pending, data);
+  CommitRecord record;
+  std::memset(&record, 0, sizeof(record));
+  record.rows = committedRows + count;
+  try {
+    for (std::size_t column = 0; column < COLUMN_COUNT; ++column) {
+      const std::size_t bytes = count * COLUMN_FILES[column].elementSize;
+      writeAll(columnDescriptors[column], data[column], bytes);
+      record.columnChecksums[column] = Checksum::crc32c(data[column], bytes);
+    }
+    // Column data must be durable before the record that makes it visible.
+    for (const int descriptor : columnDescriptors) {
+      syncDescriptor(descriptor);
+    }
+    record.checksum = Checksum::crc32c(&record, offsetof(CommitRecord, checksum));
+    writeAll(manifestDescriptor, &record, sizeof(record));
+    syncDescriptor(manifestDescriptor);
+  } catch (...) {
+    // Roll partial writes back so a retried commit appends at the right place.
+    for (std::size_t column = 0; column < COLUMN_COUNT; ++column) {
+      static_cast<void>(::ftruncate(
+          columnDescriptors[column],
+          static_cast<off_t>(committedRows * COLUMN_FILES[column].elementSize)));
+    }
+    static_cast<void>(
+        ::ftruncate(manifestDescriptor, static_cast<off_t>(manifestBytes)));
+    throw;
+  }
+  committedRows += count;
+  manifestBytes += sizeof(record);
+  pending = SOLColumnStore();
+  pending.reserve(groupSize);
+}
+
+void SOLArchiveWriter::rollback(const std::size_t rows) {
+  if (pending.size() > 0) {
+    throw std::logic_error("Commit or discard pending SOLs before a rollback");
+  }
+  if (rows > committedRows) {
+    throw std::runtime_error("SOL archive has fewer committed rows than requested");
+  }
+  const ManifestState state = readManifest(manifestDescriptor);
+  std::size_t keptBytes = sizeof(ManifestHeader);
+  for (const CommitRecord& record : state.commits) {
+    if (record.rows > rows) {
+      break;
+    }
+    keptBytes += sizeof(CommitRecord);
+    if (record.rows == rows) {
+      break;
+    }
+  }
+  const std::size_t keptCommits = (keptBytes - sizeof(ManifestHeader)) / sizeof(CommitRecord);
+  if (rows > 0 && (keptCommits == 0 || state.commits[keptCommits - 1].rows != rows)) {
+    throw std::invalid_argument("Rollback target is not a commit boundary");
+  }
+  // Drop the commit records first so a crash never exposes shortened columns.
+  if (::ftruncate(manifestDescriptor, static_cast<off_t>(keptBytes)) != 0) {
+    throwSystemError("Unable to truncate SOL archive");
+  }
+  syncDescriptor(manifestDescriptor);
+  for (std::size_t column = 0; column < COLUMN_COUNT; ++column) {
+    if (::ftruncate(columnDescriptors[column],
+                    static_cast<off_t>(rows * COLUMN_FILES[column].elementSize)) != 0) {
+      throwSystemError("Unable to truncate SOL archive column");
+    }
+  }
+  committedRows = rows;
+  manifestBytes = keptBytes;
+}
+
+const std::string& SOLArchiveWriter::getDirectory() const {
+  return directory;
+}
+
+std::size_t SOLArchiveWriter::getCommittedCount() const {
+  return committedRows;
+}
+
+std::size_t SOLArchiveWriter::getPendingCount() const {
+  return pending.size();
+}
+
+void SOLArchiveWriter::onSOLFinalized(const SOLData& solData) {
+  append(solData);
+}
@@ -0,0 +1,179 @@
+/**
+ * @file SOLColumnStore.cpp
+ * @brief Implementation of the SOLColumnStore class.
+ */
+
+#include "Data/SOLColumnStore.h"
+#include "Data/SOLArchive.h"
+
+void SOLColumnStore::attach(const std::shared_ptr<const SOLArchive>& archive) {
+  solNumbers.borrow(archive->getSolNumbers().data(), archive->size());
+  temperatures.borrow(archive->getTemperatures().data(), archive->size());
+  distances.borrow(archive->getDistances().data(), archive->size());
+  directions.borrow(archive->getDirections().data(), archive->size());
+  elementIds.borrow(archive->getElementIds().data(), archive->size());
+  temperatureAggregates.borrow(archive->getTemperatureAggregates().data(),
+                               archive->size());
+  sampleReadings.borrow(archive->getSampleReadings().data(), archive->size());
+  this->archive = archive;
+}
+
+void SOLColumnStore::borrow(const SOLColumnPointers& columns, const std::size_t rows) {
+  solNumbers.borrow(columns.solNumbers, rows);
+  temperatures.borrow(columns.temperatures, rows);
+  distances.borrow(columns.distances, rows);
+  directions.borrow(columns.directions, rows);
+  elementIds.borrow(columns.elementIds, rows);
+  temperatureAggregates.borrow(columns.temperatureAggregates, rows);
+  sampleReadings.borrow(columns.sampleReadings, rows);
+  archive = nullptr;
+}
+
+bool SOLColumnStore::isAttached() const {
+  return archive != nullptr;
+}
+
+void SOLColumnStore::detach() {
+  if (!archive) {
+    return;
+  }
+  solNumbers.values();
+  temperatures.values();
+  distances.values();
+  directions.values();
+  elementIds.values();
+  temperatureAggregates.values();
+  sampleReadings.values();
+  archive.reset();
+}
+
+void SOLColumnStore::append(const SOLData& solData) {
+  insert(size(), solData);
+}
+
+void SOLColumnStore::insert(const std::size_t position, const SOLData& solData) {
+  detach();
+  const NavigationRecord& navigation = solData.getNavigationData();
+  std::vector<int>& sols = solNumbers.values();
+  std::vector<double>& temperatureValues = temperatures.values();
+  std::vector<double>& distanceValues = distances.values();
+  std::vector<std::uint8_t>& directionValues = directions.values();
+  std::vector<std::int16_t>& elementValues = elementIds.values();
+  std::vector<TemperatureAggregate>& aggregates = temperatureAggregates.values();
+  std::vector<SampleReading>& readings = sampleReadings.values();
+  sols.insert(sols.begin() + position, solData.getSolNumber());
+  temperatureValues.insert(temperatureValues.begin() + position,
+                           solData.getTemperatureData());
+  distanceValues.insert(distanceValues.begin() + position,
+                        navigation.finalDistance.getValue());
+  directionValues.insert(directionValues.begin() + position,
+                         static_cast<std::uint8_t>(navigation.finalDirection));
+  elementValues.insert(elementValues.begin() + position,
+                       static_cast<std::int16_t>(solData.getSampleData().getElementId()));
+  aggregates.insert(aggregates.begin() + position, solData.getTemperatureAggregate());
+  readings.insert(readings.begin() + position, solData.getSampleReading());
+}
+
+void SOLColumnStore::replace(const std::size_t position, const SOLData& solData) {
+  detach();
+  const NavigationRecord& navigation = solData.getNavigationData();
+  solNumbers.values()[position] = solData.getSolNumber();
+  temperatures.values()[position] = solData.getTemperatureData();
+  distances.values()[position] = navigation.finalDistance.getValue();
+  directions.values()[position] = static_cast<std::uint8_t>(navigation.finalDirection);
+  elementIds.values()[position] =
+      static_cast<std::int16_t>(solData.getSampleData().getElementId());
+  temperatureAggregates.values()[position] = solData.getTemperatureAggregate();
+  sampleReadings.values()[position] = solData.getSampleReading();
+}
+
+SOLColumnPointers SOLColumnStore::grow(const std::size_t rows) {
+  detach();
+  const std::size_t first = size();
+  std::vector<int>& sols = solNumbers.values();
+  std::vector<double>& temperatureValues = temperatures.values();
+  std::vector<double>& distanceValues = distances.values();
+  std::vector<std::uint8_t>& directionValues = directions.values();
+  std::vector<std::int16_t>& elementValues = elementIds.values();
+  std::vector<TemperatureAggregate>& aggregates = temperatureAggregates.values();
+  std::vector<SampleReading>& readings = sampleReadings.values();
+  sols.resize(first + rows);
+  temperatureValues.resize(first + rows);
+  distanceValues.resize(first + rows);
+  directionValues.resize(first + rows);
+  elementValues.resize(first + rows);
+  aggregates.resize(first + rows);
+  readings.resize(first + rows);
+  SOLColumnPointers pointers = {sols.data() + first,           temperatureValues.data() + first,
+                                distanceValues.data() + first, directionValues.data() + first,
+                                elementValues.data() + first,  aggregates.data() + first,
+                                readings.data() + first};
+  return pointers;
+}
+
+void SOLColumnStore::clear() {
+  detach();
+  solNumbers.values().clear();
+  temperatures.values().clear();
+  distances.values().clear();
+  directions.values().clear();
+  elementIds.values().clear();
+  temperatureAggregates.values().clear();
+  sampleReadings.values().clear();
+}
+
+SOLData SOLColumnStore::row(const std::size_t position) const {
+  SOLData solData(solNumbers.span()[position]);
+  solData.storeTemperatureAggregate(temperatureAggregates.span()[position]);
+  NavigationRecord navigation;
+  navigation.finalDistance = Measurement(distances.span()[position], UnitType::Distance,
+                                         static_cast<int>(DistanceUnit::Meter));
+  navigation.finalDirection = static_cast<Direction>(directions.span()[position]);
+  solData.storeNavigationData(navigation);
+  solData.storeSampleData(SampleClassification(elementIds.span()[position]));
+  solData.storeSampleReading(sampleReadings.span()[position]);
+  return solData;
+}
+
+void SOLColumnStore::reserve(const std::size_t rows) {
+  detach();
+  solNumbers.values().reserve(rows);
+  temperatures.values().reserve(rows);
+  distances.values().reserve(rows);
+  directions.values().reserve(rows);
+  elementIds.values().reserve(rows);
+  temperatureAggregates.values().reserve(rows);
+  sampleReadings.values().reserve(rows);
+}
+
+std::size_t SOLColumnStore::size() const {
+  return solNumbers.span().size();
+}
+
+ColumnSpan<int> SOLColumnStore::getSolNumbers() const {
+  return solNumbers.span();
+}
+
+ColumnSpan<double> SOLColumnStore::getTemperatures() const {
+  return temperatures.span();
+}
+
+ColumnSpan<double> SOLColumnStore::getDistances() const {
+  return distances.span();
+}
+
+ColumnSpan<std::uint8_t> SOLColumnStore::getDirections() const {
+  return directions.span();
+}
+
+ColumnSpan<std::int16_t> SOLColumnStore::getElementIds() const {
+  return elementIds.span();
+}
+
+ColumnSpan<TemperatureAggregate> SOLColumnStore::getTemperatureAggregates() const {
+  return temperatureAggregates.span();
+}
+
+ColumnSpan<SampleReading> SOLColumnStore::getSampleReadings() const {
+  return sampleReadings.span();
+}
@@ -5,11 +5,17 @@
 
 #include "Data/SOLData.h"
 
-SOLData::SOLData(const int solNum) : solNumber(solNum), SOLTemperature(0), navigationData() {
+SOLData::SOLData(const int solNum)
+    : solNumber(solNum), sampleData(), SOLTemperature(), navigationData() {
 }
 
 void SOLData::storeTemperatureData(const double& data) {
-  SOLTemperature = data;
+  SOLTemperature = TemperatureAggregate();
+  SOLTemperature.add(data);
+}
+
+void SOLData::storeTemperatureAggregate(const TemperatureAggregate& aggregate) {
+  SOLTemperature = aggregate;
 }
 
 void SOLData::storeNavigationData(const NavigationRecord& data) {
@@ -20,11 +26,19 @@ void SOLData::storeSampleData(const SampleClassification& data) {
   sampleData = data;
 }
 
+void SOLData::storeSampleReading(const SampleReading& reading) {
+  sampleReading = reading;
+}
+
 int SOLData::getSolNumber() const {
   return solNumber;
 }
 
 const double& SOLData::getTemperatureData() const {
+  return SOLTemperature.last;
+}
+
+const TemperatureAggregate& SOLData::getTemperatureAggregate() const {
   return SOLTemperature;
 }
 
@@ -35,3 +49,7 @@ const NavigationRecord& SOLData::getNavigationData() const {
 const SampleClassification& SOLData::getSampleData() const {
   return sampleData;
 }
+
+const SampleReading& SOLData::getSampleReading() const {
+  return sampleReading;
+}
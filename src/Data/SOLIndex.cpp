@@ -0,0 +1,113 @@
+/**
+ * @file SOLIndex.cpp
+ * @brief Implementation of the SOLIndex class.
+ */
+
+#include "Data/SOLIndex.h"
+#include <algorithm>
+
+const std::size_t SOLIndex::NOT_FOUND = static_cast<std::size_t>(-1);
+
+namespace {
+const std::int64_t EMPTY_SLOT = -1;
+}  // namespace
+
+SOLIndex::SOLIndex() : denseBase(0), denseEnabled(true) {}
+
+void SOLIndex::rebuildDense() {
+  dense.clear();
+  denseEnabled = false;
+  if (keys.empty()) {
+    denseEnabled = true;
+    return;
+  }
+  const std::int64_t span =
+      static_cast<std::int64_t>(keys.back()) - keys.front() + 1;
+  if (static_cast<std::uint64_t>(span) >
+      DENSE_SPAN_FACTOR * keys.size() + DENSE_SPAN_SLACK) {
+    return;
+  }
+  denseBase = keys.front();
+  dense.assign(static_cast<std::size_t>(span), EMPTY_SLOT);
+  for (std::size_t position = 0; position < keys.size(); ++position) {
+    dense[keys[position] - denseBase] = static_cast<std::int64_t>(position);
+  }
+  denseEnabled = true;
+}
+
+std::size_t SOLIndex::find(const int solNumber) const {
+  if (denseEnabled) {
+    const std::int64_t offset = static_cast<std::int64_t>(solNumber) - denseBase;
+    if (offset < 0 || offset >= static_cast<std::int64_t>(dense.size()) ||
+        dense[offset] == EMPTY_SLOT) {
+      return NOT_FOUND;
+    }
+    return static_cast<std::size_t>(dense[offset]);
+  }
+  const auto it = std::lower_bound(keys.begin(), keys.end(), solNumber);
+  if (it == keys.end() || *it != solNumber) {
+    return NOT_FOUND;
+  }
+  return static_cast<std::size_t>(it - keys.begin());
+}
+
+std::size_t SOLIndex::insertionPoint(const int solNumber) const {
+  if (keys.empty() || keys.back() < solNumber) {
+    return keys.size();
+  }
+  return static_cast<std::size_t>(
+      std::upper_bound(keys.begin(), keys.end(), solNumber) - keys.begin());
+}
+
+void SOLIndex::insert(const int solNumber, const std::size_t position) {
+  const bool appended = position == keys.size();
+  keys.insert(keys.begin() + position, solNumber);
+  if (!appended) {
+    // Every later position shifted, so rebuild rather than patch.
+    rebuildDense();
+    return;
+  }
+  if (keys.size() == 1) {
+    rebuildDense();
+    return;
+  }
+  if (!denseEnabled) {
+    // Contiguous appends after a gap can make the index dense again.
+    const std::uint64_t span =
+        static_cast<std::uint64_t>(static_cast<std::int64_t>(solNumber) - keys.front()) + 1;
+    if (span <= DENSE_SPAN_FACTOR * keys.size() + DENSE_SPAN_SLACK) {
+      rebuildDense();
+    }
+    return;
+  }
+  const std::size_t offset = static_cast<std::size_t>(
+      static_cast<std::int64_t>(solNumber) - denseBase);
+  if (offset + 1 > DENSE_SPAN_FACTOR * keys.size() + DENSE_SPAN_SLACK) {
+    dense.clear();
+    denseEnabled = false;
+    return;
+  }
+  if (offset >= dense.size()) {
+    dense.resize(offset + 1, EMPTY_SLOT);
+  }
+  dense[offset] = static_cast<std::int64_t>(position);
+}
+
+std::pair<std::size_t, std::size_t> SOLIndex::range(const int firstSol,
+                                                    const int lastSol) const {
+  if (lastSol < firstSol) {
+    return std::make_pair(std::size_t(0), std::size_t(0));
+  }
+  const auto begin = std::lower_bound(keys.begin(), keys.end(), firstSol);
+  const auto end = std::upper_bound(begin, keys.end(), lastSol);
+  return std::make_pair(static_cast<std::size_t>(begin - keys.begin()),
+                        static_cast<std::size_t>(end - keys.begin()));
+}
+
+bool SOLIndex::isDense() const {
+  return denseEnabled;
+}
+
+std::size_t SOLIndex::size() const {
+  return keys.size();
+}
@@ -0,0 +1,65 @@
+/**
+ * @file SOLInvertedIndex.cpp
+ * @brief Implementation of the SOLInvertedIndex class.
+ */
+
+#include "Data/SOLInvertedIndex.h"
+#include <stdexcept>
+
+namespace {
+const SOLPostings NO_POSTINGS;
+}  // namespace
+
+void SOLInvertedIndex::add(const SOLData& solData) {
+  add(solData.getSolNumber(), solData.getSampleData().getElementId(),
+      static_cast<int>(solData.getNavigationData().finalDirection));
+}
+
+void SOLInvertedIndex::add(const int solNumber, const int elementId, const int direction) {
+  elements[elementId].add(solNumber);
+  directions[direction].add(solNumber);
+}
+
+void SOLInvertedIndex::remove(const SOLData& solData) {
+  const int solNumber = solData.getSolNumber();
+  const std::map<int, SOLPostings>::iterator element =
+      elements.find(solData.getSampleData().getElementId());
+  if (element != elements.end() && element->second.remove(solNumber) &&
+      element->second.size() == 0) {
+    elements.erase(element);
+  }
+  const std::map<int, SOLPostings>::iterator direction =
+      directions.find(static_cast<int>(solData.getNavigationData().finalDirection));
+  if (direction != directions.end() && direction->second.remove(solNumber) &&
+      direction->second.size() == 0) {
+    directions.erase(direction);
+  }
+}
+
+const std::map<int, SOLPostings>& SOLInvertedIndex::getPostings(const SOLColumn key) const {
+  switch (key) {
+    case SOLColumn::Element:
+      return elements;
+    case SOLColumn::Direction:
+      return directions;
+    default:
+      throw std::invalid_argument("SOLs are only indexed by element and direction");
+  }
+}
+
+const SOLPostings& SOLInvertedIndex::getPostings(const SOLColumn key, const int value) const {
+  const std::map<int, SOLPostings>& postings = getPostings(key);
+  const std::map<int, SOLPostings>::const_iterator found = postings.find(value);
+  return found == postings.end() ? NO_POSTINGS : found->second;
+}
+
+std::size_t SOLInvertedIndex::getFootprint() const {
+  std::size_t footprint = 0;
+  for (const std::pair<const int, SOLPostings>& entry : elements) {
+    footprint += entry.second.getFootprint();
+  }
+  for (const std::pair<const int, SOLPostings>& entry : directions) {
+    footprint += entry.second.getFootprint();
+  }
+  return footprint;
+}
@@ -0,0 +1,194 @@
+/**
+ * @file SOLPostings.cpp
+ * @brief Implementation of the SOLPostings class.
+ */
+
+#include "Data/SOLPostings.h"
+#include <algorithm>
+
+namespace {
+const std::size_t NO_CHUNK = static_cast<std::size_t>(-1);
+
+void putVarint(std::vector<std::uint8_t>& bytes, std::uint32_t value) {
+  while (value >= 0x80) {
+    bytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  bytes.push_back(static_cast<std::uint8_t>(value));
+}
+
+std::uint32_t readVarint(const std::uint8_t*& cursor) {
+  std::uint32_t value = 0;
+  for (unsigned shift = 0;; shift += 7) {
+    const std::uint8_t byte = *cursor++;
+    value |= static_cast<std::uint32_t>(byte & 0x7f) << shift;
+    if (byte < 0x80) {
+      return value;
+    }
+  }
+}
+}  // namespace
+
+/**
+ * @class SOLPostings::Cursor
+ * @brief Forward search through a list, one decoded chunk at a time.
+ */
+class SOLPostings::Cursor {
+ private:
+  const SOLPostings* list;
+  std::size_t chunk; /**< The chunk held in decoded. */
+  std::vector<int> decoded;
+  std::size_t position; /**< First decoded SOL not yet passed. */
+
+ public:
+  explicit Cursor(const SOLPostings& list) : list(&list), chunk(NO_CHUNK), position(0) {}
+
+  /** @brief Checks for a SOL; successive calls must not decrease. */
+  bool seek(const int solNumber) {
+    const std::size_t found = list->chunkOf(solNumber, chunk == NO_CHUNK ? 0 : chunk);
+    if (found == NO_CHUNK) {
+      return false;
+    }
+    if (found != chunk) {
+      decoded.clear();
+      list->decodeChunk(found, decoded);
+      chunk = found;
+      position = 0;
+    }
+    position = static_cast<std::size_t>(
+        std::lower_bound(decoded.begin() + position, decoded.end(), solNumber) -
+        decoded.begin());
+    return position < decoded.size() && decoded[position] == solNumber;
+  }
+};
+
+SOLPostings::SOLPostings() : count(0), last(0) {}
+
+std::size_t SOLPostings::chunkOf(const int solNumber, const std::size_t from) const {
+  const std::vector<Chunk>::const_iterator after = std::upper_bound(
+      chunks.begin() + from, chunks.end(), solNumber,
+      [](const int sol, const Chunk& chunk) { return sol < chunk.first; });
+  if (after == chunks.begin()) {
+    return NO_CHUNK;
+  }
+  return static_cast<std::size_t>(after - chunks.begin()) - 1;
+}
+
+void SOLPostings::decodeChunk(const std::size_t chunk, std::vector<int>& solNumbers) const {
+  const std::size_t entries = std::min(POSTINGS_CHUNK_SIZE, count - chunk * POSTINGS_CHUNK_SIZE);
+  const std::uint8_t* cursor = gaps.data() + chunks[chunk].offset;
+  std::uint32_t solNumber = static_cast<std::uint32_t>(chunks[chunk].first);
+  solNumbers.push_back(chunks[chunk].first);
+  for (std::size_t entry = 1; entry < entries; ++entry) {
+    solNumber += readVarint(cursor);
+    solNumbers.push_back(static_cast<int>(solNumber));
+  }
+}
+
+void SOLPostings::rebuild(const std::vector<int>& solNumbers) {
+  chunks.clear();
+  gaps.clear();
+  count = 0;
+  for (const int solNumber : solNumbers) {
+    add(solNumber);
+  }
+}
+
+bool SOLPostings::add(const int solNumber) {
+  if (count > 0 && solNumber <= last) {
+    if (contains(solNumber)) {
+      return false;
+    }
+    std::vector<int> solNumbers = getSOLs();
+    solNumbers.insert(std::lower_bound(solNumbers.begin(), solNumbers.end(), solNumber),
+                      solNumber);
+    rebuild(solNumbers);
+    return true;
+  }
+  if (count % POSTINGS_CHUNK_SIZE == 0) {
+    const Chunk chunk = {solNumber, gaps.size()};
+    chunks.push_back(chunk);
+  } else {
+    putVarint(gaps, static_cast<std::uint32_t>(solNumber) - static_cast<std::uint32_t>(last));
+  }
+  last = solNumber;
+  ++count;
+  return true;
+}
+
+bool SOLPostings::remove(const int solNumber) {
+  if (!contains(solNumber)) {
+    return false;
+  }
+  std::vector<int> solNumbers = getSOLs();
+  solNumbers.erase(std::lower_bound(solNumbers.begin(), solNumbers.end(), solNumber));
+  rebuild(solNumbers);
+  return true;
+}
+
+bool SOLPostings::contains(const int solNumber) const {
+  return Cursor(*this).seek(solNumber);
+}
+
+std::vector<int> SOLPostings::getSOLs() const {
+  std::vector<int> solNumbers;
+  solNumbers.reserve(count);
+  for (std::size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+    decodeChunk(chunk, solNumbers);
+  }
+  return solNumbers;
+}
+
+std::vector<int> SOLPostings::getLast(const std::size_t limit) const {
+  std::vector<int> newest;
+  std::vector<int> decoded;
+  for (std::size_t chunk = chunks.size(); chunk > 0 && newest.size() < limit; --chunk) {
+    decoded.clear();
+    decodeChunk(chunk - 1, decoded);
+    for (std::vector<int>::const_reverse_iterator solNumber = decoded.rbegin();
+         solNumber != decoded.rend() && newest.size() < limit; ++solNumber) {
+      newest.push_back(*solNumber);
+    }
+  }
+  return newest;
+}
+
+std::vector<int> SOLPostings::intersect(const std::vector<const SOLPostings*>& lists) {
+  std::vector<int> common;
+  if (lists.empty()) {
+    return common;
+  }
+  std::vector<const SOLPostings*> ordered(lists);
+  std::sort(ordered.begin(), ordered.end(),
+            [](const SOLPostings* left, const SOLPostings* right) {
+              return left->size() < right->size();
+            });
+  std::vector<Cursor> cursors;
+  cursors.reserve(ordered.size() - 1);
+  for (std::size_t list = 1; list < ordered.size(); ++list) {
+    cursors.emplace_back(*ordered[list]);
+  }
+  std::vector<int> decoded;
+  for (std::size_t chunk = 0; chunk < ordered.front()->chunks.size(); ++chunk) {
+    decoded.clear();
+    ordered.front()->decodeChunk(chunk, decoded);
+    for (const int solNumber : decoded) {
+      bool everywhere = true;
+      for (std::size_t cursor = 0; everywhere && cursor < cursors.size(); ++cursor) {
+        everywhere = cursors[cursor].seek(solNumber);
+      }
+      if (everywhere) {
+        common.push_back(solNumber);
+      }
+    }
+  }
+  return common;
+}
+
+std::size_t SOLPostings::size() const {
+  return count;
+}
+
+std::size_t SOLPostings::getFootprint() const {
+  return chunks.size() * sizeof(Chunk) + gaps.size();
+}
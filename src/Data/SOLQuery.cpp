@@ -0,0 +1,527 @@
+/**
+ * @file SOLQuery.cpp
+ * @brief Implementation of the SOLQuery class.
+ */
+
+#include "Data/SOLQuery.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include "Temperature/ReductionKernels.h"
+
+#if defined(__GNUC__) && defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define ENIGMA_SSE2_FILTERS
+#include <emmintrin.h>
+#endif
+
+namespace {
+const std::size_t WORD_BITS = 64;
+const std::uint64_t ALL_SELECTED = ~std::uint64_t(0);
+const std::uint64_t PACK_BYTES = 0x0102040810204080ull;
+/** @brief Integer operands are clamped here; every column value fits. */
+const double INTEGER_OPERAND_LIMIT = 4294967296.0;
+
+std::size_t wordsFor(const std::size_t rows) {
+  return (rows + WORD_BITS - 1) / WORD_BITS;
+}
+
+/**
+ * @brief ANDs the rows a test accepts into a selection bitmap. Each word is
+ * built from 64 branch-free tests, which the compiler vectorizes.
+ */
+template <typename T, typename Test>
+void filterColumn(const T* values, const std::size_t rows, const Test test,
+                  std::uint64_t* selection) {
+  const std::size_t fullWords = rows / WORD_BITS;
+  for (std::size_t word = 0; word < fullWords; ++word) {
+    if (selection[word] == 0) {
+      continue;
+    }
+    const T* block = values + word * WORD_BITS;
+    std::uint8_t matches[WORD_BITS];
+    for (std::size_t bit = 0; bit < WORD_BITS; ++bit) {
+      matches[bit] = test(block[bit]);
+    }
+    // Packs eight 0/1 bytes at a time: the multiply moves byte i to bit 56 + i.
+    std::uint64_t bits = 0;
+    for (std::size_t byte = 0; byte < WORD_BITS; byte += 8) {
+      std::uint64_t eight;
+      std::memcpy(&eight, matches + byte, sizeof(eight));
+      bits |= ((eight * PACK_BYTES) >> 56) << byte;
+    }
+    selection[word] &= bits;
+  }
+  if (rows % WORD_BITS != 0) {
+    std::uint64_t bits = 0;
+    for (std::size_t row = fullWords * WORD_BITS; row < rows; ++row) {
+      bits |= static_cast<std::uint64_t>(test(values[row])) << (row % WORD_BITS);
+    }
+    selection[fullWords] &= bits;
+  }
+}
+
+/** @brief Double comparisons, as scalar and, where available, SSE2 tests. */
+struct LessTest {
+  static bool test(const double value, const double operand) { return value < operand; }
+#ifdef ENIGMA_SSE2_FILTERS
+  static __m128d test(const __m128d values, const __m128d operand) {
+    return _mm_cmplt_pd(values, operand);
+  }
+#endif
+};
+
+struct LessOrEqualTest {
+  static bool test(const double value, const double operand) { return value <= operand; }
+#ifdef ENIGMA_SSE2_FILTERS
+  static __m128d test(const __m128d values, const __m128d operand) {
+    return _mm_cmple_pd(values, operand);
+  }
+#endif
+};
+
+struct EqualTest {
+  static bool test(const double value, const double operand) { return value == operand; }
+#ifdef ENIGMA_SSE2_FILTERS
+  static __m128d test(const __m128d values, const __m128d operand) {
+    return _mm_cmpeq_pd(values, operand);
+  }
+#endif
+};
+
+struct NotEqualTest {
+  static bool test(const double value, const double operand) { return value != operand; }
+#ifdef ENIGMA_SSE2_FILTERS
+  static __m128d test(const __m128d values, const __m128d operand) {
+    return _mm_cmpneq_pd(values, operand);
+  }
+#endif
+};
+
+struct GreaterOrEqualTest {
+  static bool test(const double value, const double operand) { return value >= operand; }
+#ifdef ENIGMA_SSE2_FILTERS
+  static __m128d test(const __m128d values, const __m128d operand) {
+    return _mm_cmpge_pd(values, operand);
+  }
+#endif
+};
+
+struct GreaterTest {
+  static bool test(const double value, const double operand) { return value > operand; }
+#ifdef ENIGMA_SSE2_FILTERS
+  static __m128d test(const __m128d values, const __m128d operand) {
+    return _mm_cmpgt_pd(values, operand);
+  }
+#endif
+};
+
+/**
+ * @brief Filters a double column. Compilers do not vectorize double
+ * comparisons narrowed to bytes, so with SSE2 each pair of rows is compared
+ * and turned into two selection bits directly.
+ */
+template <typename Test>
+void filterDoubles(const double* values, const std::size_t rows, const double operand,
+                   std::uint64_t* selection) {
+#ifdef ENIGMA_SSE2_FILTERS
+  const std::size_t fullWords = rows / WORD_BITS;
+  const __m128d operands = _mm_set1_pd(operand);
+  for (std::size_t word = 0; word < fullWords; ++word) {
+    if (selection[word] == 0) {
+      continue;
+    }
+    const double* block = values + word * WORD_BITS;
+    std::uint64_t bits = 0;
+    for (std::size_t bit = 0; bit < WORD_BITS; bit += 2) {
+      const __m128d matches = Test::test(_mm_loadu_pd(block + bit), operands);
+      bits |= static_cast<std::uint64_t>(_mm_movemask_pd(matches)) << bit;
+    }
+    selection[word] &= bits;
+  }
+  const std::size_t done = fullWords * WORD_BITS;
+  filterColumn(values + done, rows - done,
+               [operand](double value) { return Test::test(value, operand); },
+               selection + fullWords);
+#else
+  filterColumn(values, rows, [operand](double value) { return Test::test(value, operand); },
+               selection);
+#endif
+}
+
+void filterColumn(const double* values, const std::size_t rows, const SOLPredicate& predicate,
+                  std::uint64_t* selection) {
+  switch (predicate.comparison) {
+    case SOLComparison::Less:
+      filterDoubles<LessTest>(values, rows, predicate.operand, selection);
+      break;
+    case SOLComparison::LessOrEqual:
+      filterDoubles<LessOrEqualTest>(values, rows, predicate.operand, selection);
+      break;
+    case SOLComparison::Equal:
+      filterDoubles<EqualTest>(values, rows, predicate.operand, selection);
+      break;
+    case SOLComparison::NotEqual:
+      filterDoubles<NotEqualTest>(values, rows, predicate.operand, selection);
+      break;
+    case SOLComparison::GreaterOrEqual:
+      filterDoubles<GreaterOrEqualTest>(values, rows, predicate.operand, selection);
+      break;
+    case SOLComparison::Greater:
+      filterDoubles<GreaterTest>(values, rows, predicate.operand, selection);
+      break;
+  }
+}
+
+/**
+ * @brief Filters an integer column. The predicate is first rewritten as an
+ * inclusive range of integers, possibly negated, so rows are tested in their
+ * own type with one unsigned compare instead of being converted to double.
+ */
+template <typename T>
+void filterColumn(const T* values, const std::size_t rows, const SOLPredicate& predicate,
+                  std::uint64_t* selection) {
+  // A NaN operand matches nothing, except under NotEqual.
+  if (predicate.operand != predicate.operand) {
+    if (predicate.comparison != SOLComparison::NotEqual) {
+      std::fill(selection, selection + wordsFor(rows), 0);
+    }
+    return;
+  }
+  const double operand =
+      std::max(-INTEGER_OPERAND_LIMIT, std::min(INTEGER_OPERAND_LIMIT, predicate.operand));
+  double low = -INTEGER_OPERAND_LIMIT;
+  double high = INTEGER_OPERAND_LIMIT;
+  bool negated = false;
+  switch (predicate.comparison) {
+    case SOLComparison::Less:
+      high = std::ceil(operand) - 1;
+      break;
+    case SOLComparison::LessOrEqual:
+      high = std::floor(operand);
+      break;
+    case SOLComparison::Equal:
+      low = std::ceil(operand);
+      high = std::floor(operand);
+      break;
+    case SOLComparison::NotEqual:
+      // The complement of the Equal range.
+      low = std::ceil(operand);
+      high = std::floor(operand);
+      negated = true;
+      break;
+    case SOLComparison::GreaterOrEqual:
+      low = std::ceil(operand);
+      break;
+    case SOLComparison::Greater:
+      low = std::floor(operand) + 1;
+      break;
+  }
+  low = std::max(low, static_cast<double>(std::numeric_limits<T>::min()));
+  high = std::min(high, static_cast<double>(std::numeric_limits<T>::max()));
+  if (low > high) {
+    if (!negated) {
+      std::fill(selection, selection + wordsFor(rows), 0);
+    }
+    return;
+  }
+  const std::uint32_t first = static_cast<std::uint32_t>(static_cast<std::int64_t>(low));
+  const std::uint32_t span = static_cast<std::uint32_t>(static_cast<std::int64_t>(high - low));
+  if (negated) {
+    filterColumn(values, rows,
+                 [first, span](T value) {
+                   return static_cast<std::uint32_t>(value) - first > span;
+                 },
+                 selection);
+  } else {
+    filterColumn(values, rows,
+                 [first, span](T value) {
+                   return static_cast<std::uint32_t>(value) - first <= span;
+                 },
+                 selection);
+  }
+}
+
+void filterRows(const SOLDataView& rows, const SOLPredicate& predicate,
+                std::uint64_t* selection) {
+  switch (predicate.column) {
+    case SOLColumn::SolNumber:
+      filterColumn(rows.getSolNumbers().data(), rows.size(), predicate, selection);
+      break;
+    case SOLColumn::Temperature:
+      filterColumn(rows.getTemperatures().data(), rows.size(), predicate, selection);
+      break;
+    case SOLColumn::Distance:
+      filterColumn(rows.getDistances().data(), rows.size(), predicate, selection);
+      break;
+    case SOLColumn::Direction:
+      filterColumn(rows.getDirections().data(), rows.size(), predicate, selection);
+      break;
+    case SOLColumn::Element:
+      filterColumn(rows.getElementIds().data(), rows.size(), predicate, selection);
+      break;
+  }
+}
+
+/**
+ * @brief Copies the selected values of a column, as doubles, to output,
+ * which must hold rows values. Dense words are copied branch-free; sparse
+ * ones jump from set bit to set bit.
+ * @return The number of values copied.
+ */
+template <typename T>
+std::size_t gatherColumn(const T* values, const std::uint64_t* selection, const std::size_t rows,
+                         double* output) {
+  std::size_t count = 0;
+  for (std::size_t word = 0; word < wordsFor(rows); ++word) {
+    std::uint64_t bits = selection[word];
+    const T* block = values + word * WORD_BITS;
+    const std::size_t width = std::min(WORD_BITS, rows - word * WORD_BITS);
+    if (bits == ALL_SELECTED) {
+      for (std::size_t bit = 0; bit < WORD_BITS; ++bit) {
+        output[count + bit] = static_cast<double>(block[bit]);
+      }
+      count += WORD_BITS;
+    } else if (__builtin_popcountll(bits) > static_cast<int>(WORD_BITS / 4)) {
+      for (std::size_t bit = 0; bit < width; ++bit) {
+        output[count] = static_cast<double>(block[bit]);
+        count += static_cast<std::size_t>((bits >> bit) & 1);
+      }
+    } else {
+      while (bits != 0) {
+        output[count++] = static_cast<double>(block[__builtin_ctzll(bits)]);
+        bits &= bits - 1;
+      }
+    }
+  }
+  return count;
+}
+
+std::size_t gatherRows(const SOLDataView& rows, const SOLColumn column,
+                       const std::uint64_t* selection, double* output) {
+  switch (column) {
+    case SOLColumn::SolNumber:
+      return gatherColumn(rows.getSolNumbers().data(), selection, rows.size(), output);
+    case SOLColumn::Temperature:
+      return gatherColumn(rows.getTemperatures().data(), selection, rows.size(), output);
+    case SOLColumn::Distance:
+      return gatherColumn(rows.getDistances().data(), selection, rows.size(), output);
+    case SOLColumn::Direction:
+      return gatherColumn(rows.getDirections().data(), selection, rows.size(), output);
+    case SOLColumn::Element:
+      return gatherColumn(rows.getElementIds().data(), selection, rows.size(), output);
+  }
+  return 0;
+}
+
+/** @brief Reduces gathered values with the SIMD kernels. */
+SOLAggregate reduce(const double* values, const std::size_t count) {
+  SOLAggregate aggregate;
+  if (count == 0) {
+    return aggregate;
+  }
+  const MinMaxSum reduced = ReductionKernels::minMaxSum(values, count);
+  aggregate.count = count;
+  aggregate.sum = reduced.sum;
+  aggregate.minimum = reduced.minimum;
+  aggregate.maximum = reduced.maximum;
+  return aggregate;
+}
+
+/**
+ * @brief Aggregates the selected rows of a column. A fully selected double
+ * column is reduced in place instead of being gathered first.
+ */
+SOLAggregate reduceRows(const SOLDataView& rows, const SOLColumn column,
+                        const std::uint64_t* selection, std::vector<double>& gathered) {
+  const std::size_t fullWords = rows.size() / WORD_BITS;
+  bool everyRow = rows.size() % WORD_BITS == 0 ||
+                  selection[fullWords] == (std::uint64_t(1) << (rows.size() % WORD_BITS)) - 1;
+  for (std::size_t word = 0; word < fullWords && everyRow; ++word) {
+    everyRow = selection[word] == ALL_SELECTED;
+  }
+  if (everyRow && column == SOLColumn::Temperature) {
+    return reduce(rows.getTemperatures().data(), rows.size());
+  }
+  if (everyRow && column == SOLColumn::Distance) {
+    return reduce(rows.getDistances().data(), rows.size());
+  }
+  gathered.resize(rows.size());
+  return reduce(gathered.data(), gatherRows(rows, column, selection, gathered.data()));
+}
+
+/**
+ * @brief Aggregates a zone per key. Grouping columns hold a handful of
+ * distinct codes, so each key present gets its own selection bitmap, built
+ * with the vectorized filter, and its own reduction.
+ */
+template <typename K>
+void accumulateGroups(const K* keys, const SOLDataView& rows, const SOLColumn column,
+                      const std::uint64_t* selection, std::vector<std::uint64_t>& keySelection,
+                      std::vector<double>& gathered, std::map<int, SOLAggregate>& groups) {
+  if (rows.size() == 0) {
+    return;
+  }
+  const K lowest = *std::min_element(keys, keys + rows.size());
+  const K highest = *std::max_element(keys, keys + rows.size());
+  for (int key = lowest; key <= highest; ++key) {
+    keySelection.assign(selection, selection + wordsFor(rows.size()));
+    filterColumn(keys, rows.size(), [key](K value) { return value == key; },
+                 keySelection.data());
+    const SOLAggregate aggregate = reduceRows(rows, column, keySelection.data(), gathered);
+    if (aggregate.count > 0) {
+      groups[key].merge(aggregate);
+    }
+  }
+}
+}  // namespace
+
+void SOLAggregate::add(const double value) {
+  ++count;
+  sum += value;
+  minimum = std::min(minimum, value);
+  maximum = std::max(maximum, value);
+}
+
+void SOLAggregate::merge(const SOLAggregate& other) {
+  count += other.count;
+  sum += other.sum;
+  minimum = std::min(minimum, other.minimum);
+  maximum = std::max(maximum, other.maximum);
+}
+
+double SOLAggregate::getMean() const {
+  return count == 0 ? std::numeric_limits<double>::quiet_NaN()
+                    : sum / static_cast<double>(count);
+}
+
+SOLQuery& SOLQuery::where(const SOLColumn column, const SOLComparison comparison,
+                          const double operand) {
+  SOLPredicate predicate;
+  predicate.column = column;
+  predicate.comparison = comparison;
+  predicate.operand = operand;
+  predicates.push_back(predicate);
+  return *this;
+}
+
+const std::vector<SOLPredicate>& SOLQuery::getPredicates() const {
+  return predicates;
+}
+
+bool SOLQuery::mayMatch(const SOLZoneMap& zone) const {
+  for (const SOLPredicate& predicate : predicates) {
+    const double minimum = zone.getMinimum(predicate.column);
+    const double maximum = zone.getMaximum(predicate.column);
+    const double operand = predicate.operand;
+    bool possible = true;
+    switch (predicate.comparison) {
+      case SOLComparison::Less:
+        possible = minimum < operand;
+        break;
+      case SOLComparison::LessOrEqual:
+        possible = minimum <= operand;
+        break;
+      case SOLComparison::Equal:
+        possible = minimum <= operand && operand <= maximum;
+        break;
+      case SOLComparison::NotEqual:
+        possible = !(minimum == operand && maximum == operand);
+        break;
+      case SOLComparison::GreaterOrEqual:
+        possible = maximum >= operand;
+        break;
+      case SOLComparison::Greater:
+        possible = maximum > operand;
+        break;
+    }
+    if (!possible) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void SOLQuery::scan(
+    const DataStorage& storage,
+    const std::function<void(const SOLDataView&, const std::uint64_t*)>& visitor) const {
+  std::vector<std::uint64_t> selection;
+  storage.forEachZone(
+      [this](const SOLZoneMap& zone) { return mayMatch(zone); },
+      [&](const SOLDataView& rows) {
+        selection.assign(wordsFor(rows.size()), ALL_SELECTED);
+        if (rows.size() % WORD_BITS != 0) {
+          selection.back() = (std::uint64_t(1) << (rows.size() % WORD_BITS)) - 1;
+        }
+        for (const SOLPredicate& predicate : predicates) {
+          filterRows(rows, predicate, selection.data());
+        }
+        visitor(rows, selection.data());
+      });
+}
+
+std::size_t SOLQuery::count(const DataStorage& storage) const {
+  std::size_t matches = 0;
+  scan(storage, [&matches](const SOLDataView& rows, const std::uint64_t* selection) {
+    for (std::size_t word = 0; word < wordsFor(rows.size()); ++word) {
+      matches += static_cast<std::size_t>(__builtin_popcountll(selection[word]));
+    }
+  });
+  return matches;
+}
+
+std::vector<double> SOLQuery::select(const DataStorage& storage,
+                                     const SOLColumn column) const {
+  std::vector<double> values;
+  scan(storage, [&](const SOLDataView& rows, const std::uint64_t* selection) {
+    const std::size_t offset = values.size();
+    values.resize(offset + rows.size());
+    values.resize(offset + gatherRows(rows, column, selection, values.data() + offset));
+  });
+  return values;
+}
+
+std::vector<int> SOLQuery::selectSOLs(const DataStorage& storage) const {
+  std::vector<int> solNumbers;
+  scan(storage, [&solNumbers](const SOLDataView& rows, const std::uint64_t* selection) {
+    const int* sols = rows.getSolNumbers().data();
+    for (std::size_t word = 0; word < wordsFor(rows.size()); ++word) {
+      std::uint64_t bits = selection[word];
+      while (bits != 0) {
+        solNumbers.push_back(sols[word * WORD_BITS + __builtin_ctzll(bits)]);
+        bits &= bits - 1;
+      }
+    }
+  });
+  return solNumbers;
+}
+
+SOLAggregate SOLQuery::aggregate(const DataStorage& storage, const SOLColumn column) const {
+  SOLAggregate result;
+  std::vector<double> gathered;
+  scan(storage, [&](const SOLDataView& rows, const std::uint64_t* selection) {
+    result.merge(reduceRows(rows, column, selection, gathered));
+  });
+  return result;
+}
+
+std::map<int, SOLAggregate> SOLQuery::aggregateBy(const DataStorage& storage,
+                                                  const SOLColumn key,
+                                                  const SOLColumn column) const {
+  if (key != SOLColumn::Direction && key != SOLColumn::Element) {
+    throw std::invalid_argument("SOLs can only be grouped by direction or element");
+  }
+  std::map<int, SOLAggregate> groups;
+  std::vector<std::uint64_t> keySelection;
+  std::vector<double> gathered;
+  scan(storage, [&](const SOLDataView& rows, const std::uint64_t* selection) {
+    if (key == SOLColumn::Direction) {
+      accumulateGroups(rows.getDirections().data(), rows, column, selection, keySelection,
+                       gathered, groups);
+    } else {
+      accumulateGroups(rows.getElementIds().data(), rows, column, selection, keySelection,
+                       gathered, groups);
+    }
+  });
+  return groups;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file SOLSegmentLog.cpp
+ * @brief Implementation of the SOLSegmentLog class.
+ */
+
+#include "Data/SOLSegmentLog.h"
+#include <algorithm>
+#include <stdexcept>
+#include "Utility/MakeUnique.h"
+
+namespace {
+const std::size_t INITIAL_DIRECTORY_CAPACITY = 16;
+}  // namespace
+
+/**
+ * @struct SOLSegmentLog::Segment
+ * @brief SOL_SEGMENT_ROWS rows of every column.
+ */
+struct SOLSegmentLog::Segment {
+  int solNumbers[SOL_SEGMENT_ROWS];
+  double temperatures[SOL_SEGMENT_ROWS];
+  double distances[SOL_SEGMENT_ROWS];
+  std::uint8_t directions[SOL_SEGMENT_ROWS];
+  std::int16_t elementIds[SOL_SEGMENT_ROWS];
+  TemperatureAggregate temperatureAggregates[SOL_SEGMENT_ROWS];
+  SampleReading sampleReadings[SOL_SEGMENT_ROWS];
+
+  /** @brief Gets the first row of every column. */
+  SOLColumnPointers columns() {
+    const SOLColumnPointers pointers = {solNumbers,  temperatures,          distances,
+                                        directions,  elementIds,            temperatureAggregates,
+                                        sampleReadings};
+    return pointers;
+  }
+};
+
+SOLSegmentLog::SOLSegmentLog() : directory(nullptr), published(0) {
+  directories.push_back(make_unique_ptr<Directory>());
+  directories.back()->segments.resize(INITIAL_DIRECTORY_CAPACITY);
+  directory.store(directories.back().get(), std::memory_order_release);
+  scratch.reserve(1);
+}
+
+SOLSegmentLog::~SOLSegmentLog() = default;
+
+void SOLSegmentLog::addSegment() {
+  Directory* current = directories.back().get();
+  if (segments.size() == current->segments.size()) {
+    // Readers may still hold the current directory, so copy it rather than
+    // growing it, and keep it alive.
+    std::unique_ptr<Directory> grown = make_unique_ptr<Directory>();
+    grown->segments.resize(2 * current->segments.size());
+    std::copy(current->segments.begin(), current->segments.end(), grown->segments.begin());
+    current = grown.get();
+    directories.push_back(std::move(grown));
+    directory.store(current, std::memory_order_release);
+  }
+  segments.push_back(make_unique_ptr<Segment>());
+  // Readers only look at this slot once a row in it is published.
+  current->segments[segments.size() - 1] = segments.back().get();
+}
+
+SOLSegmentLog::Segment& SOLSegmentLog::segmentOf(const std::size_t position) const {
+  return *directory.load(std::memory_order_acquire)->segments[position / SOL_SEGMENT_ROWS];
+}
+
+void SOLSegmentLog::append(const SOLData& solData) {
+  // Only this thread stores the size, so it may read it relaxed.
+  const std::size_t position = published.load(std::memory_order_relaxed);
+  const std::size_t offset = position % SOL_SEGMENT_ROWS;
+  if (offset == 0) {
+    addSegment();
+  }
+  scratch.clear();
+  scratch.append(solData);
+  Segment& segment = *segments.back();
+  segment.solNumbers[offset] = scratch.getSolNumbers()[0];
+  segment.temperatures[offset] = scratch.getTemperatures()[0];
+  segment.distances[offset] = scratch.getDistances()[0];
+  segment.directions[offset] = scratch.getDirections()[0];
+  segment.elementIds[offset] = scratch.getElementIds()[0];
+  segment.temperatureAggregates[offset] = scratch.getTemperatureAggregates()[0];
+  segment.sampleReadings[offset] = scratch.getSampleReadings()[0];
+  published.store(position + 1, std::memory_order_release);
+}
+
+void SOLSegmentLog::onSOLFinalized(const SOLData& solData) {
+  append(solData);
+}
+
+std::size_t SOLSegmentLog::size() const {
+  return published.load(std::memory_order_acquire);
+}
+
+SOLData SOLSegmentLog::row(const std::size_t position) const {
+  if (position >= size()) {
+    throw std::out_of_range("SOL position not published yet");
+  }
+  SOLColumnStore rows;
+  rows.borrow(segmentOf(position).columns(), position % SOL_SEGMENT_ROWS + 1);
+  return rows.row(position % SOL_SEGMENT_ROWS);
+}
+
+void SOLSegmentLog::forEachSegment(
+    const std::function<void(const SOLDataView&)>& visitor) const {
+  const std::size_t rows = size();
+  SOLColumnStore segment;
+  for (std::size_t first = 0; first < rows; first += SOL_SEGMENT_ROWS) {
+    segment.borrow(segmentOf(first).columns(), std::min(SOL_SEGMENT_ROWS, rows - first));
+    visitor(SOLDataView(segment, 0, segment.size()));
+  }
+}
@@ -0,0 +1,58 @@
+/**
+ * @file SOLZoneMap.cpp
+ * @brief Implementation of the SOLZoneMap struct.
+ */
+
+#include "Data/SOLZoneMap.h"
+#include <limits>
+
+namespace {
+/** @brief Widens a zone map range to cover a column's values. */
+template <typename T>
+void cover(const T* values, const std::size_t count, double& minimum, double& maximum) {
+  bool unordered = false;
+  for (std::size_t i = 0; i < count; ++i) {
+    const double value = static_cast<double>(values[i]);
+    minimum = value < minimum ? value : minimum;
+    maximum = value > maximum ? value : maximum;
+    unordered |= value != value;
+  }
+  if (unordered) {
+    minimum = -std::numeric_limits<double>::infinity();
+    maximum = std::numeric_limits<double>::infinity();
+  }
+}
+}  // namespace
+
+SOLZoneMap SOLZoneMap::of(const SOLColumnStore& rows, const std::size_t first,
+                          const std::size_t count) {
+  SOLZoneMap zone;
+  for (std::size_t column = 0; column < SOL_COLUMN_COUNT; ++column) {
+    zone.minimum[column] = std::numeric_limits<double>::infinity();
+    zone.maximum[column] = -std::numeric_limits<double>::infinity();
+  }
+  cover(rows.getSolNumbers().data() + first, count,
+        zone.minimum[static_cast<std::size_t>(SOLColumn::SolNumber)],
+        zone.maximum[static_cast<std::size_t>(SOLColumn::SolNumber)]);
+  cover(rows.getTemperatures().data() + first, count,
+        zone.minimum[static_cast<std::size_t>(SOLColumn::Temperature)],
+        zone.maximum[static_cast<std::size_t>(SOLColumn::Temperature)]);
+  cover(rows.getDistances().data() + first, count,
+        zone.minimum[static_cast<std::size_t>(SOLColumn::Distance)],
+        zone.maximum[static_cast<std::size_t>(SOLColumn::Distance)]);
+  cover(rows.getDirections().data() + first, count,
+        zone.minimum[static_cast<std::size_t>(SOLColumn::Direction)],
+        zone.maximum[static_cast<std::size_t>(SOLColumn::Direction)]);
+  cover(rows.getElementIds().data() + first, count,
+        zone.minimum[static_cast<std::size_t>(SOLColumn::Element)],
+        zone.maximum[static_cast<std::size_t>(SOLColumn::Element)]);
+  return zone;
+}
+
+double SOLZoneMap::getMinimum(const SOLColumn column) const {
+  return minimum[static_cast<std::size_t>(column)];
+}
+
+double SOLZoneMap::getMaximum(const SOLColumn column) const {
+  return maximum[static_cast<std::size_t>(column)];
+}
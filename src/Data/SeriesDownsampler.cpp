@@ -0,0 +1,210 @@
+/**
+ * @file SeriesDownsampler.cpp
+ * @brief Implementation of the SeriesDownsampler and IncrementalDownsampler
+ * classes.
+ */
+
+#include "Data/SeriesDownsampler.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+/**
+ * @brief Smallest target that leaves room for a bucket between the fixed
+ * first and last points.
+ */
+const std::size_t MIN_TARGET_POINTS = 3;
+
+void requireTarget(const std::size_t targetPoints) {
+  if (targetPoints < MIN_TARGET_POINTS) {
+    throw std::invalid_argument("Downsampling needs a target of at least 3 points");
+  }
+}
+}  // namespace
+
+std::vector<DownsampledPoint> SeriesDownsampler::downsample(
+    const double* x, const double* y, const double* low, const double* high,
+    const std::size_t size, const std::size_t targetPoints) {
+  requireTarget(targetPoints);
+  std::vector<DownsampledPoint> points;
+  if (size <= targetPoints) {
+    points.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+      const DownsampledPoint point = {x[i], y[i], low[i], high[i]};
+      points.push_back(point);
+    }
+    return points;
+  }
+
+  points.reserve(targetPoints);
+  const DownsampledPoint first = {x[0], y[0], low[0], high[0]};
+  points.push_back(first);
+  const std::size_t bucketCount = targetPoints - 2;
+  const double every = static_cast<double>(size - 2) / bucketCount;
+  const auto bucketStart = [every, size](const std::size_t bucket) {
+    return std::min(static_cast<std::size_t>(bucket * every) + 1, size - 1);
+  };
+
+  std::size_t previous = 0;
+  for (std::size_t bucket = 0; bucket < bucketCount; ++bucket) {
+    const std::size_t begin = bucketStart(bucket);
+    const std::size_t end = bucketStart(bucket + 1);
+    // The last bucket looks ahead to the fixed last point.
+    const std::size_t nextEnd =
+        bucket + 1 == bucketCount ? size : bucketStart(bucket + 2);
+    double nextX = 0.0;
+    double nextY = 0.0;
+    for (std::size_t i = end; i < nextEnd; ++i) {
+      nextX += x[i];
+      nextY += y[i];
+    }
+    nextX /= (nextEnd - end);
+    nextY /= (nextEnd - end);
+
+    const double anchorX = x[previous];
+    const double anchorY = y[previous];
+    double largestArea = -1.0;
+    std::size_t selected = begin;
+    double minimum = low[begin];
+    double maximum = high[begin];
+    for (std::size_t i = begin; i < end; ++i) {
+      const double area = std::abs((anchorX - nextX) * (y[i] - anchorY) -
+                                   (anchorX - x[i]) * (nextY - anchorY));
+      if (area > largestArea) {
+        largestArea = area;
+        selected = i;
+      }
+      minimum = std::min(minimum, low[i]);
+      maximum = std::max(maximum, high[i]);
+    }
+    const DownsampledPoint point = {x[selected], y[selected], minimum, maximum};
+    points.push_back(point);
+    previous = selected;
+  }
+
+  const DownsampledPoint last = {x[size - 1], y[size - 1], low[size - 1],
+                                 high[size - 1]};
+  points.push_back(last);
+  return points;
+}
+
+std::vector<DownsampledPoint> SeriesDownsampler::downsample(
+    const std::vector<double>& x, const std::vector<double>& y,
+    const std::size_t targetPoints) {
+  if (x.size() != y.size()) {
+    throw std::invalid_argument("Series columns must have the same length");
+  }
+  return downsample(x.data(), y.data(), y.data(), y.data(), x.size(), targetPoints);
+}
+
+IncrementalDownsampler::IncrementalDownsampler(const std::size_t targetPoints)
+    : targetPoints(targetPoints),
+      bucketWidth(1),
+      total(0),
+      firstX(0.0),
+      firstY(0.0),
+      lastX(0.0),
+      lastY(0.0) {
+  requireTarget(targetPoints);
+  buckets.reserve(2 * targetPoints + 1);
+}
+
+void IncrementalDownsampler::add(const double x, const double y) {
+  if (total == 0) {
+    firstX = x;
+    firstY = y;
+  }
+  lastX = x;
+  lastY = y;
+  ++total;
+
+  if (!buckets.empty() && buckets.back().count < bucketWidth) {
+    Bucket& bucket = buckets.back();
+    ++bucket.count;
+    if (y < bucket.lowY) {
+      bucket.lowX = x;
+      bucket.lowY = y;
+    }
+    if (y > bucket.highY) {
+      bucket.highX = x;
+      bucket.highY = y;
+    }
+    return;
+  }
+  const Bucket bucket = {1, x, y, x, y};
+  buckets.push_back(bucket);
+  if (buckets.size() > 2 * targetPoints) {
+    compact();
+  }
+}
+
+void IncrementalDownsampler::compact() {
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < buckets.size(); i += 2) {
+    Bucket merged = buckets[i];
+    if (i + 1 < buckets.size()) {
+      const Bucket& next = buckets[i + 1];
+      merged.count += next.count;
+      if (next.lowY < merged.lowY) {
+        merged.lowX = next.lowX;
+        merged.lowY = next.lowY;
+      }
+      if (next.highY > merged.highY) {
+        merged.highX = next.highX;
+        merged.highY = next.highY;
+      }
+    }
+    buckets[kept++] = merged;
+  }
+  buckets.resize(kept);
+  bucketWidth *= 2;
+}
+
+std::size_t IncrementalDownsampler::size() const {
+  return total;
+}
+
+std::vector<DownsampledPoint> IncrementalDownsampler::getPoints() const {
+  if (total == 0) {
+    return std::vector<DownsampledPoint>();
+  }
+
+  // Candidate columns: the first point, each bucket's extremes in x order,
+  // then the last point.
+  std::vector<double> x, y, low, high;
+  const std::size_t capacity = 2 * buckets.size() + 2;
+  x.reserve(capacity);
+  y.reserve(capacity);
+  low.reserve(capacity);
+  high.reserve(capacity);
+  const auto append = [&](const double px, const double py, const double pl,
+                          const double ph) {
+    x.push_back(px);
+    y.push_back(py);
+    low.push_back(pl);
+    high.push_back(ph);
+  };
+  append(firstX, firstY, firstY, firstY);
+  for (const Bucket& bucket : buckets) {
+    const bool lowFirst = bucket.lowX <= bucket.highX;
+    const double candidateX[2] = {lowFirst ? bucket.lowX : bucket.highX,
+                                  lowFirst ? bucket.highX : bucket.lowX};
+    const double candidateY[2] = {lowFirst ? bucket.lowY : bucket.highY,
+                                  lowFirst ? bucket.highY : bucket.lowY};
+    for (int c = 0; c < 2; ++c) {
+      if (c == 1 && candidateX[1] == candidateX[0]) {
+        continue;
+      }
+      if (candidateX[c] == firstX || candidateX[c] == lastX) {
+        continue;
+      }
+      append(candidateX[c], candidateY[c], bucket.lowY, bucket.highY);
+    }
+  }
+  if (total > 1) {
+    append(lastX, lastY, lastY, lastY);
+  }
+  return SeriesDownsampler::downsample(x.data(), y.data(), low.data(), high.data(),
+                                       x.size(), targetPoints);
+}
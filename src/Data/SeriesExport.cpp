@@ -0,0 +1,70 @@
+/**
+ * @file SeriesExport.cpp
+ * @brief Implementation of the SeriesExport class.
+ */
+
+#include "Data/SeriesExport.h"
+
+namespace {
+const char* const CSV_HEADER = "series,sol,value,minimum,maximum\n";
+
+double distanceOf(const SOLData& solData) {
+  return static_cast<double>(solData.getNavigationData().finalDistance.getValue());
+}
+
+void writeSeries(std::ostream& output, const char* name,
+                 const std::vector<DownsampledPoint>& points) {
+  for (const DownsampledPoint& point : points) {
+    output << name << ',' << static_cast<long>(point.x) << ',' << point.y << ','
+           << point.minimum << ',' << point.maximum << '\n';
+  }
+}
+}  // namespace
+
+SeriesExport::SeriesExport(const std::size_t targetPoints)
+    : temperature(targetPoints), distance(targetPoints) {}
+
+std::vector<DownsampledPoint> SeriesExport::getTemperatureSeries() const {
+  return temperature.getPoints();
+}
+
+std::vector<DownsampledPoint> SeriesExport::getDistanceSeries() const {
+  return distance.getPoints();
+}
+
+void SeriesExport::write(std::ostream& output) const {
+  output << CSV_HEADER;
+  writeSeries(output, "temperature", temperature.getPoints());
+  writeSeries(output, "distance", distance.getPoints());
+}
+
+void SeriesExport::onSOLFinalized(const SOLData& solData) {
+  temperature.add(solData.getSolNumber(), solData.getTemperatureData());
+  distance.add(solData.getSolNumber(), distanceOf(solData));
+}
+
+void SeriesExport::write(const DataStorage& storage, const std::size_t targetPoints,
+                         std::ostream& output) {
+  std::vector<double> sols;
+  std::vector<double> temperatures;
+  std::vector<double> distances;
+  sols.reserve(storage.size());
+  temperatures.reserve(storage.size());
+  distances.reserve(storage.size());
+  storage.forEachBlock([&](const SOLColumnStore& block) {
+    sols.insert(sols.end(), block.getSolNumbers().begin(), block.getSolNumbers().end());
+    temperatures.insert(temperatures.end(), block.getTemperatures().begin(),
+                        block.getTemperatures().end());
+    distances.insert(distances.end(), block.getDistances().begin(),
+                     block.getDistances().end());
+  });
+  output << CSV_HEADER;
+  writeSeries(output, "temperature",
+              SeriesDownsampler::downsample(sols.data(), temperatures.data(),
+                                            temperatures.data(), temperatures.data(),
+                                            sols.size(), targetPoints));
+  writeSeries(output, "distance",
+              SeriesDownsampler::downsample(sols.data(), distances.data(),
+                                            distances.data(), distances.data(),
+                                            sols.size(), targetPoints));
+}
@@ -5,9 +5,12 @@
 
 #include "Data/SOLManager.h"
 #include <algorithm>
+#include "Data/AsyncSOLObserver.h"
 
 SOLManager::SOLManager(int totalSOLs) : currentSOL(INITIAL_SOL), totalSOLs(INITIAL_SOL) {}
 
+SOLManager::~SOLManager() = default;
+
 void SOLManager::advanceSOL() {
   currentSOL++;
   totalSOLs++;
@@ -21,10 +24,20 @@ int SOLManager::getTotalSOLs() const {
   return totalSOLs;
 }
 
+void SOLManager::restore(const int currentSOL, const int totalSOLs) {
+  this->currentSOL = currentSOL;
+  this->totalSOLs = totalSOLs;
+}
+
 void SOLManager::addObserver(SOLObserverPtr observer) {
   observers.push_back(observer);
 }
 
+void SOLManager::addObserver(SOLObserverPtr observer, const BackpressurePolicy policy,
+                             const std::size_t capacity) {
+  dispatchers.push_back(std::make_shared<AsyncSOLObserver>(std::move(observer), capacity, policy));
+}
+
 void SOLManager::removeObserver(const SOLObserverPtr& observer) {
   observers.erase(std::remove_if(observers.begin(), observers.end(),
                   [&observer](const std::weak_ptr<SOLObserver>& observer_weak) {
@@ -34,6 +47,18 @@ void SOLManager::removeObserver(const SOLObserverPtr& observer) {
                       return false;  // Skip if the weak_ptr is expired
                   }),
                   observers.end());
+  // Destroying a dispatcher delivers what is queued and joins its thread.
+  dispatchers.erase(std::remove_if(dispatchers.begin(), dispatchers.end(),
+                                   [&observer](const std::shared_ptr<AsyncSOLObserver>& dispatcher) {
+                                     return dispatcher->getTarget() == observer;
+                                   }),
+                    dispatchers.end());
+}
+
+void SOLManager::flushObservers() const {
+  for (const std::shared_ptr<AsyncSOLObserver>& dispatcher : dispatchers) {
+    dispatcher->flush();
+  }
 }
 
 void SOLManager::notifyObservers(const SOLData& solData) const {
@@ -42,4 +67,8 @@ void SOLManager::notifyObservers(const SOLData& solData) const {
       observer->onSOLFinalized(solData);
     }
   }
+  // The manager owns its dispatchers, so they need no weak_ptr lock.
+  for (const std::shared_ptr<AsyncSOLObserver>& dispatcher : dispatchers) {
+    dispatcher->onSOLFinalized(solData);
+  }
 }
@@ -7,6 +7,8 @@
 #include <cmath>
 #include <stdexcept>
 
+DirectionManager::DirectionManager(const double angle) : currentAngle(angle) {}
+
 void DirectionManager::rotate(const Direction direction, const double angle) {
     if (direction == Direction::Left) {
         currentAngle += angle;
@@ -54,3 +54,20 @@ void Navigation::reset() {
   finalDistance = 0;
   finalDirection = Direction::Forward;
 }
+
+NavigationState Navigation::getState() const {
+  NavigationState state;
+  state.x = position.getX();
+  state.y = position.getY();
+  state.angle = directionManager.getCurrentAngle();
+  state.finalDistance = finalDistance;
+  state.finalDirection = finalDirection;
+  return state;
+}
+
+void Navigation::restoreState(const NavigationState& state) {
+  position = Position(state.x, state.y);
+  directionManager = DirectionManager(state.angle);
+  finalDistance = state.finalDistance;
+  finalDirection = state.finalDirection;
+}
@@ -7,6 +7,16 @@
 #include <cmath>
 #include <iostream> // DEBUG
 
+Position::Position(const double x, const double y) : x(x), y(y) {}
+
+double Position::getX() const {
+    return x;
+}
+
+double Position::getY() const {
+    return y;
+}
+
 void Position::update(const Direction direction, const double distance) {
     switch (direction) {
         case Direction::Forward:
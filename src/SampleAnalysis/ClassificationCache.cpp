@@ -0,0 +1,159 @@
+/**
+ * @file ClassificationCache.cpp
+ * @brief Implementation of the ClassificationCache class.
+ */
+
+#include "Subsystems/ClassificationCache.h"
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace {
+const std::size_t CACHE_LINE_SIZE = 64;
+const std::size_t PROBE_BUCKETS = 2;
+
+// 64-bit finalizer from MurmurHash3.
+std::uint64_t mix(std::uint64_t key) {
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  key *= 0xc4ceb9fe1a85ec53ULL;
+  key ^= key >> 33;
+  return key;
+}
+}  // namespace
+
+double ClassificationCache::CacheStatistics::hitRate() const {
+  const std::uint64_t lookups = hits + misses;
+  return lookups == 0 ? 0.0 : static_cast<double>(hits) / lookups;
+}
+
+ClassificationCache::ClassificationCache(const std::size_t capacity,
+                                         const int mantissaBits)
+    : buckets(nullptr),
+      bucketMask(0),
+      mantissaShift(52 - mantissaBits),
+      generation(1),
+      libraryVersion(0) {
+  if (mantissaBits < 1 || mantissaBits > 20) {
+    throw std::invalid_argument("Mantissa bits must be in [1, 20]");
+  }
+
+  std::size_t bucketCount = 1;
+  while (bucketCount * SLOTS_PER_BUCKET < capacity) {
+    bucketCount <<= 1;
+  }
+  bucketMask = bucketCount - 1;
+
+  storage.reset(new unsigned char[bucketCount * sizeof(Bucket) + CACHE_LINE_SIZE]);
+  const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(storage.get());
+  const std::uintptr_t aligned =
+      (address + CACHE_LINE_SIZE - 1) & ~(static_cast<std::uintptr_t>(CACHE_LINE_SIZE) - 1);
+  buckets = reinterpret_cast<Bucket*>(aligned);
+  for (std::size_t i = 0; i < bucketCount; ++i) {
+    new (&buckets[i]) Bucket();
+  }
+}
+
+bool ClassificationCache::lookup(const double wavelength, const double intensity,
+                                 int& elementId) {
+  const std::uint64_t wavelengthBits = bitsOf(wavelength);
+  const std::uint64_t intensityBits = bitsOf(intensity);
+  std::size_t bucket = homeBucket(wavelengthBits, intensityBits);
+
+  for (std::size_t probe = 0; probe < PROBE_BUCKETS; ++probe) {
+    for (const Slot& slot : buckets[bucket].slots) {
+      if (slot.generation != generation) {
+        // Entries are never removed individually, so an empty slot ends the
+        // probe sequence.
+        ++statistics.misses;
+        return false;
+      }
+      if (slot.wavelengthBits == wavelengthBits &&
+          slot.intensityBits == intensityBits) {
+        elementId = slot.elementId;
+        ++statistics.hits;
+        return true;
+      }
+    }
+    bucket = (bucket + 1) & bucketMask;
+  }
+  ++statistics.misses;
+  return false;
+}
+
+void ClassificationCache::insert(const double wavelength, const double intensity,
+                                 const int elementId) {
+  const std::uint64_t wavelengthBits = bitsOf(wavelength);
+  const std::uint64_t intensityBits = bitsOf(intensity);
+  const std::size_t home = homeBucket(wavelengthBits, intensityBits);
+  std::size_t bucket = home;
+
+  for (std::size_t probe = 0; probe < PROBE_BUCKETS; ++probe) {
+    for (Slot& slot : buckets[bucket].slots) {
+      if (slot.generation != generation ||
+          (slot.wavelengthBits == wavelengthBits &&
+           slot.intensityBits == intensityBits)) {
+        slot.wavelengthBits = wavelengthBits;
+        slot.intensityBits = intensityBits;
+        slot.generation = generation;
+        slot.elementId = elementId;
+        return;
+      }
+    }
+    bucket = (bucket + 1) & bucketMask;
+  }
+
+  // Both buckets are full: evict a pseudo-randomly chosen slot of the home
+  // bucket so that keys displaced into the neighbour stay reachable.
+  Slot& victim = buckets[home].slots[(wavelengthBits ^ intensityBits) %
+                                     SLOTS_PER_BUCKET];
+  victim.wavelengthBits = wavelengthBits;
+  victim.intensityBits = intensityBits;
+  victim.elementId = elementId;
+  ++statistics.evictions;
+}
+
+void ClassificationCache::setLibraryVersion(const unsigned int version) {
+  if (version != libraryVersion) {
+    libraryVersion = version;
+    invalidate();
+  }
+}
+
+void ClassificationCache::invalidate() {
+  ++generation;
+  if (generation == 0) {
+    // The counter wrapped: stale slots could alias the new generation.
+    std::memset(static_cast<void*>(buckets), 0, (bucketMask + 1) * sizeof(Bucket));
+    generation = 1;
+  }
+  ++statistics.invalidations;
+}
+
+const ClassificationCache::CacheStatistics& ClassificationCache::getStatistics()
+    const {
+  return statistics;
+}
+
+std::size_t ClassificationCache::getCapacity() const {
+  return (bucketMask + 1) * SLOTS_PER_BUCKET;
+}
+
+std::uint64_t ClassificationCache::bitsOf(const double value) {
+  std::uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+std::uint32_t ClassificationCache::quantize(const std::uint64_t bits) const {
+  return static_cast<std::uint32_t>(bits >> mantissaShift);
+}
+
+std::size_t ClassificationCache::homeBucket(const std::uint64_t wavelengthBits,
+                                            const std::uint64_t intensityBits) const {
+  const std::uint64_t key =
+      (static_cast<std::uint64_t>(quantize(wavelengthBits)) << 32) |
+      quantize(intensityBits);
+  return static_cast<std::size_t>(mix(key)) & bucketMask;
+}
@@ -5,14 +5,47 @@
 
 #include "Subsystems/SampleAnalysis.h"
 #include "Subsystems/SampleClassification.h"
+#include "Utility/MakeUnique.h"
 
 void SampleAnalysis::addRecord(const Measurement& wavelength,
                                double intensity) {
   sample = std::make_pair(wavelength, intensity);
+  sampleCollected = true;
 }
 
 void SampleAnalysis::classifySample() {
-  classification.classify(sample.first.toBaseUnit(), sample.second);
+  const double wavelength = sample.first.toBaseUnit();
+  const double intensity = sample.second;
+  if (!classificationCache) {
+    classification.classify(wavelength, intensity);
+    return;
+  }
+
+  classificationCache->setLibraryVersion(classification.getLibraryVersion());
+  int elementId;
+  if (!classificationCache->lookup(wavelength, intensity, elementId)) {
+    elementId = classification.matchElement(wavelength, intensity);
+    classificationCache->insert(wavelength, intensity, elementId);
+  }
+  classification.applyElementMatch(elementId);
+}
+
+SampleReading SampleAnalysis::getSampleReading() const {
+  SampleReading reading;
+  if (sampleCollected) {
+    reading.wavelength = sample.first.toBaseUnit();
+    reading.intensity = sample.second;
+    reading.collected = true;
+  }
+  return reading;
+}
+
+void SampleAnalysis::enableClassificationCache(const std::size_t capacity) {
+  classificationCache = make_unique_ptr<ClassificationCache>(capacity);
+}
+
+const ClassificationCache* SampleAnalysis::getClassificationCache() const {
+  return classificationCache.get();
 }
 
 std::string SampleAnalysis::getElementClassification() const {
@@ -26,5 +59,14 @@ SampleClassification SampleAnalysis::getSampleClassification() const {
 void SampleAnalysis::reset() {
   sample.first = Measurement();
   sample.second = 0.0;
+  sampleCollected = false;
   classification = SampleClassification();
 }
+
+void SampleAnalysis::restoreSample(const SampleReading& reading, const int elementId) {
+  sample.first = Measurement(reading.wavelength, UnitType::Distance,
+                             static_cast<int>(DistanceUnit::Meter));
+  sample.second = reading.intensity;
+  sampleCollected = reading.collected;
+  classification = SampleClassification(elementId);
+}
@@ -37,45 +37,85 @@ SampleClassification::initializeIntensityRanges() {
           {"Carbon", 0.88, 0.6, 0.3}};
 }
 
-SampleClassification::SampleClassification()
-    : elementLibrary(initializeElementLibrary()),
-      intensityRanges(initializeIntensityRanges()) {}
+SampleClassification::SampleClassification(const int elementId)
+    : elementId(elementId) {}
+
+const std::vector<SampleClassification::Element>&
+SampleClassification::getElementLibrary() {
+  static const std::vector<Element> elementLibrary = initializeElementLibrary();
+  return elementLibrary;
+}
+
+const std::vector<SampleClassification::IntensityRanges>&
+SampleClassification::getIntensityRanges() {
+  static const std::vector<IntensityRanges> intensityRanges =
+      initializeIntensityRanges();
+  return intensityRanges;
+}
+
+const std::string& SampleClassification::getElementName(const int elementId) {
+  static const std::string unclassified;
+  static const std::string unknown = "Unknown";
+  if (elementId == UNKNOWN_ELEMENT_ID) {
+    return unknown;
+  }
+  if (elementId < 0) {
+    return unclassified;
+  }
+  return getElementLibrary()[elementId].name;
+}
 
 void SampleClassification::classify(const double wavelength, const double intensity) {
-  std::string intensityLevel;
-  for (const auto& range : intensityRanges) {
-    if (intensity >= range.highIntensityRange) {
-      intensityLevel = "high";
-    } else if (intensity >= range.mediumIntensityRange) {
-      intensityLevel = "medium";
-    } else if (intensity >= range.lowIntensityRange) {
-      intensityLevel = "low";
-    } else {
-      continue;
-    }
-    for (const auto& element : elementLibrary) {
-      if (element.name == range.elementName) {
-        if ((intensityLevel == "high" &&
-             wavelength >= element.highIntensityRange.first &&
-             wavelength <= element.highIntensityRange.second) ||
-            (intensityLevel == "medium" &&
-             wavelength >= element.mediumIntensityRange.first &&
-             wavelength <= element.mediumIntensityRange.second) ||
-            (intensityLevel == "low" &&
-             wavelength >= element.lowIntensityRange.first &&
-             wavelength <= element.lowIntensityRange.second)) {
-          classification = element.name;
-          break;
-        } else {
-          classification = "Unknown";
-        }
+  applyElementMatch(matchElement(wavelength, intensity));
+}
+
+int SampleClassification::matchElement(const double wavelength,
+                                       const double intensity) const {
+  // The last intensity range the sample qualifies for decides the result.
+  const std::vector<Element>& elementLibrary = getElementLibrary();
+  int elementId = UNCLASSIFIED_ELEMENT_ID;
+  for (const auto& range : getIntensityRanges()) {
+    std::pair<int, int> band;
+    for (size_t i = 0; i < elementLibrary.size(); ++i) {
+      const Element& element = elementLibrary[i];
+      if (element.name != range.elementName) {
+        continue;
+      }
+      if (intensity >= range.highIntensityRange) {
+        band = element.highIntensityRange;
+      } else if (intensity >= range.mediumIntensityRange) {
+        band = element.mediumIntensityRange;
+      } else if (intensity >= range.lowIntensityRange) {
+        band = element.lowIntensityRange;
+      } else {
+        break;
       }
+      elementId = (wavelength >= band.first && wavelength <= band.second)
+                      ? static_cast<int>(i)
+                      : UNKNOWN_ELEMENT_ID;
+      break;
     }
   }
+  return elementId;
+}
+
+void SampleClassification::applyElementMatch(const int matchedElementId) {
+  if (matchedElementId == UNCLASSIFIED_ELEMENT_ID) {
+    return;
+  }
+  elementId = matchedElementId;
+}
+
+unsigned int SampleClassification::getLibraryVersion() const {
+  return ELEMENT_LIBRARY_VERSION;
 }
 
 const std::string& SampleClassification::getClassifiedElement() const {
-  return classification;
+  return getElementName(elementId);
+}
+
+int SampleClassification::getElementId() const {
+  return elementId;
 }
 
 SampleClassification SampleClassification::getSampleClassification() const {
@@ -0,0 +1,267 @@
+/**
+ * @file SampleClustering.cpp
+ * @brief Implementation of the SampleClustering class.
+ */
+
+#include "Subsystems/SampleClustering.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include "Data/DataStorage.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+/** @brief Below this many samples per worker, threading costs more than it saves. */
+const std::size_t MIN_SAMPLES_PER_THREAD = 16384;
+/** @brief Upper bound on the samples k-means++ seeding looks at. */
+const std::size_t SEEDING_SAMPLE_LIMIT = 8192;
+
+/**
+ * @brief Runs fn(begin, end, worker) over [0, count) split across workers.
+ * The calling thread processes the first chunk itself.
+ */
+template <typename Function>
+void parallelFor(const std::size_t count, const unsigned int threads,
+                 Function fn) {
+  const std::size_t byWork = std::max<std::size_t>(1, count / MIN_SAMPLES_PER_THREAD);
+  const std::size_t workers = std::min<std::size_t>(threads, byWork);
+  const std::size_t chunk = (count + workers - 1) / workers;
+
+  std::vector<std::thread> pool;
+  for (std::size_t worker = 1; worker < workers; ++worker) {
+    const std::size_t begin = std::min(count, worker * chunk);
+    const std::size_t end = std::min(count, begin + chunk);
+    pool.emplace_back(fn, begin, end, worker);
+  }
+  fn(0, std::min(count, chunk), 0);
+  for (auto& thread : pool) {
+    thread.join();
+  }
+}
+
+/**
+ * @brief Assigns samples [begin, end) to their nearest centroid.
+ * @return The sum of squared distances to the assigned centroids.
+ */
+double assignNearest(const float* xs, const float* ys, const std::size_t begin,
+                     const std::size_t end, const float* centroidX,
+                     const float* centroidY, const std::size_t k,
+                     std::int32_t* labels) {
+  double inertia = 0.0;
+  std::size_t i = begin;
+#if defined(__SSE2__)
+  for (; i + 4 <= end; i += 4) {
+    const __m128 px = _mm_loadu_ps(xs + i);
+    const __m128 py = _mm_loadu_ps(ys + i);
+    __m128 best = _mm_set1_ps(FLT_MAX);
+    __m128i bestIndex = _mm_setzero_si128();
+    for (std::size_t c = 0; c < k; ++c) {
+      const __m128 dx = _mm_sub_ps(px, _mm_set1_ps(centroidX[c]));
+      const __m128 dy = _mm_sub_ps(py, _mm_set1_ps(centroidY[c]));
+      const __m128 distance = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+      const __m128i closer = _mm_castps_si128(_mm_cmplt_ps(distance, best));
+      best = _mm_min_ps(distance, best);
+      bestIndex = _mm_or_si128(
+          _mm_and_si128(closer, _mm_set1_epi32(static_cast<int>(c))),
+          _mm_andnot_si128(closer, bestIndex));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(labels + i), bestIndex);
+    float distances[4];
+    _mm_storeu_ps(distances, best);
+    inertia += distances[0] + distances[1] + distances[2] + distances[3];
+  }
+#endif
+  for (; i < end; ++i) {
+    float best = FLT_MAX;
+    std::int32_t bestIndex = 0;
+    for (std::size_t c = 0; c < k; ++c) {
+      const float dx = xs[i] - centroidX[c];
+      const float dy = ys[i] - centroidY[c];
+      const float distance = dx * dx + dy * dy;
+      if (distance < best) {
+        best = distance;
+        bestIndex = static_cast<std::int32_t>(c);
+      }
+    }
+    labels[i] = bestIndex;
+    inertia += best;
+  }
+  return inertia;
+}
+
+/**
+ * @brief Picks initial centroids with k-means++ over a uniform subsample.
+ */
+void seedCentroids(const std::vector<float>& xs, const std::vector<float>& ys,
+                   const std::size_t k, std::mt19937_64& rng,
+                   std::vector<float>& centroidX, std::vector<float>& centroidY) {
+  const std::size_t n = xs.size();
+  const std::size_t m = std::min(n, SEEDING_SAMPLE_LIMIT);
+  std::vector<std::size_t> candidates(m);
+  std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+  for (std::size_t i = 0; i < m; ++i) {
+    candidates[i] = (m == n) ? i : pick(rng);
+  }
+
+  std::vector<double> nearest(m, DBL_MAX);
+  std::size_t chosen = candidates[std::uniform_int_distribution<std::size_t>(0, m - 1)(rng)];
+  for (std::size_t c = 0; c < k; ++c) {
+    centroidX[c] = xs[chosen];
+    centroidY[c] = ys[chosen];
+
+    double total = 0.0;
+    for (std::size_t i = 0; i < m; ++i) {
+      const double dx = xs[candidates[i]] - centroidX[c];
+      const double dy = ys[candidates[i]] - centroidY[c];
+      nearest[i] = std::min(nearest[i], dx * dx + dy * dy);
+      total += nearest[i];
+    }
+    if (total <= 0.0) {
+      chosen = candidates[std::uniform_int_distribution<std::size_t>(0, m - 1)(rng)];
+      continue;
+    }
+    double target = std::uniform_real_distribution<double>(0.0, total)(rng);
+    std::size_t i = 0;
+    for (; i + 1 < m && target >= nearest[i]; ++i) {
+      target -= nearest[i];
+    }
+    chosen = candidates[i];
+  }
+}
+}  // namespace
+
+SampleClustering::SampleClustering(const ClusteringOptions& options)
+    : options(options) {}
+
+ClusteringResult SampleClustering::clusterSamples(const DataStorage& storage) const {
+  // Only the SOL, element and reading columns are touched, one block at a time.
+  std::vector<int> solNumbers;
+  std::vector<SampleReading> readings;
+  const bool unknownOnly = options.unknownOnly;
+  storage.forEachBlock([&](const SOLColumnStore& block) {
+    const ColumnSpan<int> sols = block.getSolNumbers();
+    const ColumnSpan<std::int16_t> elementIds = block.getElementIds();
+    const ColumnSpan<SampleReading> sampleReadings = block.getSampleReadings();
+    for (std::size_t row = 0; row < block.size(); ++row) {
+      if (!sampleReadings[row].collected) {
+        continue;
+      }
+      // Unclassified samples and unknown matches are both unidentified.
+      if (unknownOnly && elementIds[row] >= 0) {
+        continue;
+      }
+      solNumbers.push_back(sols[row]);
+      readings.push_back(sampleReadings[row]);
+    }
+  });
+  return clusterReadings(solNumbers, readings);
+}
+
+ClusteringResult SampleClustering::clusterReadings(
+    const std::vector<int>& solNumbers,
+    const std::vector<SampleReading>& readings) const {
+  if (solNumbers.size() != readings.size()) {
+    throw std::invalid_argument("SOL numbers and readings differ in size");
+  }
+  ClusteringResult result;
+  const std::size_t n = readings.size();
+  if (n == 0 || options.clusterCount == 0) {
+    return result;
+  }
+  const std::size_t k = std::min(options.clusterCount, n);
+  const unsigned int threads =
+      options.threadCount != 0
+          ? options.threadCount
+          : std::max(1u, std::thread::hardware_concurrency());
+
+  // Normalize both dimensions so wavelength (meters) and intensity weigh equally.
+  double meanX = 0.0, meanY = 0.0;
+  for (const auto& reading : readings) {
+    meanX += reading.wavelength;
+    meanY += reading.intensity;
+  }
+  meanX /= n;
+  meanY /= n;
+  double varianceX = 0.0, varianceY = 0.0;
+  for (const auto& reading : readings) {
+    varianceX += (reading.wavelength - meanX) * (reading.wavelength - meanX);
+    varianceY += (reading.intensity - meanY) * (reading.intensity - meanY);
+  }
+  const double scaleX = varianceX > 0.0 ? std::sqrt(varianceX / n) : 1.0;
+  const double scaleY = varianceY > 0.0 ? std::sqrt(varianceY / n) : 1.0;
+
+  std::vector<float> xs(n), ys(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    xs[i] = static_cast<float>((readings[i].wavelength - meanX) / scaleX);
+    ys[i] = static_cast<float>((readings[i].intensity - meanY) / scaleY);
+  }
+
+  std::mt19937_64 rng(options.seed);
+  std::vector<float> centroidX(k), centroidY(k);
+  seedCentroids(xs, ys, k, rng, centroidX, centroidY);
+
+  // Mini-batch updates with a per-centroid learning rate of 1 / count.
+  const std::size_t batchSize = std::min(options.batchSize, n);
+  std::vector<float> batchX(batchSize), batchY(batchSize);
+  std::vector<std::int32_t> batchLabels(batchSize);
+  std::vector<std::size_t> centroidCounts(k, 0);
+  std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+  for (std::size_t iteration = 0; iteration < options.iterations; ++iteration) {
+    for (std::size_t j = 0; j < batchSize; ++j) {
+      const std::size_t index = pick(rng);
+      batchX[j] = xs[index];
+      batchY[j] = ys[index];
+    }
+    parallelFor(batchSize, threads,
+                [&](std::size_t begin, std::size_t end, std::size_t) {
+                  assignNearest(batchX.data(), batchY.data(), begin, end,
+                                centroidX.data(), centroidY.data(), k,
+                                batchLabels.data());
+                });
+    for (std::size_t j = 0; j < batchSize; ++j) {
+      const std::int32_t c = batchLabels[j];
+      const float rate = 1.0f / static_cast<float>(++centroidCounts[c]);
+      centroidX[c] += rate * (batchX[j] - centroidX[c]);
+      centroidY[c] += rate * (batchY[j] - centroidY[c]);
+    }
+  }
+
+  // Final full assignment; each worker keeps its own sizes and inertia.
+  std::vector<std::int32_t> labels(n);
+  std::vector<std::vector<std::size_t>> workerSizes(threads,
+                                                    std::vector<std::size_t>(k, 0));
+  std::vector<double> workerInertia(threads, 0.0);
+  parallelFor(n, threads, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+    workerInertia[worker] = assignNearest(xs.data(), ys.data(), begin, end,
+                                          centroidX.data(), centroidY.data(), k,
+                                          labels.data());
+    for (std::size_t i = begin; i < end; ++i) {
+      ++workerSizes[worker][labels[i]];
+    }
+  });
+
+  result.clusters.resize(k);
+  for (std::size_t c = 0; c < k; ++c) {
+    result.clusters[c].wavelength = centroidX[c] * scaleX + meanX;
+    result.clusters[c].intensity = centroidY[c] * scaleY + meanY;
+    result.clusters[c].size = 0;
+    for (unsigned int worker = 0; worker < threads; ++worker) {
+      result.clusters[c].size += workerSizes[worker][c];
+    }
+  }
+  for (unsigned int worker = 0; worker < threads; ++worker) {
+    result.inertia += workerInertia[worker];
+  }
+  result.assignments.resize(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    result.assignments[i].solNumber = solNumbers[i];
+    result.assignments[i].cluster = labels[i];
+  }
+  return result;
+}
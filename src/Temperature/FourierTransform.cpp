@@ -0,0 +1,163 @@
+/**
+ * @file FourierTransform.cpp
+ * @brief Implementation of the FourierTransform class.
+ */
+
+#include "Temperature/FourierTransform.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+const double PI = 3.14159265358979323846;
+
+bool isPowerOfTwo(const std::size_t value) {
+  return value != 0 && (value & (value - 1)) == 0;
+}
+}  // namespace
+
+FourierTransform::FourierTransform() : size(0), paddedSize(0) {}
+
+void FourierTransform::prepare(const std::size_t length) {
+  if (length == size) {
+    return;
+  }
+  size = length;
+  paddedSize = 1;
+  if (isPowerOfTwo(length)) {
+    paddedSize = length;
+  } else {
+    while (paddedSize < 2 * length - 1) {
+      paddedSize <<= 1;
+    }
+  }
+
+  twiddles.resize(paddedSize / 2);
+  for (std::size_t k = 0; k < twiddles.size(); ++k) {
+    twiddles[k] = std::polar(1.0, -2.0 * PI * k / paddedSize);
+  }
+  bitReversal.resize(paddedSize);
+  std::size_t bits = 0;
+  while ((std::size_t(1) << bits) < paddedSize) {
+    ++bits;
+  }
+  for (std::size_t i = 0; i < paddedSize; ++i) {
+    std::size_t reversed = 0;
+    for (std::size_t b = 0; b < bits; ++b) {
+      reversed |= ((i >> b) & 1) << (bits - 1 - b);
+    }
+    bitReversal[i] = reversed;
+  }
+
+  if (paddedSize == length) {
+    chirp.clear();
+    chirpSpectrum.clear();
+    work.clear();
+    return;
+  }
+  // w_k = e^{-i pi k^2 / n}; reducing k^2 mod 2n keeps the angle accurate.
+  chirp.resize(length);
+  for (std::size_t k = 0; k < length; ++k) {
+    const std::size_t square = static_cast<std::size_t>(
+        (static_cast<unsigned long long>(k) * k) % (2 * length));
+    chirp[k] = std::polar(1.0, -PI * square / length);
+  }
+  chirpSpectrum.assign(paddedSize, std::complex<double>());
+  chirpSpectrum[0] = std::conj(chirp[0]);
+  for (std::size_t k = 1; k < length; ++k) {
+    chirpSpectrum[k] = std::conj(chirp[k]);
+    chirpSpectrum[paddedSize - k] = std::conj(chirp[k]);
+  }
+  radix2(chirpSpectrum.data());
+  work.resize(paddedSize);
+}
+
+void FourierTransform::radix2(std::complex<double>* data) const {
+  for (std::size_t i = 0; i < paddedSize; ++i) {
+    if (i < bitReversal[i]) {
+      std::swap(data[i], data[bitReversal[i]]);
+    }
+  }
+  for (std::size_t length = 2; length <= paddedSize; length <<= 1) {
+    const std::size_t half = length / 2;
+    const std::size_t stride = paddedSize / length;
+    for (std::size_t start = 0; start < paddedSize; start += length) {
+      for (std::size_t j = 0; j < half; ++j) {
+        const std::complex<double> odd = data[start + j + half] * twiddles[j * stride];
+        data[start + j + half] = data[start + j] - odd;
+        data[start + j] += odd;
+      }
+    }
+  }
+}
+
+void FourierTransform::forward(std::vector<std::complex<double>>& data) {
+  prepare(data.size());
+  if (size <= 1) {
+    return;
+  }
+  if (paddedSize == size) {
+    radix2(data.data());
+    return;
+  }
+
+  for (std::size_t k = 0; k < size; ++k) {
+    work[k] = data[k] * chirp[k];
+  }
+  std::fill(work.begin() + size, work.end(), std::complex<double>());
+  radix2(work.data());
+  // The inverse transform is conj(FFT(conj(x))), so fold the conjugations
+  // into the pointwise product and the final chirp multiply.
+  for (std::size_t k = 0; k < paddedSize; ++k) {
+    work[k] = std::conj(work[k] * chirpSpectrum[k]);
+  }
+  radix2(work.data());
+  const double scale = 1.0 / paddedSize;
+  for (std::size_t k = 0; k < size; ++k) {
+    data[k] = std::conj(work[k]) * chirp[k] * scale;
+  }
+}
+
+std::size_t FourierTransform::getSize() const {
+  return size;
+}
+
+void FourierTransform::forwardReal(const std::vector<double>& input,
+                                   std::vector<std::complex<double>>& output) {
+  const std::size_t length = input.size();
+  if (length % 2 != 0) {
+    output.assign(input.begin(), input.end());
+    forward(output);
+    output.resize(length / 2 + 1);
+    return;
+  }
+
+  // Pack even samples into the real part and odd samples into the imaginary
+  // part, transform at half length, then separate the two spectra.
+  const std::size_t half = length / 2;
+  output.resize(half + 1);
+  packed.resize(half);
+  for (std::size_t j = 0; j < half; ++j) {
+    packed[j] = std::complex<double>(input[2 * j], input[2 * j + 1]);
+  }
+  forward(packed);
+  if (realTwiddles.size() != half) {
+    realTwiddles.resize(half);
+    for (std::size_t k = 0; k < half; ++k) {
+      realTwiddles[k] = std::polar(1.0, -2.0 * PI * k / length);
+    }
+  }
+  if (half == 0) {
+    output[0] = 0.0;
+    return;
+  }
+  output[0] = packed[0].real() + packed[0].imag();
+  output[half] = packed[0].real() - packed[0].imag();
+  const std::complex<double> minusHalfI(0.0, -0.5);
+  for (std::size_t k = 1; k < half; ++k) {
+    const std::complex<double> mirror = std::conj(packed[half - k]);
+    const std::complex<double> even = 0.5 * (packed[k] + mirror);
+    const std::complex<double> odd = minusHalfI * (packed[k] - mirror);
+    output[k] = even + realTwiddles[k] * odd;
+  }
+}
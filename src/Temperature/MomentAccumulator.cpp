@@ -0,0 +1,42 @@
+/**
+ * @file MomentAccumulator.cpp
+ * @brief Implementation of the MomentAccumulator struct.
+ */
+
+#include "Temperature/MomentAccumulator.h"
+#include <algorithm>
+
+void MomentAccumulator::add(const double value) {
+  if (count == 0) {
+    minimum = value;
+    maximum = value;
+  } else {
+    minimum = std::min(minimum, value);
+    maximum = std::max(maximum, value);
+  }
+  ++count;
+  const double delta = value - mean;
+  mean += delta / count;
+  m2 += delta * (value - mean);
+}
+
+void MomentAccumulator::merge(const MomentAccumulator& other) {
+  if (other.count == 0) {
+    return;
+  }
+  if (count == 0) {
+    *this = other;
+    return;
+  }
+  const double total = static_cast<double>(count + other.count);
+  const double delta = other.mean - mean;
+  mean += delta * other.count / total;
+  m2 += other.m2 + delta * delta * count * other.count / total;
+  minimum = std::min(minimum, other.minimum);
+  maximum = std::max(maximum, other.maximum);
+  count += other.count;
+}
+
+double MomentAccumulator::variance() const {
+  return count > 0 ? m2 / count : 0.0;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file OrderStatistics.cpp
+ * @brief Implementation of the OrderStatistics class.
+ */
+
+#include "Temperature/OrderStatistics.h"
+#include <algorithm>
+#include <stdexcept>
+
+OrderStatistics::OrderStatistics(const double lowerBound,
+                                 const double upperBound,
+                                 const std::size_t bucketCount)
+    : lowerBound(lowerBound),
+      bucketWidth(0.0),
+      count(0),
+      topStep(1),
+      tree(bucketCount + 1, 0),
+      buckets(bucketCount) {
+  if (bucketCount == 0 || !(upperBound > lowerBound)) {
+    throw std::invalid_argument("Invalid order statistics range");
+  }
+  bucketWidth = (upperBound - lowerBound) / bucketCount;
+  while (topStep * 2 <= bucketCount) {
+    topStep *= 2;
+  }
+}
+
+std::size_t OrderStatistics::bucketFor(const double value) const {
+  const double offset = (value - lowerBound) / bucketWidth;
+  if (!(offset > 0.0)) {
+    return 0;
+  }
+  const std::size_t last = buckets.size() - 1;
+  return offset >= static_cast<double>(last) ? last
+                                              : static_cast<std::size_t>(offset);
+}
+
+void OrderStatistics::insert(const double value) {
+  const std::size_t bucket = bucketFor(value);
+  std::vector<double>& values = buckets[bucket];
+  values.insert(std::upper_bound(values.begin(), values.end(), value), value);
+  for (std::size_t i = bucket + 1; i < tree.size(); i += i & (~i + 1)) {
+    ++tree[i];
+  }
+  ++count;
+}
+
+std::size_t OrderStatistics::size() const {
+  return count;
+}
+
+double OrderStatistics::select(std::size_t rank) const {
+  if (rank >= count) {
+    throw std::out_of_range("Rank exceeds number of values");
+  }
+  // Fenwick descent: find the last position whose prefix count is <= rank.
+  std::size_t position = 0;
+  for (std::size_t step = topStep; step > 0; step /= 2) {
+    const std::size_t next = position + step;
+    if (next < tree.size() && tree[next] <= rank) {
+      position = next;
+      rank -= tree[next];
+    }
+  }
+  return buckets[position][rank];
+}
+
+double OrderStatistics::percentile(const double percentile) const {
+  if (percentile < 0.0 || percentile > 100.0) {
+    throw std::invalid_argument("Percentile must be in [0, 100]");
+  }
+  if (count == 0)
+    return 0.0;
+
+  const double rank = percentile / 100.0 * (count - 1);
+  const std::size_t lowerRank = static_cast<std::size_t>(rank);
+  const double lower = select(lowerRank);
+  if (lowerRank + 1 >= count) {
+    return lower;
+  }
+  return lower + (rank - lowerRank) * (select(lowerRank + 1) - lower);
+}
+
+double OrderStatistics::median() const {
+  if (count == 0)
+    return 0.0;
+  if (count % 2 == 0) {
+    return (select(count / 2 - 1) + select(count / 2)) / 2.0;
+  }
+  return select(count / 2);
+}
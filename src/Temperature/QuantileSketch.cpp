@@ -0,0 +1,196 @@
+/**
+ * @file QuantileSketch.cpp
+ * @brief Implementation of the QuantileSketch class.
+ */
+
+#include "Temperature/QuantileSketch.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+const double PI = 3.14159265358979323846;
+
+/**
+ * @brief Pending values buffered per unit of compression before a merge.
+ */
+const double BUFFER_FACTOR = 5.0;
+
+/**
+ * @brief Largest quantile a centroid starting at q0 may reach, i.e. the
+ * inverse of the k1 scale function one unit past k1(q0).
+ */
+double quantileLimit(const double compression, const double q0) {
+  const double k = compression / (2.0 * PI) * std::asin(2.0 * q0 - 1.0) + 1.0;
+  if (k >= compression / 4.0) {
+    return 1.0;
+  }
+  return (std::sin(k * 2.0 * PI / compression) + 1.0) / 2.0;
+}
+}  // namespace
+
+QuantileSketch::QuantileSketch(const double compression,
+                               const std::size_t exactLimit)
+    : compression(compression),
+      exactLimit(exactLimit),
+      count(0),
+      minimum(0.0),
+      maximum(0.0),
+      exact(true) {
+  if (!(compression >= 10.0)) {
+    throw std::invalid_argument("Sketch compression must be at least 10");
+  }
+}
+
+void QuantileSketch::insert(const double value) {
+  if (count == 0) {
+    minimum = value;
+    maximum = value;
+  } else {
+    minimum = std::min(minimum, value);
+    maximum = std::max(maximum, value);
+  }
+  ++count;
+  const Centroid single = {value, 1.0};
+  pending.push_back(single);
+  if (exact) {
+    if (count > exactLimit) {
+      leaveExactMode();
+    }
+  } else if (pending.size() >= BUFFER_FACTOR * compression) {
+    flush();
+  }
+}
+
+void QuantileSketch::leaveExactMode() {
+  exact = false;
+  flush();
+}
+
+void QuantileSketch::flush() const {
+  if (pending.empty()) {
+    return;
+  }
+  const auto byMean = [](const Centroid& a, const Centroid& b) {
+    return a.mean < b.mean;
+  };
+  std::sort(pending.begin(), pending.end(), byMean);
+  merged.resize(centroids.size() + pending.size());
+  std::merge(centroids.begin(), centroids.end(), pending.begin(), pending.end(),
+             merged.begin(), byMean);
+  pending.clear();
+  if (exact) {
+    centroids.swap(merged);
+    return;
+  }
+
+  // One sweep in mean order, growing each centroid until the k1 scale
+  // function says it spans one unit.
+  const double total = static_cast<double>(count);
+  centroids.clear();
+  Centroid current = merged.front();
+  double before = 0.0;
+  double limit = quantileLimit(compression, 0.0);
+  for (std::size_t i = 1; i < merged.size(); ++i) {
+    const Centroid& next = merged[i];
+    if ((before + current.weight + next.weight) / total <= limit) {
+      current.weight += next.weight;
+      current.mean += (next.mean - current.mean) * next.weight / current.weight;
+    } else {
+      centroids.push_back(current);
+      before += current.weight;
+      limit = quantileLimit(compression, before / total);
+      current = next;
+    }
+  }
+  centroids.push_back(current);
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+  if (other.count == 0) {
+    return;
+  }
+  other.flush();
+  if (count == 0) {
+    minimum = other.minimum;
+    maximum = other.maximum;
+  } else {
+    minimum = std::min(minimum, other.minimum);
+    maximum = std::max(maximum, other.maximum);
+  }
+  count += other.count;
+  pending.insert(pending.end(), other.centroids.begin(), other.centroids.end());
+  if (exact && (!other.exact || count > exactLimit)) {
+    leaveExactMode();
+  } else {
+    flush();
+  }
+}
+
+std::size_t QuantileSketch::size() const {
+  return count;
+}
+
+bool QuantileSketch::isExact() const {
+  return exact;
+}
+
+std::size_t QuantileSketch::getFootprint() const {
+  return centroids.size() + pending.size();
+}
+
+double QuantileSketch::percentile(const double percentile) const {
+  if (percentile < 0.0 || percentile > 100.0) {
+    throw std::invalid_argument("Percentile must be in [0, 100]");
+  }
+  if (count == 0) {
+    return 0.0;
+  }
+  flush();
+
+  const double rank = percentile / 100.0 * (count - 1);
+  if (exact) {
+    const std::size_t lowerRank = static_cast<std::size_t>(rank);
+    const double lower = centroids[lowerRank].mean;
+    if (lowerRank + 1 >= centroids.size()) {
+      return lower;
+    }
+    return lower + (rank - lowerRank) * (centroids[lowerRank + 1].mean - lower);
+  }
+
+  // Each centroid sits at the middle rank of the values it covers; ranks are
+  // interpolated linearly between neighbouring centres and the exact extremes.
+  double previousRank = 0.0;
+  double previousValue = minimum;
+  double before = 0.0;
+  for (const Centroid& centroid : centroids) {
+    const double centreRank = before + (centroid.weight - 1.0) / 2.0;
+    if (rank <= centreRank) {
+      if (centreRank <= previousRank) {
+        return centroid.mean;
+      }
+      return previousValue + (rank - previousRank) / (centreRank - previousRank) *
+                                 (centroid.mean - previousValue);
+    }
+    previousRank = centreRank;
+    previousValue = centroid.mean;
+    before += centroid.weight;
+  }
+  const double lastRank = static_cast<double>(count - 1);
+  if (lastRank <= previousRank) {
+    return maximum;
+  }
+  return previousValue +
+         (rank - previousRank) / (lastRank - previousRank) * (maximum - previousValue);
+}
+
+double QuantileSketch::median() const {
+  if (count == 0) {
+    return 0.0;
+  }
+  flush();
+  if (exact && count % 2 == 0) {
+    return (centroids[count / 2 - 1].mean + centroids[count / 2].mean) / 2.0;
+  }
+  return percentile(50.0);
+}
@@ -0,0 +1,431 @@
+/**
+ * @file ReductionKernels.cpp
+ * @brief Implementation of the ReductionKernels class.
+ */
+
+#include "Temperature/ReductionKernels.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ENIGMA_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace {
+const double INFINITE = std::numeric_limits<double>::infinity();
+
+/** @brief One implementation of every kernel. */
+struct KernelTable {
+  ReductionKernels::InstructionSet instructionSet;
+  double (*sum)(const double*, std::size_t);
+  double (*sumOfSquares)(const double*, std::size_t);
+  double (*minimum)(const double*, std::size_t);
+  double (*maximum)(const double*, std::size_t);
+  MinMaxSum (*minMaxSum)(const double*, std::size_t);
+};
+
+// ---------------------------------------------------------------- Scalar --
+
+double scalarSum(const double* data, const std::size_t size) {
+  double a = 0.0, b = 0.0, c = 0.0, d = 0.0;
+  std::size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    a += data[i];
+    b += data[i + 1];
+    c += data[i + 2];
+    d += data[i + 3];
+  }
+  for (; i < size; ++i) {
+    a += data[i];
+  }
+  return (a + b) + (c + d);
+}
+
+double scalarSumOfSquares(const double* data, const std::size_t size) {
+  double a = 0.0, b = 0.0, c = 0.0, d = 0.0;
+  std::size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    a += data[i] * data[i];
+    b += data[i + 1] * data[i + 1];
+    c += data[i + 2] * data[i + 2];
+    d += data[i + 3] * data[i + 3];
+  }
+  for (; i < size; ++i) {
+    a += data[i] * data[i];
+  }
+  return (a + b) + (c + d);
+}
+
+double scalarMinimum(const double* data, const std::size_t size) {
+  double a = INFINITE, b = INFINITE, c = INFINITE, d = INFINITE;
+  std::size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    a = std::min(a, data[i]);
+    b = std::min(b, data[i + 1]);
+    c = std::min(c, data[i + 2]);
+    d = std::min(d, data[i + 3]);
+  }
+  for (; i < size; ++i) {
+    a = std::min(a, data[i]);
+  }
+  return std::min(std::min(a, b), std::min(c, d));
+}
+
+double scalarMaximum(const double* data, const std::size_t size) {
+  double a = -INFINITE, b = -INFINITE, c = -INFINITE, d = -INFINITE;
+  std::size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    a = std::max(a, data[i]);
+    b = std::max(b, data[i + 1]);
+    c = std::max(c, data[i + 2]);
+    d = std::max(d, data[i + 3]);
+  }
+  for (; i < size; ++i) {
+    a = std::max(a, data[i]);
+  }
+  return std::max(std::max(a, b), std::max(c, d));
+}
+
+MinMaxSum scalarMinMaxSum(const double* data, const std::size_t size) {
+  double low0 = INFINITE, low1 = INFINITE;
+  double high0 = -INFINITE, high1 = -INFINITE;
+  double sum0 = 0.0, sum1 = 0.0;
+  std::size_t i = 0;
+  for (; i + 2 <= size; i += 2) {
+    low0 = std::min(low0, data[i]);
+    low1 = std::min(low1, data[i + 1]);
+    high0 = std::max(high0, data[i]);
+    high1 = std::max(high1, data[i + 1]);
+    sum0 += data[i];
+    sum1 += data[i + 1];
+  }
+  for (; i < size; ++i) {
+    low0 = std::min(low0, data[i]);
+    high0 = std::max(high0, data[i]);
+    sum0 += data[i];
+  }
+  MinMaxSum result = {std::min(low0, low1), std::max(high0, high1), sum0 + sum1};
+  return result;
+}
+
+const KernelTable SCALAR_KERNELS = {
+    ReductionKernels::InstructionSet::Scalar, scalarSum, scalarSumOfSquares,
+    scalarMinimum, scalarMaximum, scalarMinMaxSum};
+
+#if defined(ENIGMA_X86_KERNELS) && defined(__SSE2__)
+// ------------------------------------------------------------------ SSE2 --
+
+double horizontalSum(const __m128d v) {
+  return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+}
+
+double horizontalMin(const __m128d v) {
+  return _mm_cvtsd_f64(_mm_min_sd(v, _mm_unpackhi_pd(v, v)));
+}
+
+double horizontalMax(const __m128d v) {
+  return _mm_cvtsd_f64(_mm_max_sd(v, _mm_unpackhi_pd(v, v)));
+}
+
+double sse2Sum(const double* data, const std::size_t size) {
+  __m128d a = _mm_setzero_pd(), b = a, c = a, d = a;
+  std::size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    a = _mm_add_pd(a, _mm_loadu_pd(data + i));
+    b = _mm_add_pd(b, _mm_loadu_pd(data + i + 2));
+    c = _mm_add_pd(c, _mm_loadu_pd(data + i + 4));
+    d = _mm_add_pd(d, _mm_loadu_pd(data + i + 6));
+  }
+  double total = horizontalSum(_mm_add_pd(_mm_add_pd(a, b), _mm_add_pd(c, d)));
+  for (; i < size; ++i) {
+    total += data[i];
+  }
+  return total;
+}
+
+double sse2SumOfSquares(const double* data, const std::size_t size) {
+  __m128d a = _mm_setzero_pd(), b = a, c = a, d = a;
+  std::size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const __m128d x0 = _mm_loadu_pd(data + i);
+    const __m128d x1 = _mm_loadu_pd(data + i + 2);
+    const __m128d x2 = _mm_loadu_pd(data + i + 4);
+    const __m128d x3 = _mm_loadu_pd(data + i + 6);
+    a = _mm_add_pd(a, _mm_mul_pd(x0, x0));
+    b = _mm_add_pd(b, _mm_mul_pd(x1, x1));
+    c = _mm_add_pd(c, _mm_mul_pd(x2, x2));
+    d = _mm_add_pd(d, _mm_mul_pd(x3, x3));
+  }
+  double total = horizontalSum(_mm_add_pd(_mm_add_pd(a, b), _mm_add_pd(c, d)));
+  for (; i < size; ++i) {
+    total += data[i] * data[i];
+  }
+  return total;
+}
+
+double sse2Minimum(const double* data, const std::size_t size) {
+  __m128d a = _mm_set1_pd(INFINITE), b = a, c = a, d = a;
+  std::size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    a = _mm_min_pd(a, _mm_loadu_pd(data + i));
+    b = _mm_min_pd(b, _mm_loadu_pd(data + i + 2));
+    c = _mm_min_pd(c, _mm_loadu_pd(data + i + 4));
+    d = _mm_min_pd(d, _mm_loadu_pd(data + i + 6));
+  }
+  double lowest = horizontalMin(_mm_min_pd(_mm_min_pd(a, b), _mm_min_pd(c, d)));
+  for (; i < size; ++i) {
+    lowest = std::min(lowest, data[i]);
+  }
+  return lowest;
+}
+
+double sse2Maximum(const double* data, const std::size_t size) {
+  __m128d a = _mm_set1_pd(-INFINITE), b = a, c = a, d = a;
+  std::size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    a = _mm_max_pd(a, _mm_loadu_pd(data + i));
+    b = _mm_max_pd(b, _mm_loadu_pd(data + i + 2));
+    c = _mm_max_pd(c, _mm_loadu_pd(data + i + 4));
+    d = _mm_max_pd(d, _mm_loadu_pd(data + i + 6));
+  }
+  double highest = horizontalMax(_mm_max_pd(_mm_max_pd(a, b), _mm_max_pd(c, d)));
+  for (; i < size; ++i) {
+    highest = std::max(highest, data[i]);
+  }
+  return highest;
+}
+
+MinMaxSum sse2MinMaxSum(const double* data, const std::size_t size) {
+  __m128d low0 = _mm_set1_pd(INFINITE), low1 = low0;
+  __m128d high0 = _mm_set1_pd(-INFINITE), high1 = high0;
+  __m128d sum0 = _mm_setzero_pd(), sum1 = sum0;
+  std::size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const __m128d x0 = _mm_loadu_pd(data + i);
+    const __m128d x1 = _mm_loadu_pd(data + i + 2);
+    low0 = _mm_min_pd(low0, x0);
+    low1 = _mm_min_pd(low1, x1);
+    high0 = _mm_max_pd(high0, x0);
+    high1 = _mm_max_pd(high1, x1);
+    sum0 = _mm_add_pd(sum0, x0);
+    sum1 = _mm_add_pd(sum1, x1);
+  }
+  MinMaxSum result = {horizontalMin(_mm_min_pd(low0, low1)),
+                      horizontalMax(_mm_max_pd(high0, high1)),
+                      horizontalSum(_mm_add_pd(sum0, sum1))};
+  for (; i < size; ++i) {
+    result.minimum = std::min(result.minimum, data[i]);
+    result.maximum = std::max(result.maximum, data[i]);
+    result.sum += data[i];
+  }
+  return result;
+}
+
+const KernelTable SSE2_KERNELS = {
+    ReductionKernels::InstructionSet::SSE2, sse2Sum, sse2SumOfSquares,
+    sse2Minimum, sse2Maximum, sse2MinMaxSum};
+
+// ------------------------------------------------------------------ AVX2 --
+// Compiled for AVX2 regardless of the build flags and only called after a
+// CPUID check, so the library still runs on older CPUs.
+
+#define ENIGMA_AVX2 __attribute__((target("avx2")))
+
+ENIGMA_AVX2 __m128d foldSum(const __m256d v) {
+  return _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+}
+
+ENIGMA_AVX2 __m128d foldMin(const __m256d v) {
+  return _mm_min_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+}
+
+ENIGMA_AVX2 __m128d foldMax(const __m256d v) {
+  return _mm_max_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+}
+
+ENIGMA_AVX2 double avx2Sum(const double* data, const std::size_t size) {
+  __m256d a = _mm256_setzero_pd(), b = a, c = a, d = a;
+  std::size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    a = _mm256_add_pd(a, _mm256_loadu_pd(data + i));
+    b = _mm256_add_pd(b, _mm256_loadu_pd(data + i + 4));
+    c = _mm256_add_pd(c, _mm256_loadu_pd(data + i + 8));
+    d = _mm256_add_pd(d, _mm256_loadu_pd(data + i + 12));
+  }
+  double total =
+      horizontalSum(foldSum(_mm256_add_pd(_mm256_add_pd(a, b), _mm256_add_pd(c, d))));
+  for (; i < size; ++i) {
+    total += data[i];
+  }
+  return total;
+}
+
+ENIGMA_AVX2 double avx2SumOfSquares(const double* data, const std::size_t size) {
+  __m256d a = _mm256_setzero_pd(), b = a, c = a, d = a;
+  std::size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m256d x0 = _mm256_loadu_pd(data + i);
+    const __m256d x1 = _mm256_loadu_pd(data + i + 4);
+    const __m256d x2 = _mm256_loadu_pd(data + i + 8);
+    const __m256d x3 = _mm256_loadu_pd(data + i + 12);
+    a = _mm256_add_pd(a, _mm256_mul_pd(x0, x0));
+    b = _mm256_add_pd(b, _mm256_mul_pd(x1, x1));
+    c = _mm256_add_pd(c, _mm256_mul_pd(x2, x2));
+    d = _mm256_add_pd(d, _mm256_mul_pd(x3, x3));
+  }
+  double total =
+      horizontalSum(foldSum(_mm256_add_pd(_mm256_add_pd(a, b), _mm256_add_pd(c, d))));
+  for (; i < size; ++i) {
+    total += data[i] * data[i];
+  }
+  return total;
+}
+
+ENIGMA_AVX2 double avx2Minimum(const double* data, const std::size_t size) {
+  __m256d a = _mm256_set1_pd(INFINITE), b = a, c = a, d = a;
+  std::size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    a = _mm256_min_pd(a, _mm256_loadu_pd(data + i));
+    b = _mm256_min_pd(b, _mm256_loadu_pd(data + i + 4));
+    c = _mm256_min_pd(c, _mm256_loadu_pd(data + i + 8));
+    d = _mm256_min_pd(d, _mm256_loadu_pd(data + i + 12));
+  }
+  double lowest =
+      horizontalMin(foldMin(_mm256_min_pd(_mm256_min_pd(a, b), _mm256_min_pd(c, d))));
+  for (; i < size; ++i) {
+    lowest = std::min(lowest, data[i]);
+  }
+  return lowest;
+}
+
+ENIGMA_AVX2 double avx2Maximum(const double* data, const std::size_t size) {
+  __m256d a = _mm256_set1_pd(-INFINITE), b = a, c = a, d = a;
+  std::size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    a = _mm256_max_pd(a, _mm256_loadu_pd(data + i));
+    b = _mm256_max_pd(b, _mm256_loadu_pd(data + i + 4));
+    c = _mm256_max_pd(c, _mm256_loadu_pd(data + i + 8));
+    d = _mm256_max_pd(d, _mm256_loadu_pd(data + i + 12));
+  }
+  double highest =
+      horizontalMax(foldMax(_mm256_max_pd(_mm256_max_pd(a, b), _mm256_max_pd(c, d))));
+  for (; i < size; ++i) {
+    highest = std::max(highest, data[i]);
+  }
+  return highest;
+}
+
+ENIGMA_AVX2 MinMaxSum avx2MinMaxSum(const double* data, const std::size_t size) {
+  __m256d low0 = _mm256_set1_pd(INFINITE), low1 = low0;
+  __m256d high0 = _mm256_set1_pd(-INFINITE), high1 = high0;
+  __m256d sum0 = _mm256_setzero_pd(), sum1 = sum0;
+  std::size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const __m256d x0 = _mm256_loadu_pd(data + i);
+    const __m256d x1 = _mm256_loadu_pd(data + i + 4);
+    low0 = _mm256_min_pd(low0, x0);
+    low1 = _mm256_min_pd(low1, x1);
+    high0 = _mm256_max_pd(high0, x0);
+    high1 = _mm256_max_pd(high1, x1);
+    sum0 = _mm256_add_pd(sum0, x0);
+    sum1 = _mm256_add_pd(sum1, x1);
+  }
+  MinMaxSum result = {
+      horizontalMin(foldMin(_mm256_min_pd(low0, low1))),
+      horizontalMax(foldMax(_mm256_max_pd(high0, high1))),
+      horizontalSum(foldSum(_mm256_add_pd(sum0, sum1)))};
+  for (; i < size; ++i) {
+    result.minimum = std::min(result.minimum, data[i]);
+    result.maximum = std::max(result.maximum, data[i]);
+    result.sum += data[i];
+  }
+  return result;
+}
+
+const KernelTable AVX2_KERNELS = {
+    ReductionKernels::InstructionSet::AVX2, avx2Sum, avx2SumOfSquares,
+    avx2Minimum, avx2Maximum, avx2MinMaxSum};
+#endif
+
+const KernelTable* kernelsFor(const ReductionKernels::InstructionSet instructionSet) {
+  switch (instructionSet) {
+#if defined(ENIGMA_X86_KERNELS) && defined(__SSE2__)
+    case ReductionKernels::InstructionSet::AVX2:
+      return &AVX2_KERNELS;
+    case ReductionKernels::InstructionSet::SSE2:
+      return &SSE2_KERNELS;
+#endif
+    default:
+      return &SCALAR_KERNELS;
+  }
+}
+
+const KernelTable* detectBestKernels() {
+  if (ReductionKernels::isSupported(ReductionKernels::InstructionSet::AVX2)) {
+    return kernelsFor(ReductionKernels::InstructionSet::AVX2);
+  }
+  if (ReductionKernels::isSupported(ReductionKernels::InstructionSet::SSE2)) {
+    return kernelsFor(ReductionKernels::InstructionSet::SSE2);
+  }
+  return &SCALAR_KERNELS;
+}
+
+std::atomic<const KernelTable*>& activeKernels() {
+  static std::atomic<const KernelTable*> kernels(detectBestKernels());
+  return kernels;
+}
+
+const KernelTable& kernels() {
+  return *activeKernels().load(std::memory_order_relaxed);
+}
+}  // namespace
+
+double ReductionKernels::sum(const double* data, const std::size_t size) {
+  return kernels().sum(data, size);
+}
+
+double ReductionKernels::sumOfSquares(const double* data, const std::size_t size) {
+  return kernels().sumOfSquares(data, size);
+}
+
+double ReductionKernels::minimum(const double* data, const std::size_t size) {
+  return kernels().minimum(data, size);
+}
+
+double ReductionKernels::maximum(const double* data, const std::size_t size) {
+  return kernels().maximum(data, size);
+}
+
+MinMaxSum ReductionKernels::minMaxSum(const double* data, const std::size_t size) {
+  return kernels().minMaxSum(data, size);
+}
+
+ReductionKernels::InstructionSet ReductionKernels::getInstructionSet() {
+  return kernels().instructionSet;
+}
+
+bool ReductionKernels::isSupported(const InstructionSet instructionSet) {
+  switch (instructionSet) {
+    case InstructionSet::Scalar:
+      return true;
+#if defined(ENIGMA_X86_KERNELS) && defined(__SSE2__)
+    case InstructionSet::SSE2:
+      return true;
+    case InstructionSet::AVX2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2");
+#endif
+    default:
+      return false;
+  }
+}
+
+void ReductionKernels::setInstructionSet(const InstructionSet instructionSet) {
+  if (!isSupported(instructionSet)) {
+    throw std::invalid_argument("Instruction set not supported by this CPU");
+  }
+  activeKernels().store(kernelsFor(instructionSet), std::memory_order_relaxed);
+}
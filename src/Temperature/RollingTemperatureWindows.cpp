@@ -0,0 +1,142 @@
+/**
+ * @file RollingTemperatureWindows.cpp
+ * @brief Implementation of the RollingTemperatureWindows class.
+ */
+
+#include "Temperature/RollingTemperatureWindows.h"
+#include <algorithm>
+#include <stdexcept>
+
+void RollingTemperatureWindows::MonotonicDeque::reset(const std::size_t capacity) {
+  positions.assign(capacity, 0);
+  values.assign(capacity, 0.0);
+  head = 0;
+  length = 0;
+}
+
+template <typename Compare>
+void RollingTemperatureWindows::MonotonicDeque::push(const std::uint64_t position,
+                                                     const double value,
+                                                     Compare keepBefore) {
+  const std::size_t capacity = values.size();
+  while (length > 0 && !keepBefore(values[(head + length - 1) % capacity], value)) {
+    --length;
+  }
+  const std::size_t slot = (head + length) % capacity;
+  positions[slot] = position;
+  values[slot] = value;
+  ++length;
+}
+
+void RollingTemperatureWindows::MonotonicDeque::expire(
+    const std::uint64_t oldestPosition) {
+  if (length > 0 && positions[head] < oldestPosition) {
+    head = (head + 1) % values.size();
+    --length;
+  }
+}
+
+double RollingTemperatureWindows::MonotonicDeque::front() const {
+  return values[head];
+}
+
+namespace {
+bool strictlyLess(const double kept, const double incoming) {
+  return kept < incoming;
+}
+
+bool strictlyGreater(const double kept, const double incoming) {
+  return kept > incoming;
+}
+}  // namespace
+
+RollingTemperatureWindows::RollingTemperatureWindows(
+    const std::vector<std::size_t>& windowSizes,
+    const std::vector<double>& ewmaAlphas)
+    : total(0), ewmaAlphas(ewmaAlphas), ewmaValues(ewmaAlphas.size(), 0.0) {
+  std::size_t largest = 1;
+  windows.resize(windowSizes.size());
+  for (std::size_t i = 0; i < windowSizes.size(); ++i) {
+    if (windowSizes[i] == 0) {
+      throw std::invalid_argument("Window size must be at least 1");
+    }
+    windows[i].size = windowSizes[i];
+    windows[i].sum = 0.0;
+    windows[i].minimum.reset(windowSizes[i]);
+    windows[i].maximum.reset(windowSizes[i]);
+    largest = std::max(largest, windowSizes[i]);
+  }
+  for (const double alpha : ewmaAlphas) {
+    if (!(alpha > 0.0 && alpha <= 1.0)) {
+      throw std::invalid_argument("EWMA alpha must be in (0, 1]");
+    }
+  }
+  history.assign(largest, 0.0);
+}
+
+void RollingTemperatureWindows::addTemperature(const double temperature) {
+  const std::uint64_t position = total;
+  const std::size_t capacity = history.size();
+
+  for (auto& window : windows) {
+    window.sum += temperature;
+    if (position >= window.size) {
+      // Read the departing value before the ring slot can be overwritten.
+      window.sum -= history[(position - window.size) % capacity];
+    }
+    const std::uint64_t oldest =
+        position + 1 >= window.size ? position + 1 - window.size : 0;
+    window.minimum.expire(oldest);
+    window.maximum.expire(oldest);
+    window.minimum.push(position, temperature, strictlyLess);
+    window.maximum.push(position, temperature, strictlyGreater);
+  }
+  history[position % capacity] = temperature;
+  ++total;
+
+  // Re-add each full window from scratch once per window length so that
+  // rounding error from the running add/subtract never accumulates.
+  for (auto& window : windows) {
+    if (total % window.size == 0) {
+      double exact = 0.0;
+      for (std::uint64_t p = total - window.size; p < total; ++p) {
+        exact += history[p % capacity];
+      }
+      window.sum = exact;
+    }
+  }
+
+  for (std::size_t i = 0; i < ewmaAlphas.size(); ++i) {
+    ewmaValues[i] = (position == 0)
+                        ? temperature
+                        : ewmaValues[i] + ewmaAlphas[i] * (temperature - ewmaValues[i]);
+  }
+}
+
+WindowStatistics RollingTemperatureWindows::getWindow(
+    const std::size_t windowIndex) const {
+  const Window& window = windows.at(windowIndex);
+  WindowStatistics statistics;
+  statistics.windowSize = window.size;
+  statistics.count = static_cast<std::size_t>(
+      std::min<std::uint64_t>(total, window.size));
+  if (statistics.count > 0) {
+    statistics.minimum = window.minimum.front();
+    statistics.maximum = window.maximum.front();
+    statistics.sum = window.sum;
+    statistics.mean = window.sum / statistics.count;
+  }
+  return statistics;
+}
+
+double RollingTemperatureWindows::getEwma(const std::size_t ewmaIndex) const {
+  return ewmaValues.at(ewmaIndex);
+}
+
+std::size_t RollingTemperatureWindows::getWindowCount() const {
+  return windows.size();
+}
+
+void RollingTemperatureWindows::onSOLFinalized(const SOLData& solData) {
+  addTemperature(solData.getTemperatureData());
+}
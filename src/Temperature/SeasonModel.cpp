@@ -0,0 +1,158 @@
+/**
+ * @file SeasonModel.cpp
+ * @brief Implementation of the SeasonModel and SeasonalStatistics classes.
+ */
+
+#include "Temperature/SeasonModel.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+const double PI = 3.14159265358979323846;
+const double TWO_PI = 2.0 * PI;
+const double DEGREES_TO_RADIANS = PI / 180.0;
+/** @brief Eccentricity of Mars' orbit. */
+const double ECCENTRICITY = 0.0934;
+/** @brief Ls of perihelion, in degrees. */
+const double PERIHELION_LS = 251.0;
+
+double wrapPhase(const double angle) {
+  const double wrapped = std::fmod(angle, TWO_PI);
+  return wrapped < 0.0 ? wrapped + TWO_PI : wrapped;
+}
+
+double meanAnomalyFromLs(const double solarLongitude) {
+  const double trueAnomaly = (solarLongitude - PERIHELION_LS) * DEGREES_TO_RADIANS;
+  const double eccentricAnomaly =
+      2.0 * std::atan2(std::sqrt(1.0 - ECCENTRICITY) * std::sin(trueAnomaly / 2.0),
+                       std::sqrt(1.0 + ECCENTRICITY) * std::cos(trueAnomaly / 2.0));
+  return eccentricAnomaly - ECCENTRICITY * std::sin(eccentricAnomaly);
+}
+
+double lsFromMeanAnomaly(const double meanAnomaly) {
+  // Newton's method on Kepler's equation; converges in a few steps for e < 0.1.
+  double eccentricAnomaly = meanAnomaly + ECCENTRICITY * std::sin(meanAnomaly);
+  for (int iteration = 0; iteration < 5; ++iteration) {
+    eccentricAnomaly -=
+        (eccentricAnomaly - ECCENTRICITY * std::sin(eccentricAnomaly) - meanAnomaly) /
+        (1.0 - ECCENTRICITY * std::cos(eccentricAnomaly));
+  }
+  const double trueAnomaly =
+      2.0 * std::atan2(std::sqrt(1.0 + ECCENTRICITY) * std::sin(eccentricAnomaly / 2.0),
+                       std::sqrt(1.0 - ECCENTRICITY) * std::cos(eccentricAnomaly / 2.0));
+  const double solarLongitude =
+      std::fmod(trueAnomaly / DEGREES_TO_RADIANS + PERIHELION_LS + 720.0, 360.0);
+  return solarLongitude >= 360.0 ? 0.0 : solarLongitude;
+}
+}  // namespace
+
+SeasonModel::SeasonModel(const double yearSols, const double startSolarLongitude,
+                         const int firstSol)
+    : yearSols(yearSols),
+      firstSol(firstSol),
+      startPhase(0.0),
+      meanAnomalyAtLs0(meanAnomalyFromLs(0.0)) {
+  if (!(yearSols > 0.0)) {
+    throw std::invalid_argument("Mars year length must be positive");
+  }
+  startPhase = wrapPhase(meanAnomalyFromLs(startSolarLongitude) - meanAnomalyAtLs0);
+}
+
+double SeasonModel::phaseOf(const int solNumber) const {
+  return startPhase + TWO_PI * (solNumber - firstSol) / yearSols;
+}
+
+SeasonPosition SeasonModel::locate(const int solNumber) const {
+  const double phase = phaseOf(solNumber);
+  const double year = std::floor(phase / TWO_PI);
+  SeasonPosition position;
+  position.marsYear = static_cast<int>(year);
+  position.solarLongitude =
+      lsFromMeanAnomaly(meanAnomalyAtLs0 + (phase - year * TWO_PI));
+  position.season = static_cast<Season>(
+      std::min(3, static_cast<int>(position.solarLongitude / 90.0)));
+  return position;
+}
+
+int SeasonModel::nextSeasonStart(const int solNumber) const {
+  const SeasonPosition position = locate(solNumber);
+  const int nextSeason = static_cast<int>(position.season) + 1;
+  double targetPhase = TWO_PI * position.marsYear;
+  if (nextSeason == static_cast<int>(SEASON_COUNT)) {
+    targetPhase += TWO_PI;
+  } else {
+    targetPhase += wrapPhase(meanAnomalyFromLs(90.0 * nextSeason) - meanAnomalyAtLs0);
+  }
+  const double days = (targetPhase - startPhase) * yearSols / TWO_PI;
+  int candidate = std::max(solNumber + 1, firstSol + static_cast<int>(std::ceil(days)));
+
+  // Settle rounding at the boundary against locate() itself.
+  const auto sameSeason = [&](const int sol) {
+    const SeasonPosition other = locate(sol);
+    return other.marsYear == position.marsYear && other.season == position.season;
+  };
+  while (candidate - 1 > solNumber && !sameSeason(candidate - 1)) {
+    --candidate;
+  }
+  while (sameSeason(candidate)) {
+    ++candidate;
+  }
+  return candidate;
+}
+
+int SeasonModel::getFirstSol() const {
+  return firstSol;
+}
+
+void SeasonAggregate::add(const double temperature) {
+  if (count == 0) {
+    minimum = maximum = temperature;
+  } else {
+    minimum = std::min(minimum, temperature);
+    maximum = std::max(maximum, temperature);
+  }
+  sum += temperature;
+  ++count;
+}
+
+double SeasonAggregate::mean() const {
+  return count == 0 ? 0.0 : sum / count;
+}
+
+SeasonalStatistics::SeasonalStatistics(const SeasonModel& model)
+    : model(model) {}
+
+void SeasonalStatistics::addTemperature(const int solNumber,
+                                        const double temperature) {
+  const SeasonPosition position = model.locate(solNumber);
+  if (position.marsYear < 0) {
+    throw std::out_of_range("SOL precedes the start of the season model");
+  }
+  const std::size_t season = static_cast<std::size_t>(position.season);
+  if (static_cast<std::size_t>(position.marsYear) >= years.size()) {
+    years.resize(position.marsYear + 1);
+  }
+  years[position.marsYear][season].add(temperature);
+  totals[season].add(temperature);
+}
+
+SeasonAggregate SeasonalStatistics::getAggregate(const int marsYear,
+                                                 const Season season) const {
+  if (marsYear < 0 || static_cast<std::size_t>(marsYear) >= years.size()) {
+    return SeasonAggregate();
+  }
+  return years[marsYear][static_cast<std::size_t>(season)];
+}
+
+const SeasonAggregate& SeasonalStatistics::getAggregate(const Season season) const {
+  return totals[static_cast<std::size_t>(season)];
+}
+
+int SeasonalStatistics::getYearCount() const {
+  return static_cast<int>(years.size());
+}
+
+void SeasonalStatistics::onSOLFinalized(const SOLData& solData) {
+  addTemperature(solData.getSolNumber(), solData.getTemperatureData());
+}
@@ -0,0 +1,153 @@
+/**
+ * @file SeasonalityAnalyzer.cpp
+ * @brief Implementation of the SeasonalityAnalyzer class.
+ */
+
+#include "Temperature/SeasonalityAnalyzer.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+const double PI = 3.14159265358979323846;
+
+/**
+ * @brief Keeps the log of an empty bin finite during peak refinement.
+ */
+const double POWER_FLOOR = 1e-300;
+
+double powerAt(const std::vector<std::complex<double>>& spectrum,
+               const std::size_t bin) {
+  return std::norm(spectrum[bin]);
+}
+
+Season seasonAfterSummer(const long quarters) {
+  const long seasons = static_cast<long>(SEASON_COUNT);
+  const long index = static_cast<long>(Season::Summer) + quarters % seasons;
+  return static_cast<Season>((index + seasons) % seasons);
+}
+}  // namespace
+
+SeasonalityAnalyzer::SeasonalityAnalyzer(const std::size_t peakCount,
+                                         const double minimumPeriod)
+    : peakCount(peakCount), minimumPeriod(minimumPeriod) {
+  if (peakCount == 0) {
+    throw std::invalid_argument("At least one spectral peak must be requested");
+  }
+  if (!(minimumPeriod >= 2.0)) {
+    throw std::invalid_argument("Minimum period must be at least 2 SOLs");
+  }
+}
+
+SeasonalityResult SeasonalityAnalyzer::analyze(
+    const std::vector<double>& temperatures, const int firstSol) {
+  SeasonalityResult result;
+  const std::size_t n = temperatures.size();
+  if (n < 4) {
+    return result;
+  }
+
+  // Remove the mean and linear trend so they do not leak into low bins.
+  const double middle = (n - 1) / 2.0;
+  double mean = 0.0;
+  for (const double temperature : temperatures) {
+    mean += temperature;
+  }
+  mean /= n;
+  double covariance = 0.0;
+  double spreadOfTime = 0.0;
+  for (std::size_t i = 0; i < n; ++i) {
+    covariance += (i - middle) * (temperatures[i] - mean);
+    spreadOfTime += (i - middle) * (i - middle);
+  }
+  const double slope = covariance / spreadOfTime;
+  detrended.resize(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    detrended[i] = temperatures[i] - mean - slope * (i - middle);
+  }
+
+  if (window.size() != n) {
+    window.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      window[i] = 0.5 - 0.5 * std::cos(2.0 * PI * i / (n - 1));
+    }
+  }
+  windowed.resize(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    windowed[i] = detrended[i] * window[i];
+  }
+  transform.forwardReal(windowed, spectrum);
+
+  const std::size_t nyquist = n / 2;
+  const std::size_t lastBin = std::min(
+      nyquist, static_cast<std::size_t>(std::floor(n / minimumPeriod)));
+  candidates.clear();
+  for (std::size_t k = 1; k <= lastBin; ++k) {
+    const double power = powerAt(spectrum, k);
+    const bool risesFromLeft = power > powerAt(spectrum, k - 1);
+    const bool fallsToRight = k == nyquist || power >= powerAt(spectrum, k + 1);
+    if (risesFromLeft && fallsToRight) {
+      candidates.push_back(k);
+    }
+  }
+  const std::size_t kept = std::min(peakCount, candidates.size());
+  std::partial_sort(candidates.begin(), candidates.begin() + kept, candidates.end(),
+                    [this](const std::size_t a, const std::size_t b) {
+                      return powerAt(spectrum, a) > powerAt(spectrum, b);
+                    });
+  for (std::size_t c = 0; c < kept; ++c) {
+    const std::size_t k = candidates[c];
+    double offset = 0.0;
+    if (k < nyquist) {
+      const double left = std::log(powerAt(spectrum, k - 1) + POWER_FLOOR);
+      const double centre = std::log(powerAt(spectrum, k) + POWER_FLOOR);
+      const double right = std::log(powerAt(spectrum, k + 1) + POWER_FLOOR);
+      const double curvature = left - 2.0 * centre + right;
+      if (curvature < 0.0) {
+        offset = 0.5 * (left - right) / curvature;
+      }
+    }
+    const SpectralPeak peak = {n / (k + offset), powerAt(spectrum, k)};
+    result.peaks.push_back(peak);
+  }
+  if (result.peaks.empty()) {
+    return result;
+  }
+
+  // Project onto a sinusoid at the dominant period to find the warmest point.
+  const double period = result.peaks.front().period;
+  const double omega = 2.0 * PI / period;
+  const std::complex<double> step = std::polar(1.0, omega);
+  std::complex<double> rotation(1.0, 0.0);
+  std::complex<double> projection;
+  for (std::size_t i = 0; i < n; ++i) {
+    projection += detrended[i] * rotation;
+    rotation *= step;
+  }
+  double warmestIndex = std::arg(projection) / omega;
+  if (warmestIndex < 0.0) {
+    warmestIndex += period;
+  }
+  result.dominantPeriod = period;
+  result.amplitude = 2.0 * std::abs(projection) / n;
+  result.warmestSol = firstSol + warmestIndex;
+
+  // Seasons are quarter periods, with summer centred on the warmest point.
+  const double quarter = period / SEASON_COUNT;
+  const double summerStart = warmestIndex - quarter / 2.0;
+  long boundary = static_cast<long>(std::floor(-summerStart / quarter));
+  const SeasonBoundary first = {firstSol, seasonAfterSummer(boundary)};
+  result.seasons.push_back(first);
+  for (++boundary;; ++boundary) {
+    const double start = std::ceil(summerStart + boundary * quarter);
+    if (start >= n) {
+      break;
+    }
+    if (start > 0.0) {
+      const SeasonBoundary next = {firstSol + static_cast<int>(start),
+                                   seasonAfterSummer(boundary)};
+      result.seasons.push_back(next);
+    }
+  }
+  return result;
+}
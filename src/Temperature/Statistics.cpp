@@ -4,70 +4,121 @@
  */
 
 #include <algorithm>
+#include <limits>
 #include <numeric>
+#include <utility>
+#include <stdexcept>
 #include "Subsystems/Temperature.h"
+#include "Temperature/ReductionKernels.h"
+#include "Temperature/SeasonModel.h"
+
+namespace {
+/**
+ * @brief Inputs at least this long are reduced with the SIMD kernels; shorter
+ * ones are not worth the dispatch.
+ */
+const std::size_t VECTORIZED_REDUCTION_THRESHOLD = 1024;
+
+/**
+ * @brief Finds the lowest reading of a season, reducing each contiguous run
+ * of that season's SOLs in place.
+ */
+double lowestSeasonalTemperature(const std::vector<double>& data,
+                                 const Season season) {
+  const SeasonModel model;
+  const int firstSol = model.getFirstSol();
+  const int endSol = firstSol + static_cast<int>(data.size());
+  double lowest = std::numeric_limits<double>::infinity();
+  for (int sol = firstSol; sol < endSol;) {
+    const int nextSeason = model.nextSeasonStart(sol);
+    if (model.locate(sol).season == season) {
+      const auto begin = data.begin() + (sol - firstSol);
+      const auto end = data.begin() + (std::min(nextSeason, endSol) - firstSol);
+      lowest = std::min(lowest, ReductionKernels::minimum(&*begin, end - begin));
+    }
+    sol = nextSeason;
+  }
+  return lowest;
+}
+
+/**
+ * @brief Selects the values of rank lowerRank and lowerRank + 1 of data,
+ * reordering it; the second is the first again at the last rank.
+ */
+std::pair<double, double> selectAdjacentRanks(std::vector<double>& data,
+                                              const std::size_t lowerRank) {
+  const auto lower = data.begin() + lowerRank;
+  std::nth_element(data.begin(), lower, data.end());
+  if (lowerRank + 1 >= data.size()) {
+    return std::make_pair(*lower, *lower);
+  }
+  // Everything right of the lower rank is no smaller than it.
+  return std::make_pair(*lower, *std::min_element(lower + 1, data.end()));
+}
+}  // namespace
 
 double Statistics::calculateMean(const std::vector<double>& data) {
   if (data.empty())
     return 0.0;
+  if (data.size() >= VECTORIZED_REDUCTION_THRESHOLD)
+    return ReductionKernels::sum(data.data(), data.size()) / data.size();
   return std::accumulate(data.begin(), data.end(), 0.0) / data.size();
 }
 
+MomentAccumulator Statistics::calculateMoments(const std::vector<double>& data) {
+  MomentAccumulator moments;
+  for (const double value : data) {
+    moments.add(value);
+  }
+  return moments;
+}
+
+QuantileSketch Statistics::buildQuantileSketch(const std::vector<double>& data,
+                                               const double compression) {
+  QuantileSketch sketch(compression);
+  for (const double value : data) {
+    sketch.insert(value);
+  }
+  return sketch;
+}
+
 double Statistics::calculateMedian(const std::vector<double>& data) {
   if (data.empty())
     return 0.0;
 
-  std::vector<double> sortedData = data;
-  std::sort(sortedData.begin(), sortedData.end());
+  // The median is the 50th percentile; averaging the middle pair directly
+  // keeps an even-sized median exactly symmetric.
+  std::vector<double> workingData = data;
+  const size_t size = workingData.size();
+  const std::pair<double, double> middle =
+      selectAdjacentRanks(workingData, (size - 1) / 2);
+  return size % 2 == 0 ? (middle.first + middle.second) / 2.0 : middle.first;
+}
 
-  size_t size = sortedData.size();
-  if (size % 2 == 0) {
-    return (sortedData[size / 2 - 1] + sortedData[size / 2]) / 2.0;
-  } else {
-    return sortedData[size / 2];
+double Statistics::calculatePercentile(const std::vector<double>& data,
+                                       const double percentile) {
+  if (percentile < 0.0 || percentile > 100.0) {
+    throw std::invalid_argument("Percentile must be in [0, 100]");
   }
+  if (data.empty())
+    return 0.0;
+
+  std::vector<double> workingData = data;
+  const double rank = percentile / 100.0 * (workingData.size() - 1);
+  const size_t lowerRank = static_cast<size_t>(rank);
+  const std::pair<double, double> neighbours =
+      selectAdjacentRanks(workingData, lowerRank);
+  return neighbours.first + (rank - lowerRank) * (neighbours.second - neighbours.first);
 }
 
 double Statistics::calculateLowestSummerTemperature(
     const std::vector<double>& data) {
-  std::vector<double> summer1Temperatures;
-  std::vector<double> summer2Temperatures;
-
-  for (size_t i = 0; i < data.size(); ++i) {
-    if (i >= 195 && i <= 372) {
-      summer1Temperatures.push_back(data[i]);
-    } else if (i >= 865 && i <= 1042) {
-      summer2Temperatures.push_back(data[i]);
-    }
-  }
-
-  const double lowestSummer1 =
-      *std::min_element(summer1Temperatures.begin(), summer1Temperatures.end());
-  const double lowestSummer2 =
-      *std::min_element(summer2Temperatures.begin(), summer2Temperatures.end());
-
-  return std::min(lowestSummer1, lowestSummer2);
+  return lowestSeasonalTemperature(data, Season::Summer);
 }
 
 double Statistics::calculateLowestWinterTemperature(
     const std::vector<double>& data) {
-  std::vector<double> winter1Temperatures;
-  std::vector<double> winter2Temperatures;
-
-  for (size_t i = 0; i < data.size(); ++i) {
-    if (i >= 515 && i <= 669) {
-      winter1Temperatures.push_back(data[i]);
-    } else if (i >= 1185 && i <= 1374) {
-      winter2Temperatures.push_back(data[i]);
-    }
-  }
-
-  const double lowestWinter1 =
-      *std::min_element(winter1Temperatures.begin(), winter1Temperatures.end());
-  const double lowestWinter2 =
-      *std::min_element(winter2Temperatures.begin(), winter2Temperatures.end());
-
-  return std::min(lowestWinter1, lowestWinter2);
+  return lowestSeasonalTemperature(data, Season::Winter);
 }
 
 std::vector<double> Statistics::findLargestN(const std::vector<double>& data,
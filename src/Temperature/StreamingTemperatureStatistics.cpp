@@ -0,0 +1,84 @@
+/**
+ * @file StreamingTemperatureStatistics.cpp
+ * @brief Implementation of the StreamingTemperatureStatistics class.
+ */
+
+#include "Temperature/StreamingTemperatureStatistics.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+StreamingTemperatureStatistics::StreamingTemperatureStatistics(
+    const std::size_t extremeCount, const SeasonModel& seasonModel,
+    const double sketchCompression)
+    : extremeCount(extremeCount),
+      quantileSketch(sketchCompression),
+      seasonalStatistics(seasonModel) {
+  highestHeap.reserve(extremeCount + 1);
+  lowestHeap.reserve(extremeCount + 1);
+}
+
+void StreamingTemperatureStatistics::addTemperature(const int solNumber,
+                                                    const double temperature) {
+  moments.add(temperature);
+  seasonalStatistics.addTemperature(solNumber, temperature);
+
+  if (extremeCount > 0) {
+    if (highestHeap.size() < extremeCount) {
+      highestHeap.push_back(temperature);
+      std::push_heap(highestHeap.begin(), highestHeap.end(), std::greater<double>());
+    } else if (temperature > highestHeap.front()) {
+      std::pop_heap(highestHeap.begin(), highestHeap.end(), std::greater<double>());
+      highestHeap.back() = temperature;
+      std::push_heap(highestHeap.begin(), highestHeap.end(), std::greater<double>());
+    }
+    if (lowestHeap.size() < extremeCount) {
+      lowestHeap.push_back(temperature);
+      std::push_heap(lowestHeap.begin(), lowestHeap.end());
+    } else if (temperature < lowestHeap.front()) {
+      std::pop_heap(lowestHeap.begin(), lowestHeap.end());
+      lowestHeap.back() = temperature;
+      std::push_heap(lowestHeap.begin(), lowestHeap.end());
+    }
+  }
+
+  quantileSketch.insert(temperature);
+}
+
+TemperatureSnapshot StreamingTemperatureStatistics::getSnapshot() const {
+  TemperatureSnapshot snapshot;
+  snapshot.count = moments.count;
+  snapshot.mean = moments.mean;
+  snapshot.variance = moments.variance();
+  snapshot.minimum = moments.minimum;
+  snapshot.maximum = moments.maximum;
+  snapshot.median = quantileSketch.median();
+  const SeasonAggregate& summer = seasonalStatistics.getAggregate(Season::Summer);
+  const SeasonAggregate& winter = seasonalStatistics.getAggregate(Season::Winter);
+  snapshot.lowestSummer =
+      summer.count > 0 ? summer.minimum : std::numeric_limits<double>::infinity();
+  snapshot.lowestWinter =
+      winter.count > 0 ? winter.minimum : std::numeric_limits<double>::infinity();
+  snapshot.highest = highestHeap;
+  std::sort(snapshot.highest.begin(), snapshot.highest.end(), std::greater<double>());
+  snapshot.lowest = lowestHeap;
+  std::sort(snapshot.lowest.begin(), snapshot.lowest.end());
+  return snapshot;
+}
+
+void StreamingTemperatureStatistics::onSOLFinalized(const SOLData& solData) {
+  addTemperature(solData.getSolNumber(), solData.getTemperatureData());
+}
+
+const SeasonalStatistics& StreamingTemperatureStatistics::getSeasonalStatistics()
+    const {
+  return seasonalStatistics;
+}
+
+const MomentAccumulator& StreamingTemperatureStatistics::getMoments() const {
+  return moments;
+}
+
+const QuantileSketch& StreamingTemperatureStatistics::getQuantileSketch() const {
+  return quantileSketch;
+}
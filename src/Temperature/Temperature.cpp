@@ -6,13 +6,21 @@
 #include "Subsystems/Temperature.h"
 
 void Temperature::addTemperature(const Measurement& temperature) {
-  SOLTemperature = temperature.toBaseUnit();
+  SOLTemperature.add(temperature.toBaseUnit());
 }
 
 double Temperature::getTemperatureData() const {
+  return SOLTemperature.last;
+}
+
+const TemperatureAggregate& Temperature::getTemperatureAggregate() const {
   return SOLTemperature;
 }
 
 void Temperature::reset() {
-  SOLTemperature = 0;
+  SOLTemperature = TemperatureAggregate();
+}
+
+void Temperature::restoreTemperatureAggregate(const TemperatureAggregate& aggregate) {
+  SOLTemperature = aggregate;
 }
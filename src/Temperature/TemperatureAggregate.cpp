@@ -0,0 +1,24 @@
+/**
+ * @file TemperatureAggregate.cpp
+ * @brief Implementation of the TemperatureAggregate struct.
+ */
+
+#include "Temperature/TemperatureAggregate.h"
+#include <algorithm>
+
+void TemperatureAggregate::add(const double temperature) {
+  if (count == 0) {
+    minimum = temperature;
+    maximum = temperature;
+  } else {
+    minimum = std::min(minimum, temperature);
+    maximum = std::max(maximum, temperature);
+  }
+  ++count;
+  mean += (temperature - mean) / count;
+  last = temperature;
+}
+
+bool TemperatureAggregate::empty() const {
+  return count == 0;
+}
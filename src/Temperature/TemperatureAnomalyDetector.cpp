@@ -0,0 +1,257 @@
+/**
+ * @file TemperatureAnomalyDetector.cpp
+ * @brief Implementation of the TemperatureAnomalyDetector class.
+ */
+
+#include "Temperature/TemperatureAnomalyDetector.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+/**
+ * @brief Smallest spread a score is divided by, so a perfectly flat history
+ * flags any change instead of dividing by zero.
+ */
+const double MIN_SCALE = 1e-9;
+
+/**
+ * @brief Scales a MAD to the standard deviation of a normal distribution.
+ */
+const double MAD_TO_SIGMA = 0.6745;
+
+double sign(const double value) {
+  return (value > 0.0) - (value < 0.0);
+}
+
+/**
+ * @brief Moves the median of data[0, size) into place and returns it.
+ */
+double selectMedian(std::vector<double>& data, const std::size_t size) {
+  const auto begin = data.begin();
+  const auto upperMiddle = begin + size / 2;
+  std::nth_element(begin, upperMiddle, begin + size);
+  if (size % 2 == 0) {
+    return (*std::max_element(begin, upperMiddle) + *upperMiddle) / 2.0;
+  }
+  return *upperMiddle;
+}
+
+void validate(const AnomalyDetectorOptions& options) {
+  if (options.windowSize < 2) {
+    throw std::invalid_argument("Anomaly window must hold at least 2 SOLs");
+  }
+  if (options.minimumHistory < 2 || options.minimumHistory > options.windowSize) {
+    throw std::invalid_argument("Minimum history must be in [2, windowSize]");
+  }
+  if (!(options.threshold > 0.0)) {
+    throw std::invalid_argument("Anomaly threshold must be positive");
+  }
+  if (!(options.ewmaAlpha > 0.0 && options.ewmaAlpha <= 1.0)) {
+    throw std::invalid_argument("EWMA alpha must be in (0, 1]");
+  }
+  if (!(options.madLearningRate > 0.0)) {
+    throw std::invalid_argument("MAD learning rate must be positive");
+  }
+}
+}  // namespace
+
+TemperatureAnomalyDetector::TemperatureAnomalyDetector(
+    const AnomalyDetectorOptions& options)
+    : options(options), droppedAnomalies(0), count(0), center(0.0), spread(0.0) {
+  validate(options);
+  if (options.method == AnomalyMethod::RollingZScore) {
+    history.assign(options.windowSize, 0.0);
+  } else if (options.method == AnomalyMethod::RobustMad) {
+    scratch.assign(options.minimumHistory, 0.0);
+  }
+}
+
+double TemperatureAnomalyDetector::score(const double temperature) const {
+  const double deviation = std::abs(temperature - center);
+  switch (options.method) {
+    case AnomalyMethod::RollingZScore: {
+      const double variance =
+          spread / static_cast<double>(std::min(count, options.windowSize));
+      return deviation / std::max(std::sqrt(variance), MIN_SCALE);
+    }
+    case AnomalyMethod::EwmaControl:
+      return deviation / std::max(std::sqrt(spread), MIN_SCALE);
+    case AnomalyMethod::RobustMad:
+      return MAD_TO_SIGMA * deviation / std::max(spread, MIN_SCALE);
+  }
+  return 0.0;
+}
+
+void TemperatureAnomalyDetector::update(const double temperature) {
+  switch (options.method) {
+    case AnomalyMethod::RollingZScore: {
+      const std::size_t window = options.windowSize;
+      const std::size_t slot = count % window;
+      if (count < window) {
+        // Welford's update while the window fills.
+        const double delta = temperature - center;
+        center += delta / (count + 1);
+        spread += delta * (temperature - center);
+      } else {
+        // Replace the departing SOL in the windowed mean and M2.
+        const double departing = history[slot];
+        const double previousCenter = center;
+        center += (temperature - departing) / window;
+        spread += (temperature - departing) *
+                  (temperature - center + departing - previousCenter);
+        spread = std::max(spread, 0.0);
+      }
+      history[slot] = temperature;
+      if ((count + 1) % window == 0) {
+        // Recompute once per window length so rounding never accumulates.
+        double exactCenter = 0.0;
+        for (const double value : history) {
+          exactCenter += value;
+        }
+        exactCenter /= window;
+        double exactSpread = 0.0;
+        for (const double value : history) {
+          exactSpread += (value - exactCenter) * (value - exactCenter);
+        }
+        center = exactCenter;
+        spread = exactSpread;
+      }
+      break;
+    }
+    case AnomalyMethod::EwmaControl: {
+      if (count == 0) {
+        center = temperature;
+        break;
+      }
+      const double delta = temperature - center;
+      const double increment = options.ewmaAlpha * delta;
+      center += increment;
+      spread = (1.0 - options.ewmaAlpha) * (spread + delta * increment);
+      break;
+    }
+    case AnomalyMethod::RobustMad: {
+      const std::size_t seedSize = options.minimumHistory;
+      if (count < seedSize) {
+        scratch[count] = temperature;
+        if (count + 1 == seedSize) {
+          center = selectMedian(scratch, seedSize);
+          for (double& value : scratch) {
+            value = std::abs(value - center);
+          }
+          spread = selectMedian(scratch, seedSize);
+        }
+        break;
+      }
+      // Stochastic approximation: nudge each estimate toward the new
+      // observation by a step proportional to the current spread.
+      const double step = options.madLearningRate * std::max(spread, MIN_SCALE);
+      const double deviation = std::abs(temperature - center);
+      center += step * sign(temperature - center);
+      spread = std::max(0.0, spread + step * sign(deviation - spread));
+      break;
+    }
+  }
+  ++count;
+}
+
+void TemperatureAnomalyDetector::report(const TemperatureAnomaly& anomaly) {
+  if (callback) {
+    callback(anomaly);
+  }
+  if (options.queueCapacity == 0) {
+    return;
+  }
+  if (queue.size() == options.queueCapacity) {
+    queue.pop_front();
+    ++droppedAnomalies;
+  }
+  queue.push_back(anomaly);
+}
+
+bool TemperatureAnomalyDetector::addTemperature(const int solNumber,
+                                                const double temperature) {
+  bool flagged = false;
+  TemperatureAnomaly anomaly = {solNumber, temperature, center, 0.0};
+  if (count >= options.minimumHistory) {
+    anomaly.score = score(temperature);
+    flagged = anomaly.score > options.threshold;
+  }
+  update(temperature);
+  if (flagged) {
+    report(anomaly);
+  }
+  return flagged;
+}
+
+void TemperatureAnomalyDetector::setCallback(const AnomalyCallback& anomalyCallback) {
+  callback = anomalyCallback;
+}
+
+bool TemperatureAnomalyDetector::pollAnomaly(TemperatureAnomaly& anomaly) {
+  if (queue.empty()) {
+    return false;
+  }
+  anomaly = queue.front();
+  queue.pop_front();
+  return true;
+}
+
+std::size_t TemperatureAnomalyDetector::getPendingCount() const {
+  return queue.size();
+}
+
+std::size_t TemperatureAnomalyDetector::getDroppedCount() const {
+  return droppedAnomalies;
+}
+
+void TemperatureAnomalyDetector::onSOLFinalized(const SOLData& solData) {
+  addTemperature(solData.getSolNumber(), solData.getTemperatureData());
+}
+
+std::vector<TemperatureAnomaly> TemperatureAnomalyDetector::evaluate(
+    const std::vector<int>& solNumbers, const std::vector<double>& temperatures,
+    const AnomalyDetectorOptions& options) {
+  if (solNumbers.size() != temperatures.size()) {
+    throw std::invalid_argument("Every temperature needs a SOL number");
+  }
+  return evaluate(solNumbers.data(), temperatures.data(), temperatures.size(), options);
+}
+
+std::vector<TemperatureAnomaly> TemperatureAnomalyDetector::evaluate(
+    const int* solNumbers, const double* temperatures, const std::size_t size,
+    const AnomalyDetectorOptions& options) {
+  validate(options);
+
+  // Replay a fresh detector so that batch results are exactly the streaming
+  // ones. Rolling windows in particular must use the same centred M2 update:
+  // sumOfSquares / n - mean^2 cancels badly at Kelvin magnitudes, and a
+  // reduced mean need not equal a constant window's value exactly.
+  std::vector<TemperatureAnomaly> anomalies;
+  AnomalyDetectorOptions replay = options;
+  replay.queueCapacity = 0;
+  TemperatureAnomalyDetector detector(replay);
+  detector.setCallback([&anomalies](const TemperatureAnomaly& anomaly) {
+    anomalies.push_back(anomaly);
+  });
+  for (std::size_t i = 0; i < size; ++i) {
+    detector.addTemperature(solNumbers[i], temperatures[i]);
+  }
+  return anomalies;
+}
+
+std::vector<TemperatureAnomaly> TemperatureAnomalyDetector::evaluate(
+    const DataStorage& storage, const AnomalyDetectorOptions& options) {
+  // Rolling windows span block boundaries, so gather the two columns first.
+  std::vector<int> solNumbers;
+  std::vector<double> temperatures;
+  solNumbers.reserve(storage.size());
+  temperatures.reserve(storage.size());
+  storage.forEachBlock([&](const SOLColumnStore& block) {
+    solNumbers.insert(solNumbers.end(), block.getSolNumbers().begin(),
+                      block.getSolNumbers().end());
+    temperatures.insert(temperatures.end(), block.getTemperatures().begin(),
+                        block.getTemperatures().end());
+  });
+  return evaluate(solNumbers, temperatures, options);
+}
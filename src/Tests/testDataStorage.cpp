@@ -1,6 +1,28 @@
 // test_data_storage.cpp
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include "Data/CompressedSOLBlock.h"
 #include "Data/DataStorage.h"
+#include "Data/SOLArchive.h"
+#include "Data/SOLIndex.h"
+#include "Data/SOLInvertedIndex.h"
+#include "Data/SOLPostings.h"
+#include "Data/SOLQuery.h"
+#include "Data/SOLSegmentLog.h"
+#include "Data/SeriesDownsampler.h"
+#include "Data/SeriesExport.h"
+#include "Temperature/ReductionKernels.h"
+#include "Utility/Checksum.h"
 
 void test_store_and_retrieve_sol_data() {
     DataStorage storage;
@@ -11,3 +33,627 @@ void test_store_and_retrieve_sol_data() {
     auto retrievedData = storage.getSOLData(1);
     assert(retrievedData.getTemperatureData() == 25.5);
 }
+
+void test_find_and_view_sol_data() {
+    DataStorage storage;
+    for (int sol = 1; sol <= 3; ++sol) {
+        SOLData solData(sol);
+        solData.storeTemperatureData(20.0 + sol);
+        storage.storeSOLData(solData);
+    }
+
+    SOLData found(0);
+    assert(storage.findSOLData(2, found));
+    assert(found.getSolNumber() == 2 && found.getTemperatureData() == 22.0);
+    assert(!storage.findSOLData(4, found));
+    assert(found.getSolNumber() == 2);
+
+    const SOLDataView view = storage.view();
+    assert(view.size() == 3 && !view.empty());
+    assert(view.front().getSolNumber() == 1 && view.back().getSolNumber() == 3);
+    int expected = 1;
+    for (const SOLData& solData : view) {
+        assert(solData.getSolNumber() == expected);
+        assert(solData.getTemperatureData() == storage.getSOLData(expected).getTemperatureData());
+        ++expected;
+    }
+    assert(expected == 4);
+    assert(view[1].getTemperatureData() == 22.0);
+    bool threw = false;
+    try {
+        view.at(3);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+void test_series_downsampling() {
+    std::vector<double> sols;
+    std::vector<double> temperatures;
+    const int spike = 4321;
+    for (int sol = 1; sol <= 20000; ++sol) {
+        sols.push_back(sol);
+        temperatures.push_back(220.0 + 30.0 * std::sin(sol / 300.0) + (sol == spike ? 80.0 : 0.0));
+    }
+    const double lowest = *std::min_element(temperatures.begin(), temperatures.end());
+    const double highest = *std::max_element(temperatures.begin(), temperatures.end());
+
+    const std::vector<DownsampledPoint> batch =
+        SeriesDownsampler::downsample(sols, temperatures, 100);
+    assert(batch.size() == 100);
+    assert(batch.front().x == 1 && batch.back().x == 20000);
+
+    IncrementalDownsampler incremental(100);
+    for (size_t i = 0; i < sols.size(); ++i) {
+        incremental.add(sols[i], temperatures[i]);
+    }
+    const std::vector<DownsampledPoint> streamed = incremental.getPoints();
+    assert(streamed.size() == 100);
+    assert(streamed.front().x == 1 && streamed.back().x == 20000);
+
+    // Both keep the spike and envelopes that cover the whole range.
+    for (const std::vector<DownsampledPoint>* points : {&batch, &streamed}) {
+        bool keptSpike = false;
+        double envelopeLow = points->front().minimum;
+        double envelopeHigh = points->front().maximum;
+        for (size_t i = 0; i < points->size(); ++i) {
+            const DownsampledPoint& point = (*points)[i];
+            keptSpike = keptSpike || point.x == spike;
+            assert(point.minimum <= point.y && point.y <= point.maximum);
+            assert(i == 0 || (*points)[i - 1].x < point.x);
+            envelopeLow = std::min(envelopeLow, point.minimum);
+            envelopeHigh = std::max(envelopeHigh, point.maximum);
+        }
+        assert(keptSpike);
+        assert(envelopeLow == lowest && envelopeHigh == highest);
+    }
+
+    SeriesExport seriesExport(10);
+    for (int sol = 1; sol <= 50; ++sol) {
+        SOLData solData(sol);
+        solData.storeTemperatureData(200.0 + sol);
+        seriesExport.onSOLFinalized(solData);
+    }
+    std::ostringstream csv;
+    seriesExport.write(csv);
+    const std::string text = csv.str();
+    assert(std::count(text.begin(), text.end(), '\n') == 1 + 2 * 10);
+    assert(text.find("temperature,50,250,") != std::string::npos);
+}
+
+void test_sol_index() {
+    DataStorage storage;
+    for (int sol = 1; sol <= 1000; ++sol) {
+        SOLData solData(sol);
+        solData.storeTemperatureData(sol);
+        assert(storage.storeSOLData(solData));
+    }
+    // A late SOL lands in order, and duplicates are rejected by default.
+    SOLData late(2000);
+    late.storeTemperatureData(2000);
+    assert(storage.storeSOLData(late));
+    SOLData early(-5);
+    early.storeTemperatureData(-5);
+    assert(storage.storeSOLData(early));
+    SOLData duplicate(500);
+    duplicate.storeTemperatureData(-1);
+    assert(!storage.storeSOLData(duplicate));
+    assert(storage.size() == 1002);
+    assert(storage.getSOLData(500).getTemperatureData() == 500);
+    SOLData missing(0);
+    assert(!storage.findSOLData(1500, missing));
+    assert(storage.view().front().getSolNumber() == -5);
+
+    const SOLDataView range = storage.getSOLRange(995, 2500);
+    assert(range.size() == 7);
+    assert(range.front().getSolNumber() == 995 && range.back().getSolNumber() == 2000);
+    assert(storage.getSOLRange(1001, 1999).empty());
+    assert(storage.getSOLRange(10, 5).empty());
+
+    DataStorage replacing(DuplicateSOLPolicy::Replace);
+    replacing.storeSOLData(late);
+    late.storeTemperatureData(1);
+    assert(replacing.storeSOLData(late));
+    assert(replacing.getSOLData(2000).getTemperatureData() == 1);
+
+    DataStorage strict(DuplicateSOLPolicy::Throw);
+    strict.storeSOLData(late);
+    bool threw = false;
+    try {
+        strict.storeSOLData(late);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Widely spaced SOLs fall back to binary search, then recover.
+    SOLIndex index;
+    index.insert(1, 0);
+    index.insert(100000, 1);
+    assert(!index.isDense());
+    assert(index.find(100000) == 1 && index.find(5) == SOLIndex::NOT_FOUND);
+    for (int sol = 100001; sol <= 200000; ++sol) {
+        index.insert(sol, index.size());
+    }
+    assert(index.isDense() && index.find(150000) == 50001);
+}
+
+void test_column_store() {
+    SOLColumnStore columns;
+    for (int sol = 1; sol <= 3; ++sol) {
+        SOLData solData(sol);
+        solData.storeTemperatureData(200.0 + sol);
+        NavigationRecord navigation;
+        navigation.finalDistance =
+            Measurement(sol * 1.5, UnitType::Distance, static_cast<int>(DistanceUnit::Meter));
+        navigation.finalDirection = Direction::Left;
+        solData.storeNavigationData(navigation);
+        SampleClassification sample;
+        sample.applyElementMatch(sol == 2 ? UNKNOWN_ELEMENT_ID : 0);
+        solData.storeSampleData(sample);
+        columns.append(solData);
+    }
+    assert(columns.size() == 3);
+    assert(columns.getSolNumbers()[2] == 3 && columns.getTemperatures()[0] == 201.0);
+    assert(columns.getDistances()[1] == 3.0);
+    assert(columns.getDirections()[0] == static_cast<std::uint8_t>(Direction::Left));
+    assert(columns.getElementIds()[0] == 0 && columns.getElementIds()[1] == UNKNOWN_ELEMENT_ID);
+
+    // Rows rebuild the original SOLData.
+    const SOLData row = columns.row(1);
+    assert(row.getSolNumber() == 2 && row.getTemperatureData() == 202.0);
+    assert(row.getNavigationData().finalDistance.getValue() == 3.0);
+    assert(row.getNavigationData().finalDirection == Direction::Left);
+    assert(row.getSampleData().getClassifiedElement() == "Unknown");
+
+    // Views taken from storage keep working as more SOLs are appended.
+    DataStorage storage;
+    storage.storeSOLData(columns.row(0));
+    const SOLDataView view = storage.view();
+    storage.storeSOLData(columns.row(2));
+    assert(view.size() == 1 && view.front().getSolNumber() == 1);
+    assert(storage.view().getTemperatures()[1] == 203.0);
+}
+
+void test_sol_archive() {
+    const char* expected = "123456789";
+    assert(Checksum::crc32c(expected, 9) == 0xE3069283u);
+    assert(Checksum::crc32c(expected + 4, 5, Checksum::crc32c(expected, 4)) == 0xE3069283u);
+
+    char directoryTemplate[] = "/tmp/sol_archive_XXXXXX";
+    const std::string directory = mkdtemp(directoryTemplate);
+    {
+        SOLArchiveWriter writer(directory, 4);
+        for (int sol = 1; sol <= 10; ++sol) {
+            SOLData solData(sol);
+            solData.storeTemperatureData(200.0 + sol);
+            writer.append(solData);
+        }
+        assert(writer.getCommittedCount() == 8 && writer.getPendingCount() == 2);
+    }
+    // Reopening appends after the rows committed on close.
+    {
+        SOLArchiveWriter writer(directory, 4);
+        assert(writer.getCommittedCount() == 10);
+        SOLData solData(11);
+        solData.storeTemperatureData(211.0);
+        writer.append(solData);
+        writer.commit();
+    }
+
+    DataStorage storage;
+    storage.loadArchive(SOLArchive::open(directory));
+    assert(storage.size() == 11 && storage.getColumns().isAttached());
+    assert(storage.getSOLData(7).getTemperatureData() == 207.0);
+    assert(storage.getSOLRange(3, 5).getTemperatures()[2] == 205.0);
+
+    // The first store copies the mapped columns and leaves the file alone.
+    SOLData late(12);
+    late.storeTemperatureData(212.0);
+    storage.storeSOLData(late);
+    assert(!storage.getColumns().isAttached() && storage.size() == 12);
+    assert(SOLArchive::open(directory)->size() == 11);
+
+    // A torn MANIFEST tail is ignored; a damaged column fails verification.
+    const std::string manifest = directory + "/MANIFEST";
+    {
+        std::ofstream torn(manifest, std::ios::binary | std::ios::app);
+        torn << "torn";
+    }
+    assert(SOLArchive::open(directory)->size() == 11);
+    {
+        std::fstream column(directory + "/temperatures.col",
+                            std::ios::binary | std::ios::in | std::ios::out);
+        column.seekp(3);
+        column.put('\x7f');
+    }
+    bool threw = false;
+    try {
+        SOLArchive::open(directory);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(SOLArchive::open(directory, false)->size() == 11);
+
+    const char* files[] = {"MANIFEST", "sol_numbers.col", "temperatures.col", "distances.col",
+                           "directions.col", "element_ids.col", "temperature_aggregates.col",
+                           "sample_readings.col"};
+    for (const char* file : files) {
+        std::remove((directory + "/" + file).c_str());
+    }
+    rmdir(directory.c_str());
+}
+
+namespace {
+SOLData makeCompressibleSOL(int sol) {
+    SOLData solData(sol);
+    solData.storeTemperatureData(210.0 + 15.0 * std::sin(sol / 50.0));
+    if (sol % 50 == 0) {
+        TemperatureAggregate aggregate;
+        aggregate.add(200.0 + sol % 13);
+        aggregate.add(230.5);
+        solData.storeTemperatureAggregate(aggregate);
+    }
+    NavigationRecord navigation;
+    navigation.finalDistance = Measurement(sol % 3 == 0 ? sol * 0.25 : 0.0, UnitType::Distance,
+                                           static_cast<int>(DistanceUnit::Meter));
+    navigation.finalDirection = static_cast<Direction>(sol % 4);
+    solData.storeNavigationData(navigation);
+    solData.storeSampleData(SampleClassification(sol % 10 == 0 ? sol % 3 : UNKNOWN_ELEMENT_ID));
+    if (sol % 10 == 0) {
+        SampleReading reading;
+        reading.wavelength = 5.0e-7 + sol * 1.0e-12;
+        reading.intensity = 0.5;
+        reading.collected = true;
+        solData.storeSampleReading(reading);
+    }
+    return solData;
+}
+
+bool sameSOL(const SOLData& left, const SOLData& right) {
+    const TemperatureAggregate& a = left.getTemperatureAggregate();
+    const TemperatureAggregate& b = right.getTemperatureAggregate();
+    return left.getSolNumber() == right.getSolNumber() &&
+           left.getTemperatureData() == right.getTemperatureData() && a.count == b.count &&
+           a.minimum == b.minimum && a.maximum == b.maximum && a.mean == b.mean &&
+           left.getNavigationData().finalDistance.getValue() ==
+               right.getNavigationData().finalDistance.getValue() &&
+           left.getNavigationData().finalDirection == right.getNavigationData().finalDirection &&
+           left.getSampleData().getElementId() == right.getSampleData().getElementId() &&
+           left.getSampleReading().collected == right.getSampleReading().collected &&
+           left.getSampleReading().wavelength == right.getSampleReading().wavelength;
+}
+}  // namespace
+
+void test_compressed_storage() {
+    DataStorage plain;
+    DataStorage compressed(DuplicateSOLPolicy::Replace, SOLStorageLayout::CompressedBlocks);
+    // A gap after SOL 1500 breaks the constant SOL delta of its block.
+    for (int sol = 1; sol <= 3100; ++sol) {
+        const int number = sol > 1500 ? sol + 10 : sol;
+        plain.storeSOLData(makeCompressibleSOL(number));
+        compressed.storeSOLData(makeCompressibleSOL(number));
+    }
+    assert(compressed.size() == 3100);
+    assert(compressed.getFootprint() * 5 <= plain.getFootprint());
+
+    // Every row decodes bit-exactly, by lookup and by block scan.
+    const std::vector<SOLData> expected = plain.getAllSOLData();
+    std::size_t scanned = 0;
+    double blockSum = 0.0;
+    compressed.forEachBlock([&](const SOLColumnStore& block) {
+        assert(block.size() <= SOL_BLOCK_SIZE);
+        for (std::size_t row = 0; row < block.size(); ++row) {
+            assert(sameSOL(block.row(row), expected[scanned + row]));
+        }
+        blockSum += ReductionKernels::minMaxSum(block.getTemperatures().data(), block.size()).sum;
+        scanned += block.size();
+    });
+    assert(scanned == 3100);
+    const SOLColumnStore& columns = plain.getColumns();
+    assert(std::fabs(blockSum - ReductionKernels::minMaxSum(columns.getTemperatures().data(),
+                                                            columns.size()).sum) < 1e-6);
+    assert(sameSOL(compressed.getSOLData(1511), plain.getSOLData(1511)));
+    assert(compressed.view().size() == 3100);
+
+    // Out-of-order inserts and replacements land inside sealed blocks.
+    SOLData late = makeCompressibleSOL(1505);
+    compressed.storeSOLData(late);
+    SOLData replaced(20);
+    replaced.storeTemperatureData(-40.0);
+    compressed.storeSOLData(replaced);
+    assert(compressed.size() == 3101);
+    assert(sameSOL(compressed.getSOLData(1505), late));
+    assert(compressed.getSOLData(20).getTemperatureData() == -40.0);
+    const std::vector<SOLData> all = compressed.getAllSOLData();
+    for (std::size_t i = 1; i < all.size(); ++i) {
+        assert(all[i - 1].getSolNumber() < all[i].getSolNumber());
+    }
+    assert(sameSOL(compressed.getSOLData(3110), plain.getSOLData(3110)));
+}
+
+void test_sol_query() {
+    DataStorage plain;
+    DataStorage compressed(DuplicateSOLPolicy::Reject, SOLStorageLayout::CompressedBlocks);
+    for (int sol = 1; sol <= 2500; ++sol) {
+        plain.storeSOLData(makeCompressibleSOL(sol));
+        compressed.storeSOLData(makeCompressibleSOL(sol));
+    }
+    SOLData unordered(2501);
+    unordered.storeTemperatureData(std::nan(""));
+    plain.storeSOLData(unordered);
+    compressed.storeSOLData(unordered);
+
+    // Every query matches a hand-written loop, under both layouts.
+    const std::vector<SOLData> rows = plain.getAllSOLData();
+    std::vector<int> expectedSOLs;
+    SOLAggregate expectedLeft;
+    std::map<int, SOLAggregate> expectedByElement;
+    for (const SOLData& row : rows) {
+        const double distance = row.getNavigationData().finalDistance.getValue();
+        const int element = row.getSampleData().getElementId();
+        if (element == 0 && distance > 50.0) {
+            expectedSOLs.push_back(row.getSolNumber());
+        }
+        if (row.getNavigationData().finalDirection == Direction::Left) {
+            expectedLeft.add(row.getTemperatureData());
+        }
+        if (element < 1.5 && row.getSolNumber() >= 1000) {
+            expectedByElement[element].add(distance);
+        }
+    }
+    SOLQuery farSamples;
+    farSamples.where(SOLColumn::Element, SOLComparison::Equal, 0)
+        .where(SOLColumn::Distance, SOLComparison::Greater, 50.0);
+    SOLQuery left;
+    left.where(SOLColumn::Direction, SOLComparison::Equal, static_cast<int>(Direction::Left));
+    SOLQuery grouped;
+    grouped.where(SOLColumn::Element, SOLComparison::Less, 1.5)
+        .where(SOLColumn::SolNumber, SOLComparison::GreaterOrEqual, 1000);
+    const DataStorage* storages[] = {&plain, &compressed};
+    for (const DataStorage* storage : storages) {
+        assert(farSamples.selectSOLs(*storage) == expectedSOLs);
+        assert(farSamples.count(*storage) == expectedSOLs.size());
+        assert(farSamples.select(*storage, SOLColumn::Element) ==
+               std::vector<double>(expectedSOLs.size(), 0.0));
+        assert(expectedSOLs.size() == 77);
+
+        const SOLAggregate leftTemperature = left.aggregate(*storage, SOLColumn::Temperature);
+        assert(leftTemperature.count == expectedLeft.count);
+        assert(leftTemperature.minimum == expectedLeft.minimum);
+        assert(leftTemperature.maximum == expectedLeft.maximum);
+        assert(std::fabs(leftTemperature.getMean() - expectedLeft.getMean()) < 1e-9);
+
+        const std::map<int, SOLAggregate> byElement =
+            grouped.aggregateBy(*storage, SOLColumn::Element, SOLColumn::Distance);
+        assert(byElement.size() == expectedByElement.size());
+        for (const std::pair<const int, SOLAggregate>& group : byElement) {
+            const SOLAggregate& expected = expectedByElement[group.first];
+            assert(group.second.count == expected.count);
+            assert(std::fabs(group.second.sum - expected.sum) < 1e-6);
+        }
+
+        // NaN fails every comparison but "not equal".
+        assert(SOLQuery().where(SOLColumn::Temperature, SOLComparison::NotEqual, 0.0)
+                   .count(*storage) == 2501);
+        assert(SOLQuery().where(SOLColumn::Temperature, SOLComparison::Less, 1000.0)
+                   .count(*storage) == 2500);
+        assert(SOLQuery().where(SOLColumn::Element, SOLComparison::Equal, 0.5)
+                   .count(*storage) == 0);
+        assert(SOLQuery().where(SOLColumn::Direction, SOLComparison::Less, std::nan(""))
+                   .count(*storage) == 0);
+    }
+
+    // Zone maps skip blocks: an empty range never decodes anything.
+    std::size_t zones = 0;
+    compressed.forEachZone([](const SOLZoneMap& zone) {
+        return zone.getMaximum(SOLColumn::SolNumber) >= 2400;
+    }, [&zones](const SOLDataView& view) {
+        assert(view.back().getSolNumber() >= 2400);
+        ++zones;
+    });
+    assert(zones == 1);
+    assert(SOLQuery().where(SOLColumn::SolNumber, SOLComparison::Greater, 9000)
+               .selectSOLs(compressed).empty());
+
+    bool threw = false;
+    try {
+        SOLQuery().aggregateBy(plain, SOLColumn::Temperature, SOLColumn::Distance);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+void test_spill_to_disk() {
+    DataStorage bounded(DuplicateSOLPolicy::Replace, SOLStorageLayout::CompressedBlocks);
+    bounded.setMemoryBudget(MIN_MEMORY_BUDGET, "/tmp");
+    for (int sol = 1; sol <= 250000; ++sol) {
+        bounded.storeSOLData(makeCompressibleSOL(sol * 2));
+        assert(bounded.getResidentBytes() <= MIN_MEMORY_BUDGET);
+    }
+    assert(bounded.getFootprint() > 2 * MIN_MEMORY_BUDGET);
+
+    // Spilled blocks read back bit-exactly, by lookup and by scan.
+    assert(sameSOL(bounded.getSOLData(2), makeCompressibleSOL(2)));
+    assert(sameSOL(bounded.getSOLData(300000), makeCompressibleSOL(300000)));
+    SOLData missing(0);
+    assert(!bounded.findSOLData(3, missing));
+    std::size_t scanned = 0;
+    bounded.forEachSOLData([&scanned](const SOLData& solData) {
+        ++scanned;
+        assert(solData.getSolNumber() == static_cast<int>(2 * scanned));
+    });
+    assert(scanned == 250000);
+    assert(bounded.getResidentBytes() <= MIN_MEMORY_BUDGET);
+
+    // A SOL stored into a spilled block is re-encoded and spilled anew.
+    SOLData late = makeCompressibleSOL(7);
+    bounded.storeSOLData(late);
+    for (int sol = 490001; sol <= 499999; sol += 2) {
+        bounded.storeSOLData(makeCompressibleSOL(sol));
+    }
+    assert(sameSOL(bounded.getSOLData(7), late));
+    assert(bounded.storeSOLData(makeCompressibleSOL(8)));
+    assert(bounded.size() == 255001);
+    assert(bounded.getResidentBytes() <= MIN_MEMORY_BUDGET);
+    assert(SOLQuery().where(SOLColumn::SolNumber, SOLComparison::Less, 1000).count(bounded) == 500);
+
+    bool threw = false;
+    try {
+        bounded.view();
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        DataStorage().setMemoryBudget(MIN_MEMORY_BUDGET, "/tmp");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+void test_spill_reuses_released_ranges() {
+    DataStorage bounded(DuplicateSOLPolicy::Replace, SOLStorageLayout::CompressedBlocks);
+    bounded.setMemoryBudget(MIN_MEMORY_BUDGET, "/tmp");
+    const int last = 250000;
+    for (int sol = 1; sol <= last; ++sol) {
+        bounded.storeSOLData(makeCompressibleSOL(sol));
+    }
+    assert(bounded.getSpilledBytes() > 0);
+
+    // Rewriting a SOL of a spilled block, then reading far enough away to
+    // spill it again, must reuse the stale copy's range.
+    std::uint64_t settled = 0;
+    for (int round = 0; round < 50; ++round) {
+        SOLData changed = makeCompressibleSOL(5);
+        changed.storeTemperatureData(180.0 + round % 7);
+        bounded.storeSOLData(changed);
+        for (int sol = 1; sol <= last; sol += SOL_BLOCK_SIZE) {
+            bounded.getSOLData(last + 1 - sol);
+        }
+        assert(bounded.getSOLData(5).getTemperatureData() == 180.0 + round % 7);
+        if (round == 0) {
+            settled = bounded.getSpilledBytes();
+        }
+        assert(bounded.getResidentBytes() <= MIN_MEMORY_BUDGET);
+    }
+    assert(bounded.getSpilledBytes() <= settled + settled / 10);
+    assert(DataStorage().getSpilledBytes() == 0);
+}
+
+void test_inverted_index() {
+    // Postings decode exactly, including after late inserts and removals.
+    SOLPostings threes;
+    SOLPostings twos;
+    std::vector<int> expected;
+    for (int sol = 3; sol <= 3000; sol += 3) {
+        threes.add(sol);
+        expected.push_back(sol);
+    }
+    for (int sol = 2; sol <= 3000; sol += 2) {
+        twos.add(sol);
+    }
+    assert(!threes.add(300));
+    assert(threes.add(1));
+    assert(threes.remove(1));
+    assert(!threes.remove(4));
+    assert(threes.getSOLs() == expected);
+    assert(threes.contains(2997) && !threes.contains(2998));
+    assert(threes.getFootprint() < 2 * threes.size());
+    const std::vector<int> newest = threes.getLast(3);
+    assert(newest.size() == 3 && newest[0] == 3000 && newest[2] == 2994);
+    const std::vector<int> sixes = SOLPostings::intersect({&threes, &twos});
+    assert(sixes.size() == 500 && sixes.front() == 6 && sixes.back() == 3000);
+    const SOLPostings none;
+    assert(SOLPostings::intersect({&threes, &twos, &none}).empty());
+
+    // The storage keeps its index in step with a query over the same rows.
+    DataStorage storage(DuplicateSOLPolicy::Replace, SOLStorageLayout::CompressedBlocks);
+    for (int sol = 1; sol <= 2500; ++sol) {
+        storage.storeSOLData(makeCompressibleSOL(sol));
+    }
+    SOLData replaced = makeCompressibleSOL(21);
+    replaced.storeSampleData(SampleClassification(1));
+    storage.storeSOLData(replaced);
+    const SOLInvertedIndex& index = storage.getInvertedIndex();
+    SOLQuery iron;
+    iron.where(SOLColumn::Element, SOLComparison::Equal, 1);
+    assert(index.getPostings(SOLColumn::Element, 1).getSOLs() == iron.selectSOLs(storage));
+    assert(index.getPostings(SOLColumn::Element, 1).contains(21));
+    iron.where(SOLColumn::Direction, SOLComparison::Equal, static_cast<int>(Direction::Left));
+    assert(SOLPostings::intersect({&index.getPostings(SOLColumn::Element, 1),
+                                   &index.getPostings(SOLColumn::Direction,
+                                                      static_cast<int>(Direction::Left))}) ==
+           iron.selectSOLs(storage));
+    assert(index.getPostings(SOLColumn::Element, 99).size() == 0);
+
+    bool threw = false;
+    try {
+        index.getPostings(SOLColumn::Temperature);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    DataStorage bounded(DuplicateSOLPolicy::Reject, SOLStorageLayout::CompressedBlocks);
+    bounded.setMemoryBudget(MIN_MEMORY_BUDGET, "/tmp");
+    try {
+        bounded.getInvertedIndex();
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+void test_segment_log() {
+    // Readers on other threads see a growing, consistent prefix while the
+    // writer appends across many segments.
+    SOLSegmentLog log;
+    const std::size_t total = 6 * SOL_SEGMENT_ROWS + 100;
+    std::atomic<bool> done(false);
+    std::vector<std::thread> readers;
+    for (int reader = 0; reader < 3; ++reader) {
+        readers.emplace_back([&log, &done]() {
+            std::size_t seen = 0;
+            while (!done.load()) {
+                const std::size_t published = log.size();
+                assert(published >= seen);
+                seen = published;
+                if (published > 0) {
+                    assert(log.row(published - 1).getSolNumber() == static_cast<int>(published));
+                }
+                std::size_t scanned = 0;
+                log.forEachSegment([&scanned](const SOLDataView& segment) {
+                    const ColumnSpan<int> solNumbers = segment.getSolNumbers();
+                    for (std::size_t row = 0; row < solNumbers.size(); ++row) {
+                        assert(solNumbers[row] == static_cast<int>(scanned + row + 1));
+                    }
+                    scanned += segment.size();
+                });
+                assert(scanned >= published);
+            }
+        });
+    }
+    for (std::size_t sol = 1; sol <= total; ++sol) {
+        log.append(makeCompressibleSOL(static_cast<int>(sol)));
+    }
+    done.store(true);
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    assert(log.size() == total);
+    assert(sameSOL(log.row(total - 1), makeCompressibleSOL(static_cast<int>(total))));
+    bool threw = false;
+    try {
+        log.row(total);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+}
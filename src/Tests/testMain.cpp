@@ -3,16 +3,78 @@
 
 extern void test_handle_record();
 extern void test_finalize_sol();
+extern void test_multiple_temperatures_per_sol();
+extern void test_view_observations();
+extern void test_checkpoint_resume();
+extern void test_static_robot();
+extern void test_finalize_allocations();
 extern void test_advance_sol();
+extern void test_async_observers();
 extern void test_store_and_retrieve_sol_data();
+extern void test_find_and_view_sol_data();
+extern void test_series_downsampling();
+extern void test_sol_index();
+extern void test_column_store();
+extern void test_sol_archive();
+extern void test_compressed_storage();
+extern void test_sol_query();
+extern void test_spill_to_disk();
+extern void test_spill_reuses_released_ranges();
+extern void test_inverted_index();
+extern void test_segment_log();
+extern void test_classification_cache();
+extern void test_classification_cache_boundaries();
+extern void test_cached_sample_classification();
+extern void test_cluster_unknown_samples();
+extern void test_percentile_selection();
+extern void test_order_statistics();
+extern void test_streaming_temperature_statistics();
+extern void test_season_model();
+extern void test_rolling_temperature_windows();
+extern void test_reduction_kernels();
+extern void test_temperature_anomaly_detector();
+extern void test_anomaly_batch_matches_streaming();
+extern void test_seasonality_analyzer();
+extern void test_quantile_sketch();
 
 int main() {
     std::cout << "Running Mars Rover Tests...\n";
 
     test_handle_record();
     test_finalize_sol();
+    test_multiple_temperatures_per_sol();
+    test_view_observations();
+    test_checkpoint_resume();
+    test_static_robot();
+    test_finalize_allocations();
     test_advance_sol();
+    test_async_observers();
     test_store_and_retrieve_sol_data();
+    test_find_and_view_sol_data();
+    test_series_downsampling();
+    test_sol_index();
+    test_column_store();
+    test_sol_archive();
+    test_compressed_storage();
+    test_sol_query();
+    test_spill_to_disk();
+    test_spill_reuses_released_ranges();
+    test_inverted_index();
+    test_segment_log();
+    test_classification_cache();
+    test_classification_cache_boundaries();
+    test_cached_sample_classification();
+    test_cluster_unknown_samples();
+    test_percentile_selection();
+    test_order_statistics();
+    test_streaming_temperature_statistics();
+    test_season_model();
+    test_rolling_temperature_windows();
+    test_reduction_kernels();
+    test_temperature_anomaly_detector();
+    test_anomaly_batch_matches_streaming();
+    test_seasonality_analyzer();
+    test_quantile_sketch();
 
     std::cout << "All tests passed successfully!\n";
     return 0;
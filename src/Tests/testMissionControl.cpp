@@ -1,5 +1,13 @@
 // test_mission_control.cpp
+#include <unistd.h>
+#include <atomic>
 #include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+#include "Core/BasicRobot.h"
 #include "Core/MissionControl.h"
 #include "Core/Robot.h"
 #include "Data/SOLManager.h"
@@ -69,4 +77,241 @@ void test_finalize_sol() {
     auto observations = missionControl->getObservations();
     assert(observations.size() == 1);
     assert(observations[0].getTemperatureData() == 15);
-}
\ No newline at end of file
+}
+void test_multiple_temperatures_per_sol() {
+    auto robot = Robot::createRobot();
+    auto solManager = make_unique_ptr<SOLManager>();
+    auto dataStorage = make_unique_ptr<DataStorage>();
+    auto recordParser = make_unique_ptr<RecordParser>();
+
+    auto missionControl = std::make_shared<MissionControl>(std::move(robot), std::move(solManager),
+                                                         std::move(dataStorage), std::move(recordParser));
+    missionControl->initialize();
+
+    missionControl->handleRecord("t,200,kelvin");
+    missionControl->handleRecord("t,180,kelvin");
+    missionControl->handleRecord("t,190,kelvin");
+    missionControl->finalizeCurrentSOL();
+    missionControl->handleRecord("t,250,kelvin");
+    missionControl->finalizeCurrentSOL();
+
+    auto observations = missionControl->getObservations();
+    assert(observations.size() == 2);
+    const TemperatureAggregate& first = observations[0].getTemperatureAggregate();
+    assert(first.count == 3);
+    assert(first.minimum == 180 && first.maximum == 200);
+    assert(first.mean == 190 && first.last == 190);
+    assert(observations[0].getTemperatureData() == 190);
+
+    // Readings do not leak into the next SOL.
+    const TemperatureAggregate& second = observations[1].getTemperatureAggregate();
+    assert(second.count == 1 && second.minimum == 250 && second.mean == 250);
+}
+
+void test_view_observations() {
+    auto robot = Robot::createRobot();
+    auto solManager = make_unique_ptr<SOLManager>();
+    auto dataStorage = make_unique_ptr<DataStorage>();
+    auto recordParser = make_unique_ptr<RecordParser>();
+
+    auto missionControl = std::make_shared<MissionControl>(std::move(robot), std::move(solManager),
+                                                         std::move(dataStorage), std::move(recordParser));
+    missionControl->initialize();
+    assert(missionControl->viewObservations().empty());
+
+    for (int reading = 200; reading <= 220; reading += 10) {
+        missionControl->handleRecord("t," + std::to_string(reading) + ",kelvin");
+        missionControl->finalizeCurrentSOL();
+    }
+
+    auto observations = missionControl->getObservations();
+    const SOLDataView view = missionControl->viewObservations();
+    assert(view.size() == observations.size() && view.size() == 3);
+    for (std::size_t index = 0; index < view.size(); ++index) {
+        assert(view[index].getSolNumber() == observations[index].getSolNumber());
+        assert(view[index].getTemperatureData() == observations[index].getTemperatureData());
+    }
+
+    std::size_t visited = 0;
+    missionControl->forEachObservation([&](const SOLData& solData) {
+        assert(solData.getSolNumber() == observations[visited].getSolNumber());
+        assert(solData.getTemperatureData() == observations[visited].getTemperatureData());
+        ++visited;
+    });
+    assert(visited == observations.size());
+}
+
+namespace {
+std::shared_ptr<MissionControl> createArchivingMissionControl(
+        const std::string& directory, std::shared_ptr<SOLArchiveWriter>& archiveWriter) {
+    auto solManager = make_unique_ptr<SOLManager>();
+    archiveWriter = std::make_shared<SOLArchiveWriter>(directory, 2);
+    solManager->addObserver(archiveWriter);
+    auto missionControl = std::make_shared<MissionControl>(
+        Robot::createRobot(), std::move(solManager), make_unique_ptr<DataStorage>(),
+        make_unique_ptr<RecordParser>());
+    missionControl->initialize();
+    missionControl->enableCheckpoints(
+        archiveWriter, make_unique_ptr<CheckpointWriter>(directory + "/CHECKPOINT"), 2);
+    return missionControl;
+}
+}  // namespace
+
+void test_checkpoint_resume() {
+    char directoryTemplate[] = "/tmp/checkpoint_XXXXXX";
+    const std::string directory = mkdtemp(directoryTemplate);
+    {
+        std::shared_ptr<SOLArchiveWriter> archiveWriter;
+        auto missionControl = createArchivingMissionControl(directory, archiveWriter);
+        for (int sol = 0; sol < 5; ++sol) {
+            missionControl->handleRecord("t," + std::to_string(10 + sol) + ",celsius");
+            missionControl->finalizeCurrentSOL();
+            missionControl->advanceInput(100 + sol);
+        }
+        // Checkpoint mid-SOL, then keep going past it before "crashing".
+        missionControl->handleRecord("t,40,celsius");
+        missionControl->checkpoint(200);
+        missionControl->flushCheckpoints();
+        missionControl->finalizeCurrentSOL();
+        archiveWriter->commit();
+    }
+
+    IngestCheckpoint checkpoint;
+    assert(CheckpointWriter::read(directory + "/CHECKPOINT", checkpoint));
+    assert(checkpoint.inputOffset == 200 && checkpoint.storedSOLs == 5);
+    assert(checkpoint.robotState.temperature.count == 1);
+
+    std::shared_ptr<SOLArchiveWriter> archiveWriter;
+    auto missionControl = createArchivingMissionControl(directory, archiveWriter);
+    assert(archiveWriter->getCommittedCount() == 6);
+    assert(missionControl->resume(checkpoint) == 200);
+    // The SOL committed after the checkpoint is rolled back and replayed.
+    assert(archiveWriter->getCommittedCount() == 5);
+    missionControl->finalizeCurrentSOL();
+    const SOLDataView observations = missionControl->viewObservations();
+    assert(observations.size() == 6);
+    assert(observations[5].getSolNumber() == observations[4].getSolNumber() + 1);
+    assert(observations[5].getTemperatureData() == 40 + 273.15);
+
+    bool missing = CheckpointWriter::read(directory + "/NONE", checkpoint);
+    assert(!missing);
+    const char* files[] = {"CHECKPOINT", "MANIFEST", "sol_numbers.col", "temperatures.col",
+                           "distances.col", "directions.col", "element_ids.col",
+                           "temperature_aggregates.col", "sample_readings.col"};
+    for (const char* file : files) {
+        std::remove((directory + "/" + file).c_str());
+    }
+    rmdir(directory.c_str());
+}
+
+namespace {
+// Temperature subsystem that counts its readings, plugged into a BasicRobot
+// without any virtual method.
+class CountingTemperature : public Temperature {
+public:
+    int readings = 0;
+
+    void addTemperature(const Measurement& temperature) {
+        ++readings;
+        Temperature::addTemperature(temperature);
+    }
+};
+}  // namespace
+
+void test_static_robot() {
+    const std::string input =
+        "t,20.5,celsius\n"
+        "d,3.5,meters,left,2,sols,1.5,meters,left,2,sols,"
+        "1.0,meters,right,2,sols,2.0,meters,forward,2,sols\n"
+        "t,14.5,celsius\n"
+        "t,300,kelvin\n";
+
+    BasicRobot<Navigation, CountingTemperature, SampleAnalysis> robot;
+    std::vector<SOLData> sols;
+    std::istringstream stream(input);
+    const std::size_t finalized =
+        ingestRecords(stream, robot, 1, [&sols](const SOLData& solData) { sols.push_back(solData); });
+    assert(finalized == 3);
+    assert(sols.size() == 3);
+    assert(sols[2].getSolNumber() == 3);
+    // Records reached the instrumented subsystem, not Temperature's method.
+    assert(robot.getTemperature().readings == 3);
+
+    // The adapted robot behaves exactly like Robot inside MissionControl.
+    auto viaRobot = std::make_shared<MissionControl>(
+        Robot::createRobot(), make_unique_ptr<SOLManager>(), make_unique_ptr<DataStorage>(),
+        make_unique_ptr<RecordParser>());
+    auto viaAdapter = std::make_shared<MissionControl>(
+        make_unique_ptr<RobotAdapter<BasicRobot<>>>(), make_unique_ptr<SOLManager>(),
+        make_unique_ptr<DataStorage>(), make_unique_ptr<RecordParser>());
+    viaRobot->initialize();
+    viaAdapter->initialize();
+    std::istringstream lines(input);
+    std::string record;
+    while (std::getline(lines, record)) {
+        viaRobot->handleRecord(record);
+        viaAdapter->handleRecord(record);
+        if (record[0] == 't') {
+            viaRobot->finalizeCurrentSOL();
+            viaAdapter->finalizeCurrentSOL();
+        }
+    }
+    const SOLDataView expected = viaRobot->viewObservations();
+    const SOLDataView actual = viaAdapter->viewObservations();
+    assert(expected.size() == sols.size() && actual.size() == sols.size());
+    for (std::size_t i = 0; i < sols.size(); ++i) {
+        assert(actual[i].getTemperatureData() == expected[i].getTemperatureData());
+        assert(sols[i].getTemperatureData() == expected[i].getTemperatureData());
+        assert(sols[i].getNavigationData().finalDirection ==
+               expected[i].getNavigationData().finalDirection);
+    }
+}
+
+namespace {
+std::atomic<long> heapAllocations(0);
+}  // namespace
+
+// Counts every allocation of the test binary, for test_finalize_allocations.
+void* operator new(std::size_t size) {
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void test_finalize_allocations() {
+    // Finalizing a SOL passes one SOLData by reference from the Robot to
+    // storage; only amortized column growth and block sealing allocate.
+    const SOLStorageLayout layouts[] = {SOLStorageLayout::Columnar,
+                                        SOLStorageLayout::CompressedBlocks};
+    for (const SOLStorageLayout layout : layouts) {
+        auto missionControl = std::make_shared<MissionControl>(
+            Robot::createRobot(), make_unique_ptr<SOLManager>(),
+            make_unique_ptr<DataStorage>(DuplicateSOLPolicy::Reject, layout),
+            make_unique_ptr<RecordParser>());
+        missionControl->initialize();
+        const int sols = 20000;
+        long finalizeAllocations = 0;
+        for (int sol = 0; sol < sols; ++sol) {
+            missionControl->handleRecord("t,14.5,celsius");
+            missionControl->handleRecord(
+                "d,3.5,meters,left,2,sols,1.5,meters,left,2,sols,"
+                "1.0,meters,right,2,sols,2.0,meters,forward,2,sols");
+            const long before = heapAllocations.load(std::memory_order_relaxed);
+            missionControl->finalizeCurrentSOL();
+            finalizeAllocations += heapAllocations.load(std::memory_order_relaxed) - before;
+        }
+        assert(missionControl->getDataStorage().size() == static_cast<std::size_t>(sols));
+        assert(finalizeAllocations * 20 < sols);
+    }
+}
@@ -1,5 +1,11 @@
 // test_sol_manager.cpp
+#include <atomic>
 #include <cassert>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "Data/AsyncSOLObserver.h"
 #include "Data/SOLManager.h"
 
 void test_advance_sol() {
@@ -9,3 +15,99 @@ void test_advance_sol() {
     solManager.advanceSOL();
     assert(solManager.getCurrentSOL() == 2);
 }
+
+namespace {
+// Records the SOLs it receives; holds the first delivery until released, to
+// stand in for a slow consumer.
+class RecordingObserver : public SOLObserver {
+public:
+    std::vector<int> solNumbers;
+    std::atomic<bool> released;
+    int failOnSol;
+
+    explicit RecordingObserver(bool released = true, int failOnSol = 0)
+        : released(released), failOnSol(failOnSol) {}
+
+    void onSOLFinalized(const SOLData& solData) override {
+        while (!released.load()) {
+            std::this_thread::yield();
+        }
+        if (solData.getSolNumber() == failOnSol) {
+            throw std::runtime_error("observer failed");
+        }
+        solNumbers.push_back(solData.getSolNumber());
+    }
+};
+
+bool isIncreasing(const std::vector<int>& solNumbers) {
+    for (std::size_t i = 1; i < solNumbers.size(); ++i) {
+        if (solNumbers[i] <= solNumbers[i - 1]) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+void test_async_observers() {
+    const int sols = 50;
+    bool rejected = false;
+    try {
+        AsyncSOLObserver odd(std::make_shared<RecordingObserver>(), 3);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    assert(rejected);
+
+    // Block delivers every SOL in order.
+    auto everything = std::make_shared<RecordingObserver>();
+    SOLManager solManager;
+    solManager.addObserver(everything, BackpressurePolicy::Block, 4);
+    for (int sol = 1; sol <= sols; ++sol) {
+        solManager.notifyObservers(SOLData(sol));
+    }
+    solManager.flushObservers();
+    assert(everything->solNumbers.size() == static_cast<std::size_t>(sols));
+    assert(isIncreasing(everything->solNumbers));
+
+    // A stalled consumer does not stall the producer under DropOldest: the
+    // newest SOLs are kept, plus any the consumer took before stalling.
+    auto latest = std::make_shared<RecordingObserver>(false);
+    AsyncSOLObserver dropping(latest, 4, BackpressurePolicy::DropOldest);
+    for (int sol = 1; sol <= sols; ++sol) {
+        dropping.onSOLFinalized(SOLData(sol));
+    }
+    latest->released.store(true);
+    dropping.flush();
+    assert(latest->solNumbers.size() + dropping.getDroppedCount() == static_cast<std::size_t>(sols));
+    assert(latest->solNumbers.size() <= 5 && isIncreasing(latest->solNumbers));
+    assert(latest->solNumbers.back() == sols);
+    assert(latest->solNumbers[latest->solNumbers.size() - 4] == sols - 3);
+
+    // Coalesce keeps the SOLs queued before the stall and collapses the rest
+    // into the newest one.
+    auto coalescing = std::make_shared<RecordingObserver>(false);
+    AsyncSOLObserver merging(coalescing, 4, BackpressurePolicy::Coalesce);
+    for (int sol = 1; sol <= sols; ++sol) {
+        merging.onSOLFinalized(SOLData(sol));
+    }
+    coalescing->released.store(true);
+    merging.flush();
+    assert(coalescing->solNumbers.size() + merging.getCoalescedCount() ==
+           static_cast<std::size_t>(sols));
+    assert(coalescing->solNumbers.size() <= 6 && isIncreasing(coalescing->solNumbers));
+    assert(coalescing->solNumbers.front() == 1 && coalescing->solNumbers.back() == sols);
+
+    // A failing observer surfaces its exception on the producer's thread.
+    AsyncSOLObserver failing(std::make_shared<RecordingObserver>(true, 3));
+    for (int sol = 1; sol <= sols; ++sol) {
+        failing.onSOLFinalized(SOLData(sol));
+    }
+    bool threw = false;
+    try {
+        failing.flush();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+}
@@ -0,0 +1,123 @@
+// test_sample_analysis.cpp
+#include <cassert>
+#include "Subsystems/ClassificationCache.h"
+#include "Subsystems/SampleAnalysis.h"
+#include "Subsystems/SampleClassification.h"
+#include "Subsystems/SampleClustering.h"
+
+void test_classification_cache() {
+    SampleClassification classifier;
+    ClassificationCache cache(64);
+    cache.setLibraryVersion(classifier.getLibraryVersion());
+
+    int elementId = 0;
+    assert(!cache.lookup(390.0, 0.9, elementId));
+    cache.insert(390.0, 0.9, classifier.matchElement(390.0, 0.9));
+
+    // Only the exact reading hits; a near-identical one shares its hash
+    // bucket but may fall on the other side of a classifier threshold.
+    assert(cache.lookup(390.0, 0.9, elementId));
+    assert(elementId == classifier.matchElement(390.0, 0.9));
+    assert(!cache.lookup(390.0000001, 0.9, elementId));
+    assert(cache.getStatistics().hits == 1);
+    assert(cache.getStatistics().misses == 2);
+
+    // A new library version discards every cached entry.
+    cache.setLibraryVersion(classifier.getLibraryVersion() + 1);
+    assert(!cache.lookup(390.0, 0.9, elementId));
+    assert(cache.getStatistics().hitRate() == 1.0 / 4.0);
+}
+
+void test_classification_cache_boundaries() {
+    // Readings straddling an intensity threshold or an inclusive band edge
+    // agree in every hashed bit yet classify differently; the cache must
+    // answer each with the classifier's own result.
+    SampleClassification classifier;
+    const double pairs[][2][2] = {
+        {{420.0, 0.2}, {420.0, 0.199999999}},
+        {{420.0, 0.8}, {420.0, 0.799999999}},
+        {{420.0, 0.85}, {420.0, 0.849999999}},
+    };
+    for (const auto& pair : pairs) {
+        for (int seeded = 0; seeded < 2; ++seeded) {
+            ClassificationCache cache(64);
+            cache.setLibraryVersion(classifier.getLibraryVersion());
+            const double* first = pair[seeded];
+            const double* second = pair[1 - seeded];
+            cache.insert(first[0], first[1], classifier.matchElement(first[0], first[1]));
+            int elementId = 0;
+            assert(!cache.lookup(second[0], second[1], elementId));
+            cache.insert(second[0], second[1], classifier.matchElement(second[0], second[1]));
+            assert(cache.lookup(first[0], first[1], elementId));
+            assert(elementId == classifier.matchElement(first[0], first[1]));
+            assert(cache.lookup(second[0], second[1], elementId));
+            assert(elementId == classifier.matchElement(second[0], second[1]));
+        }
+    }
+    assert(classifier.matchElement(420.0, 0.2) != classifier.matchElement(420.0, 0.199999999));
+
+    // Sweep both sides of every integer wavelength edge near the library.
+    ClassificationCache cache(1 << 12);
+    cache.setLibraryVersion(classifier.getLibraryVersion());
+    const double intensities[] = {0.1, 0.2, 0.5, 0.8, 0.85, 0.9};
+    for (int edge = 350; edge <= 800; ++edge) {
+        for (const double intensity : intensities) {
+            const double readings[] = {static_cast<double>(edge), edge + 1e-9, edge - 1e-9};
+            for (const double wavelength : readings) {
+                int elementId = 0;
+                if (!cache.lookup(wavelength, intensity, elementId)) {
+                    elementId = classifier.matchElement(wavelength, intensity);
+                    cache.insert(wavelength, intensity, elementId);
+                }
+                assert(elementId == classifier.matchElement(wavelength, intensity));
+            }
+        }
+    }
+}
+
+void test_cached_sample_classification() {
+    SampleAnalysis cached;
+    SampleAnalysis uncached;
+    cached.enableClassificationCache();
+
+    for (int sol = 0; sol < 3; ++sol) {
+        Measurement wavelength(4.2e-7, UnitType::Distance,
+                               static_cast<int>(DistanceUnit::Meter));
+        cached.addRecord(wavelength, 0.3);
+        uncached.addRecord(wavelength, 0.3);
+        cached.classifySample();
+        uncached.classifySample();
+        assert(cached.getElementClassification() ==
+               uncached.getElementClassification());
+        cached.reset();
+        uncached.reset();
+    }
+    assert(cached.getClassificationCache()->getStatistics().hits == 2);
+}
+
+void test_cluster_unknown_samples() {
+    std::vector<int> solNumbers;
+    std::vector<SampleReading> readings;
+    for (int sol = 1; sol <= 200; ++sol) {
+        SampleReading reading;
+        reading.wavelength = (sol % 2 == 0 ? 4.0e-7 : 7.0e-7) + sol * 1e-12;
+        reading.intensity = (sol % 2 == 0 ? 0.2 : 0.9);
+        reading.collected = true;
+        solNumbers.push_back(sol);
+        readings.push_back(reading);
+    }
+
+    ClusteringOptions options;
+    options.clusterCount = 2;
+    options.batchSize = 64;
+    options.iterations = 20;
+    ClusteringResult result = SampleClustering(options).clusterReadings(solNumbers, readings);
+
+    assert(result.clusters.size() == 2);
+    assert(result.assignments.size() == 200);
+    assert(result.clusters[0].size == 100 && result.clusters[1].size == 100);
+    // Samples from the same group always share a cluster.
+    for (const auto& assignment : result.assignments) {
+        assert(assignment.cluster == result.assignments[1 - assignment.solNumber % 2].cluster);
+    }
+}
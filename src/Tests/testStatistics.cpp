@@ -0,0 +1,420 @@
+// test_statistics.cpp
+#include <algorithm>
+#include <cfloat>
+#include <cassert>
+#include <cmath>
+#include <random>
+#include "Subsystems/Temperature.h"
+#include "Temperature/FourierTransform.h"
+#include "Temperature/OrderStatistics.h"
+#include "Temperature/QuantileSketch.h"
+#include "Temperature/ReductionKernels.h"
+#include "Temperature/RollingTemperatureWindows.h"
+#include "Temperature/SeasonModel.h"
+#include "Temperature/SeasonalityAnalyzer.h"
+#include "Temperature/StreamingTemperatureStatistics.h"
+#include "Temperature/TemperatureAnomalyDetector.h"
+
+void test_percentile_selection() {
+    std::vector<double> data = {250.0, 210.5, 199.0, 275.25, 230.0, 180.0};
+    assert(Statistics::calculateMedian(data) == (210.5 + 230.0) / 2.0);
+    assert(Statistics::calculatePercentile(data, 0.0) == 180.0);
+    assert(Statistics::calculatePercentile(data, 100.0) == 275.25);
+    // Rank 0.2 * 5 = 1 lands exactly on the second smallest value.
+    assert(Statistics::calculatePercentile(data, 20.0) == 199.0);
+
+    // Selection agrees with a full sort on odd and even sizes.
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> temperature(-150.0, 450.0);
+    std::vector<double> values;
+    for (int sol = 1; sol <= 1000; ++sol) {
+        values.push_back(temperature(rng));
+        if (sol % 97 == 0 || sol % 97 == 1) {
+            std::vector<double> sorted = values;
+            std::sort(sorted.begin(), sorted.end());
+            const std::size_t size = sorted.size();
+            const double median = size % 2 == 0
+                                      ? (sorted[size / 2 - 1] + sorted[size / 2]) / 2.0
+                                      : sorted[size / 2];
+            assert(Statistics::calculateMedian(values) == median);
+            assert(Statistics::calculatePercentile(values, 0.0) == sorted.front());
+            assert(Statistics::calculatePercentile(values, 100.0) == sorted.back());
+        }
+    }
+}
+
+void test_order_statistics() {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> temperature(-150.0, 450.0);
+    OrderStatistics orderStatistics;
+    std::vector<double> values;
+    for (int sol = 1; sol <= 1000; ++sol) {
+        values.push_back(temperature(rng));
+        orderStatistics.insert(values.back());
+
+        if (sol % 97 == 0) {
+            std::vector<double> sorted = values;
+            std::sort(sorted.begin(), sorted.end());
+            assert(orderStatistics.size() == sorted.size());
+            assert(orderStatistics.select(0) == sorted.front());
+            assert(orderStatistics.select(sorted.size() / 3) == sorted[sorted.size() / 3]);
+            assert(orderStatistics.median() == Statistics::calculateMedian(values));
+            assert(orderStatistics.percentile(90.0) ==
+                   Statistics::calculatePercentile(values, 90.0));
+        }
+    }
+}
+
+void test_streaming_temperature_statistics() {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> temperature(150.0, 300.0);
+    StreamingTemperatureStatistics streaming;
+    std::vector<double> values;
+    for (int sol = 1; sol <= 1374; ++sol) {
+        values.push_back(temperature(rng));
+        streaming.addTemperature(sol, values.back());
+    }
+
+    const TemperatureSnapshot snapshot = streaming.getSnapshot();
+    assert(snapshot.count == values.size());
+    assert(std::abs(snapshot.mean - Statistics::calculateMean(values)) < 1e-9);
+    assert(snapshot.median == Statistics::calculateMedian(values));
+    assert(snapshot.highest == Statistics::findLargestN(values, 3));
+    assert(snapshot.lowest == Statistics::findSmallestN(values, 3));
+    assert(snapshot.lowestSummer == Statistics::calculateLowestSummerTemperature(values));
+    assert(snapshot.lowestWinter == Statistics::calculateLowestWinterTemperature(values));
+}
+
+void test_season_model() {
+    const SeasonModel model;
+    assert(model.locate(1).marsYear == 0);
+    assert(model.locate(1).season == Season::Spring);
+
+    // Seasons have their true, unequal lengths and a year is ~668.6 sols.
+    int sol = 1;
+    int lengths[SEASON_COUNT];
+    for (size_t season = 0; season < SEASON_COUNT; ++season) {
+        const int next = model.nextSeasonStart(sol);
+        assert(model.locate(sol).season == static_cast<Season>(season));
+        lengths[season] = next - sol;
+        sol = next;
+    }
+    assert(lengths[0] > 190 && lengths[0] < 197);  // spring
+    assert(lengths[2] > 139 && lengths[2] < 146);  // autumn
+    assert(model.locate(sol).marsYear == 1);
+    assert(sol == 669 || sol == 670);
+
+    // A mission starting at Ls 90 begins in summer.
+    assert(SeasonModel(MARS_YEAR_SOLS, 90.0).locate(1).season == Season::Summer);
+
+    SeasonalStatistics seasonal(model);
+    for (int day = 1; day <= 2000; ++day) {
+        seasonal.addTemperature(day, day);
+    }
+    assert(seasonal.getYearCount() == 3);
+    const SeasonAggregate& summer = seasonal.getAggregate(Season::Summer);
+    assert(summer.minimum == model.nextSeasonStart(1));
+    assert(seasonal.getAggregate(1, Season::Summer).minimum > 669);
+}
+
+void test_rolling_temperature_windows() {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> temperature(150.0, 300.0);
+    const std::vector<size_t> sizes = {1, 7, 30};
+    RollingTemperatureWindows rolling(sizes, {0.5});
+    std::vector<double> values;
+    for (int sol = 1; sol <= 200; ++sol) {
+        values.push_back(temperature(rng));
+        rolling.addTemperature(values.back());
+
+        for (size_t w = 0; w < sizes.size(); ++w) {
+            const size_t count = std::min(sizes[w], values.size());
+            const auto begin = values.end() - count;
+            const WindowStatistics window = rolling.getWindow(w);
+            assert(window.count == count);
+            assert(window.minimum == *std::min_element(begin, values.end()));
+            assert(window.maximum == *std::max_element(begin, values.end()));
+            double sum = 0.0;
+            for (auto it = begin; it != values.end(); ++it) {
+                sum += *it;
+            }
+            assert(std::abs(window.sum - sum) < 1e-9);
+        }
+    }
+    assert(rolling.getEwma(0) > 150.0 && rolling.getEwma(0) < 300.0);
+}
+
+void test_reduction_kernels() {
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<double> temperature(-120.0, 320.0);
+    const ReductionKernels::InstructionSet best = ReductionKernels::getInstructionSet();
+    const ReductionKernels::InstructionSet sets[] = {
+        ReductionKernels::InstructionSet::Scalar,
+        ReductionKernels::InstructionSet::SSE2,
+        ReductionKernels::InstructionSet::AVX2};
+
+    // Odd lengths exercise every vector width's tail handling.
+    for (const size_t size : {0u, 1u, 3u, 15u, 17u, 33u, 1001u, 4099u}) {
+        std::vector<double> data(size);
+        for (double& value : data) {
+            value = temperature(rng);
+        }
+        double sum = 0.0, squares = 0.0, magnitude = 0.0;
+        for (const double value : data) {
+            sum += value;
+            squares += value * value;
+            magnitude += std::abs(value);
+        }
+        const double tolerance = ReductionKernels::SUM_TOLERANCE_FACTOR * size * DBL_EPSILON;
+
+        for (const ReductionKernels::InstructionSet set : sets) {
+            if (!ReductionKernels::isSupported(set)) {
+                continue;
+            }
+            ReductionKernels::setInstructionSet(set);
+            assert(ReductionKernels::getInstructionSet() == set);
+            assert(std::abs(ReductionKernels::sum(data.data(), size) - sum) <=
+                   tolerance * magnitude);
+            assert(std::abs(ReductionKernels::sumOfSquares(data.data(), size) - squares) <=
+                   tolerance * squares);
+            const MinMaxSum fused = ReductionKernels::minMaxSum(data.data(), size);
+            assert(std::abs(fused.sum - sum) <= tolerance * magnitude);
+            if (size == 0) {
+                assert(std::isinf(ReductionKernels::minimum(data.data(), size)));
+                assert(std::isinf(fused.maximum) && fused.maximum < 0.0);
+                continue;
+            }
+            const double lowest = *std::min_element(data.begin(), data.end());
+            const double highest = *std::max_element(data.begin(), data.end());
+            assert(ReductionKernels::minimum(data.data(), size) == lowest);
+            assert(ReductionKernels::maximum(data.data(), size) == highest);
+            assert(fused.minimum == lowest && fused.maximum == highest);
+        }
+    }
+    ReductionKernels::setInstructionSet(best);
+}
+
+void test_temperature_anomaly_detector() {
+    std::mt19937 rng(5);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    std::vector<int> sols;
+    std::vector<double> temperatures;
+    for (int sol = 1; sol <= 400; ++sol) {
+        sols.push_back(sol);
+        temperatures.push_back(220.0 + 10.0 * std::sin(sol / 50.0) + noise(rng));
+    }
+    const std::vector<int> spikes = {120, 250, 333};
+    for (const int sol : spikes) {
+        temperatures[sol - 1] += 40.0;
+    }
+
+    for (const AnomalyMethod method : {AnomalyMethod::RollingZScore,
+                                       AnomalyMethod::EwmaControl,
+                                       AnomalyMethod::RobustMad}) {
+        AnomalyDetectorOptions options;
+        options.method = method;
+        options.threshold = 6.0;
+        TemperatureAnomalyDetector detector(options);
+        std::vector<int> called;
+        detector.setCallback([&called](const TemperatureAnomaly& anomaly) {
+            called.push_back(anomaly.solNumber);
+        });
+        for (size_t i = 0; i < temperatures.size(); ++i) {
+            detector.addTemperature(sols[i], temperatures[i]);
+        }
+        assert(called == spikes);
+        assert(detector.getPendingCount() == spikes.size());
+        TemperatureAnomaly anomaly;
+        assert(detector.pollAnomaly(anomaly) && anomaly.solNumber == spikes[0]);
+        assert(anomaly.score > options.threshold && anomaly.temperature > anomaly.expected);
+
+        std::vector<int> batch;
+        for (const TemperatureAnomaly& flagged :
+             TemperatureAnomalyDetector::evaluate(sols, temperatures, options)) {
+            batch.push_back(flagged.solNumber);
+        }
+        assert(batch == spikes);
+    }
+
+    // A full queue keeps the newest anomalies.
+    AnomalyDetectorOptions bounded;
+    bounded.threshold = 6.0;
+    bounded.queueCapacity = 1;
+    TemperatureAnomalyDetector detector(bounded);
+    for (size_t i = 0; i < temperatures.size(); ++i) {
+        detector.addTemperature(sols[i], temperatures[i]);
+    }
+    TemperatureAnomaly newest;
+    assert(detector.pollAnomaly(newest) && newest.solNumber == spikes.back());
+    assert(detector.getDroppedCount() == spikes.size() - 1);
+}
+
+void test_anomaly_batch_matches_streaming() {
+    // Flat and low-noise series at Kelvin magnitudes are where a variance
+    // taken as sumOfSquares / n - mean^2 cancels; batch must still agree.
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> base(200.0, 300.0);
+    std::normal_distribution<double> noise(0.0, 1e-4);
+    std::vector<int> sols;
+    std::vector<double> flat;
+    std::vector<double> quiet;
+    const double level = base(rng);
+    for (int sol = 1; sol <= 600; ++sol) {
+        sols.push_back(sol);
+        // A flat history with a step far below the noise of real readings.
+        flat.push_back(sol > 300 ? level + 1e-5 : level);
+        quiet.push_back(level + noise(rng));
+    }
+
+    const auto agrees = [&sols](const std::vector<double>& series,
+                                const AnomalyDetectorOptions& options) {
+        TemperatureAnomalyDetector detector(options);
+        std::vector<int> streamed;
+        for (size_t i = 0; i < series.size(); ++i) {
+            if (detector.addTemperature(sols[i], series[i])) {
+                streamed.push_back(sols[i]);
+            }
+        }
+        std::vector<int> batch;
+        for (const TemperatureAnomaly& flagged :
+             TemperatureAnomalyDetector::evaluate(sols, series, options)) {
+            batch.push_back(flagged.solNumber);
+        }
+        return batch == streamed;
+    };
+
+    for (const std::vector<double>* series : {&flat, &quiet}) {
+        for (const AnomalyMethod method : {AnomalyMethod::RollingZScore,
+                                           AnomalyMethod::EwmaControl,
+                                           AnomalyMethod::RobustMad}) {
+            AnomalyDetectorOptions options;
+            options.method = method;
+            assert(agrees(*series, options));
+            options.windowSize = 100;
+            assert(agrees(*series, options));
+        }
+    }
+}
+
+void test_seasonality_analyzer() {
+    // Bluestein and radix-2 lengths both match a direct DFT.
+    FourierTransform transform;
+    for (const size_t size : {16u, 45u, 90u}) {
+        std::vector<std::complex<double>> data(size);
+        std::vector<double> real(size);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = std::complex<double>(std::cos(0.3 * i * i), std::sin(1.7 * i));
+            real[i] = data[i].real();
+        }
+        const std::vector<std::complex<double>> input = data;
+        std::vector<std::complex<double>> realSpectrum;
+        transform.forward(data);
+        transform.forwardReal(real, realSpectrum);
+        assert(realSpectrum.size() == size / 2 + 1);
+        for (size_t k = 0; k < size; ++k) {
+            std::complex<double> expected;
+            std::complex<double> expectedReal;
+            for (size_t j = 0; j < size; ++j) {
+                const std::complex<double> root = std::polar(1.0, -2.0 * M_PI * j * k / size);
+                expected += input[j] * root;
+                expectedReal += real[j] * root;
+            }
+            assert(std::abs(data[k] - expected) < 1e-9);
+            if (k < realSpectrum.size()) {
+                assert(std::abs(realSpectrum[k] - expectedReal) < 1e-9);
+            }
+        }
+    }
+
+    std::mt19937 rng(6);
+    std::normal_distribution<double> noise(0.0, 2.0);
+    const double warmest = 150.0;
+    std::vector<double> temperatures;
+    for (int i = 0; i < 3000; ++i) {
+        temperatures.push_back(210.0 + 0.001 * i +
+                               30.0 * std::cos(2.0 * M_PI * (i - warmest) / MARS_YEAR_SOLS) +
+                               5.0 * std::sin(2.0 * M_PI * i / 37.0) + noise(rng));
+    }
+    SeasonalityAnalyzer analyzer;
+    const SeasonalityResult result = analyzer.analyze(temperatures, 1);
+    assert(std::abs(result.dominantPeriod - MARS_YEAR_SOLS) < 0.01 * MARS_YEAR_SOLS);
+    assert(std::abs(result.peaks[1].period - 37.0) < 0.5);
+    assert(std::abs(result.amplitude - 30.0) < 3.0);
+    assert(std::abs(result.warmestSol - (1 + warmest)) < 5.0);
+
+    // Boundaries cycle through the seasons and summer spans the warmest SOL.
+    assert(result.seasons.front().sol == 1);
+    assert(result.seasons.front().season == Season::Spring);
+    assert(result.seasons[1].season == Season::Summer);
+    assert(result.seasons[1].sol <= result.warmestSol);
+    assert(result.seasons[2].sol > result.warmestSol);
+    for (size_t i = 1; i < result.seasons.size(); ++i) {
+        const int expected = (static_cast<int>(result.seasons[i - 1].season) + 1) % 4;
+        assert(static_cast<int>(result.seasons[i].season) == expected);
+    }
+    assert(result.seasons.size() >= 17 && result.seasons.size() <= 19);
+}
+
+void test_quantile_sketch() {
+    // Small inputs stay exact.
+    const std::vector<double> small = {250.0, 210.5, 199.0, 275.25, 230.0, 180.0};
+    const QuantileSketch exact = Statistics::buildQuantileSketch(small);
+    assert(exact.isExact());
+    assert(exact.median() == Statistics::calculateMedian(small));
+    assert(exact.percentile(20.0) == Statistics::calculatePercentile(small, 20.0));
+    assert(exact.percentile(90.0) == Statistics::calculatePercentile(small, 90.0));
+
+    // Shards with different distributions, merged in two different groupings.
+    std::mt19937 rng(7);
+    std::normal_distribution<double> cold(180.0, 15.0);
+    std::uniform_real_distribution<double> warm(220.0, 300.0);
+    std::vector<std::vector<double>> shards(4);
+    std::vector<double> all;
+    for (size_t shard = 0; shard < shards.size(); ++shard) {
+        for (int i = 0; i < 50000; ++i) {
+            const double value = shard % 2 == 0 ? cold(rng) : warm(rng);
+            shards[shard].push_back(value);
+            all.push_back(value);
+        }
+    }
+    std::vector<QuantileSketch> sketches;
+    MomentAccumulator left = Statistics::calculateMoments(shards[0]);
+    MomentAccumulator right = Statistics::calculateMoments(shards[3]);
+    for (const auto& shard : shards) {
+        sketches.push_back(Statistics::buildQuantileSketch(shard));
+    }
+    left.merge(Statistics::calculateMoments(shards[1]));
+    right.merge(Statistics::calculateMoments(shards[2]));
+    left.merge(right);
+    const MomentAccumulator single = Statistics::calculateMoments(all);
+    assert(left.count == single.count);
+    assert(std::abs(left.mean - single.mean) < 1e-9);
+    assert(std::abs(left.variance() - single.variance()) < 1e-6);
+    assert(left.minimum == single.minimum && left.maximum == single.maximum);
+
+    QuantileSketch sequential = sketches[0];
+    for (size_t i = 1; i < sketches.size(); ++i) {
+        sequential.merge(sketches[i]);
+    }
+    QuantileSketch paired = sketches[0];
+    paired.merge(sketches[1]);
+    QuantileSketch otherPair = sketches[2];
+    otherPair.merge(sketches[3]);
+    paired.merge(otherPair);
+    assert(!sequential.isExact() && sequential.size() == all.size());
+    assert(sequential.getFootprint() < 6 * DEFAULT_SKETCH_COMPRESSION);
+
+    std::sort(all.begin(), all.end());
+    for (const double p : {0.0, 1.0, 10.0, 25.0, 50.0, 75.0, 99.0, 100.0}) {
+        const double q = p / 100.0;
+        const double bound = M_PI * std::sqrt(q * (1.0 - q)) / DEFAULT_SKETCH_COMPRESSION;
+        for (const QuantileSketch* sketch : {&sequential, &paired}) {
+            const double estimate = sketch->percentile(p);
+            const double rank = (std::lower_bound(all.begin(), all.end(), estimate) -
+                                 all.begin()) / static_cast<double>(all.size());
+            assert(std::abs(rank - q) <= bound + 1e-4);
+        }
+    }
+    assert(sequential.percentile(0.0) == all.front());
+    assert(sequential.percentile(100.0) == all.back());
+}
@@ -0,0 +1,61 @@
+/**
+ * @file Checksum.cpp
+ * @brief Implementation of the Checksum class.
+ */
+
+#include "Utility/Checksum.h"
+
+namespace {
+const std::uint32_t CRC32C_POLYNOMIAL = 0x82F63B78u;  // Reflected.
+
+/** @brief Slicing-by-8 tables: table[k][b] is b's CRC followed by k zero bytes. */
+struct CrcTables {
+  std::uint32_t table[8][256];
+
+  CrcTables() {
+    for (std::uint32_t byte = 0; byte < 256; ++byte) {
+      std::uint32_t crc = byte;
+      for (int bit = 0; bit < 8; ++bit) {
+        crc = (crc >> 1) ^ ((crc & 1u) ? CRC32C_POLYNOMIAL : 0u);
+      }
+      table[0][byte] = crc;
+    }
+    for (std::uint32_t byte = 0; byte < 256; ++byte) {
+      for (int k = 1; k < 8; ++k) {
+        const std::uint32_t previous = table[k - 1][byte];
+        table[k][byte] = (previous >> 8) ^ table[0][previous & 0xFFu];
+      }
+    }
+  }
+};
+
+const CrcTables& getTables() {
+  static const CrcTables tables;
+  return tables;
+}
+}  // namespace
+
+std::uint32_t Checksum::crc32c(const void* data, std::size_t size,
+                               const std::uint32_t previous) {
+  const std::uint32_t(&table)[8][256] = getTables().table;
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  std::uint32_t crc = ~previous;
+  // Assemble words byte by byte so the result does not depend on alignment
+  // or host byte order.
+  while (size >= 8) {
+    const std::uint32_t low = crc ^ (static_cast<std::uint32_t>(bytes[0]) |
+                                     static_cast<std::uint32_t>(bytes[1]) << 8 |
+                                     static_cast<std::uint32_t>(bytes[2]) << 16 |
+                                     static_cast<std::uint32_t>(bytes[3]) << 24);
+    crc = table[7][low & 0xFFu] ^ table[6][(low >> 8) & 0xFFu] ^
+          table[5][(low >> 16) & 0xFFu] ^ table[4][low >> 24] ^
+          table[3][bytes[4]] ^ table[2][bytes[5]] ^ table[1][bytes[6]] ^
+          table[0][bytes[7]];
+    bytes += 8;
+    size -= 8;
+  }
+  while (size-- > 0) {
+    crc = (crc >> 8) ^ table[0][(crc ^ *bytes++) & 0xFFu];
+  }
+  return ~crc;
+}
@@ -1,6 +1,9 @@
 #include <limits.h>  // For PATH_MAX
 #include <unistd.h>  // For getcwd
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -8,20 +11,48 @@
 #include <numeric>
 #include <string>
 #include <vector>
+#include "Core/IngestCheckpoint.h"
 #include "Core/MissionControl.h"
 #include "Core/Robot.h"
+#include "Data/AsyncSOLObserver.h"
 #include "Data/DataStorage.h"
+#include "Data/SOLArchive.h"
 #include "Data/SOLManager.h"
+#include "Data/SOLQuery.h"
+#include "Data/SeriesExport.h"
 #include "Records/RecordParser.h"
 #include "Subsystems/SampleClassification.h"
+#include "Temperature/StreamingTemperatureStatistics.h"
 #include "Utility/MakeUnique.h"
 
 int main(int argc, char* argv[]) {
   if (argc < 2) {
-    std::__throw_runtime_error("Usage: ./main <input_file> <output_file>");
+    std::__throw_runtime_error(
+        "Usage: ./main <input_file> [--export <csv_file>] [--points <count>] "
+        "[--archive <directory> | --resume <directory>] [--memory-budget <MiB>]");
   }
 
   std::string outputFileName = "mars_sol_report.txt";
+  std::string exportFileName;
+  std::string archiveDirectory;
+  bool resume = false;
+  std::size_t memoryBudget = 0;
+  std::size_t exportPoints = DEFAULT_EXPORT_POINTS;
+  for (int arg = 2; arg + 1 < argc; arg += 2) {
+    const std::string flag = argv[arg];
+    if (flag == "--export") {
+      exportFileName = argv[arg + 1];
+    } else if (flag == "--points") {
+      exportPoints = std::stoul(argv[arg + 1]);
+    } else if (flag == "--archive" || flag == "--resume") {
+      archiveDirectory = argv[arg + 1];
+      resume = flag == "--resume";
+    } else if (flag == "--memory-budget") {
+      memoryBudget = std::stoul(argv[arg + 1]) << 20;
+    } else {
+      std::__throw_runtime_error("Unknown option");
+    }
+  }
 
   std::ifstream inputFile(argv[1]);
   if (!inputFile.is_open()) {
@@ -35,7 +66,31 @@ int main(int argc, char* argv[]) {
 
   auto robot = Robot::createRobot();
   auto solManager = make_unique_ptr<SOLManager>();
+  // Analytics and the archive run on their own threads so that ingest does
+  // not wait on them; MissionControl stores each SOL synchronously.
+  auto temperatureStatistics = std::make_shared<StreamingTemperatureStatistics>();
+  solManager->addObserver(temperatureStatistics, BackpressurePolicy::Block,
+                          DEFAULT_SOL_QUEUE_CAPACITY);
+  std::shared_ptr<SeriesExport> seriesExport;
+  if (!exportFileName.empty()) {
+    seriesExport = std::make_shared<SeriesExport>(exportPoints);
+    solManager->addObserver(seriesExport, BackpressurePolicy::Block,
+                            DEFAULT_SOL_QUEUE_CAPACITY);
+  }
+  std::shared_ptr<SOLArchiveWriter> archiveWriter;
+  if (!archiveDirectory.empty()) {
+    archiveWriter = std::make_shared<SOLArchiveWriter>(archiveDirectory);
+    solManager->addObserver(archiveWriter, BackpressurePolicy::Block,
+                            DEFAULT_SOL_QUEUE_CAPACITY);
+  }
   auto dataStorage = make_unique_ptr<DataStorage>();
+  if (memoryBudget > 0) {
+    // Spilling needs the compressed layout; spill to the scratch directory.
+    dataStorage = make_unique_ptr<DataStorage>(DuplicateSOLPolicy::Reject,
+                                               SOLStorageLayout::CompressedBlocks);
+    const char* spillDirectory = std::getenv("TMPDIR");
+    dataStorage->setMemoryBudget(memoryBudget, spillDirectory ? spillDirectory : "/tmp");
+  }
   auto recordParser = make_unique_ptr<RecordParser>();
 
   auto missionControl = std::make_shared<MissionControl>(
@@ -44,44 +99,65 @@ int main(int argc, char* argv[]) {
 
   missionControl->initialize();
 
+  std::uint64_t inputOffset = 0;
+  if (archiveWriter) {
+    const std::string checkpointFileName = archiveDirectory + "/CHECKPOINT";
+    missionControl->enableCheckpoints(
+        archiveWriter, make_unique_ptr<CheckpointWriter>(checkpointFileName));
+    IngestCheckpoint checkpoint;
+    if (resume && CheckpointWriter::read(checkpointFileName, checkpoint)) {
+      inputOffset = missionControl->resume(checkpoint);
+      // Analytics are not checkpointed; rebuild them from the archived SOLs.
+      // No SOL has been queued yet, so their threads are idle.
+      missionControl->forEachObservation([&](const SOLData& solData) {
+        temperatureStatistics->onSOLFinalized(solData);
+        if (seriesExport) {
+          seriesExport->onSOLFinalized(solData);
+        }
+      });
+      inputFile.seekg(static_cast<std::streamoff>(inputOffset));
+    } else {
+      archiveWriter->rollback(0);
+    }
+  }
+
   std::string record;
   while (std::getline(inputFile, record)) {
+    // getline consumed the newline; summing avoids a tellg() per record.
+    inputOffset += record.size() + 1;
     missionControl->handleRecord(record);
+    // Each 't' record closes a SOL, so every SOL's temperature aggregate
+    // holds exactly one reading; the report counts SOLs as 't' records.
     if (record[0] == 't') {
       missionControl->finalizeCurrentSOL();
+      missionControl->advanceInput(inputOffset);
     }
   }
-
-  // Generate final report
-  auto allSOLData = missionControl->getObservations();
-
-  // Process temperature data
-  std::vector<double> temperatures;
-  for (const auto& solData : allSOLData) {
-    temperatures.push_back(solData.getTemperatureData());
+  if (archiveWriter) {
+    missionControl->checkpoint(inputOffset);
+    missionControl->flushCheckpoints();
   }
+  missionControl->flushObservers();
 
-  double highestSummerTemperature =
-      Statistics::calculateLowestSummerTemperature(temperatures);
-  double lowestWinterTemperature =
-      Statistics::calculateLowestWinterTemperature(temperatures);
-
-  std::sort(temperatures.begin(), temperatures.end());
-
-  // Calculate statistics
-  double median = Statistics::calculateMedian(temperatures);
-  double mean = Statistics::calculateMean(temperatures);
+  // Generate final report
+  const TemperatureSnapshot temperatureSnapshot =
+      temperatureStatistics->getSnapshot();
+  const std::vector<double>& highest = temperatureSnapshot.highest;
+  const std::vector<double>& lowest = temperatureSnapshot.lowest;
+  const double median = temperatureSnapshot.median;
+  const double mean = temperatureSnapshot.mean;
+  const double highestSummerTemperature = temperatureSnapshot.lowestSummer;
+  const double lowestWinterTemperature = temperatureSnapshot.lowestWinter;
 
   // Output report to file
-  outputFile << "Final Report for 1374 Sols:\n\n";
+  outputFile << "Final Report for " << temperatureSnapshot.count
+             << " Sols:\n\n";
 
   outputFile << "Temperature Statistics:\n";
-  outputFile << "3 Highest Temperatures (K): "
-             << temperatures[temperatures.size() - 3] << ", "
-             << temperatures[temperatures.size() - 2] << ", "
-             << temperatures[temperatures.size() - 1] << "\n";
-  outputFile << "3 Lowest Temperatures (K): " << temperatures[0] << ", "
-             << temperatures[1] << ", " << temperatures[2] << "\n";
+  outputFile << "3 Highest Temperatures (K): " << highest[2] << ", "
+             << highest[1] << ", " << highest[0] << "\n";
+  outputFile << "3 Lowest Temperatures (K): " << lowest[0] << ", "
+             << lowest[1] << ", " << lowest[2] << "\n";
   outputFile << "Median Temperature: " << median << "K (" << (median - 273.15)
              << "C)\n";
   outputFile << "Mean Temperature: " << mean << "K (" << (mean - 273.15)
@@ -91,32 +167,52 @@ int main(int argc, char* argv[]) {
   outputFile << "Lowest Winter Temperature: " << lowestWinterTemperature
              << "K (" << (lowestWinterTemperature - 273.15) << "C)\n";
 
+  // The last nine SOLs with a recognized sample, newest first.
+  SOLQuery classified;
+  classified.where(SOLColumn::Element, SOLComparison::NotEqual, UNKNOWN_ELEMENT_ID);
+  const DataStorage& storage = missionControl->getDataStorage();
+  const std::vector<int> classifiedSOLs = classified.selectSOLs(storage);
+  const std::vector<double> classifiedElements =
+      classified.select(storage, SOLColumn::Element);
+
   outputFile << "\nSample Classifications:\n";
-  int count = 0;
-  for (auto it = allSOLData.rbegin(); it != allSOLData.rend() && count < 9;
-       ++it) {
-    if (it->getSampleData().getClassifiedElement() != "Unknown") {
-      outputFile << "SOL " << it->getSolNumber() << ": "
-                 << it->getSampleData().getClassifiedElement() << "\n";
-      count++;
-    }
+  for (std::size_t match = classifiedSOLs.size();
+       match > 0 && classifiedSOLs.size() - match < 9; --match) {
+    outputFile << "SOL " << classifiedSOLs[match - 1] << ": "
+               << SampleClassification::getElementName(
+                      static_cast<int>(classifiedElements[match - 1]))
+               << "\n";
   }
 
+  // The distance section reads every row, so walk those columns a block at
+  // a time; this also works when sealed blocks have spilled to disk.
   outputFile << "\nDistances Traveled:\n";
-  for (const auto& solData : allSOLData) {
-    const auto& navData = solData.getNavigationData();
-    outputFile << "SOL " << solData.getSolNumber() << ": "
-               << std::setprecision(2) << std::fixed
-               << static_cast<double>(navData.finalDistance.getValue())
-               << " meters, "
-               << "Direction: "
-               << UnitConverter::directionToString(navData.finalDirection)
-               << "\n";
-  }
+  storage.forEachBlock([&outputFile](const SOLColumnStore& rows) {
+    const ColumnSpan<int> solNumbers = rows.getSolNumbers();
+    const ColumnSpan<double> distances = rows.getDistances();
+    const ColumnSpan<std::uint8_t> directions = rows.getDirections();
+    for (std::size_t row = 0; row < rows.size(); ++row) {
+      outputFile << "SOL " << solNumbers[row] << ": "
+                 << std::setprecision(2) << std::fixed << distances[row]
+                 << " meters, "
+                 << "Direction: "
+                 << UnitConverter::directionToString(
+                        static_cast<Direction>(directions[row]))
+                 << "\n";
+    }
+  });
 
   outputFile.close();
   inputFile.close();
 
+  if (seriesExport) {
+    std::ofstream exportFile(exportFileName);
+    if (!exportFile.is_open()) {
+      std::__throw_runtime_error("Unable to open export file");
+    }
+    seriesExport->write(exportFile);
+  }
+
   char cwd[PATH_MAX];
   if (getcwd(cwd, sizeof(cwd)) != nullptr) {
     std::cout << "\nOutput saved to: " << cwd << "/" << outputFileName << "\n";